@@ -0,0 +1,98 @@
+#ifndef ALGORITHMS_BATCH_HPP
+#define ALGORITHMS_BATCH_HPP
+
+#include <core/core.hpp>
+#include <vector>
+
+namespace dip {
+namespace algorithms {
+
+/**
+ * 批量处理：对 count 个输入图像分别调用 op(const Image &src, Image &dst)
+ * 图像按张分配给调用线程和线程池（每次领取一张，负载自动均衡），
+ * 单张图像内部的 parallel_for 串行执行，避免嵌套并行的调度开销
+ * 结果按输入顺序写入 outputs；outputs 中已有的图像尺寸匹配时复用其缓冲区
+ * op 抛出的第一个异常在所有图像处理完后重新抛出
+ * @param images 输入图像数组
+ * @param count 图像数量
+ * @param outputs 输出图像，大小调整为 count
+ * @param op 单张图像的处理函数，通常调用算法的 dst 重载
+ */
+template <typename Op>
+void batch_apply(const Image *images, size_t count, std::vector<Image> &outputs,
+                 const Op &op) {
+  outputs.resize(count);
+  parallel_for(
+      0, static_cast<int>(count),
+      [&](int i0, int i1) {
+        for (int i = i0; i < i1; ++i) {
+          op(images[i], outputs[i]);
+        }
+      },
+      1);
+}
+
+template <typename Op>
+void batch_apply(const std::vector<Image> &images, std::vector<Image> &outputs,
+                 const Op &op) {
+  batch_apply(images.data(), images.size(), outputs, op);
+}
+
+template <typename Op>
+std::vector<Image> batch_apply(const std::vector<Image> &images,
+                               const Op &op) {
+  std::vector<Image> outputs;
+  batch_apply(images.data(), images.size(), outputs, op);
+  return outputs;
+}
+
+// 常用算法的批量版本，结果按输入顺序返回
+// outputs 重载复用上一批的输出缓冲区，适合逐批处理大量同尺寸图像
+std::vector<Image> quantize_batch(const std::vector<Image> &images,
+                                  int levels);
+void quantize_batch(const std::vector<Image> &images, int levels,
+                    std::vector<Image> &outputs);
+
+std::vector<Image> downsample_batch(const std::vector<Image> &images,
+                                    int factor);
+void downsample_batch(const std::vector<Image> &images, int factor,
+                      std::vector<Image> &outputs);
+
+std::vector<Image> bilinear_zoom_batch(const std::vector<Image> &images,
+                                       float scale);
+void bilinear_zoom_batch(const std::vector<Image> &images, float scale,
+                         std::vector<Image> &outputs);
+
+std::vector<Image> nearest_neighbor_zoom_batch(const std::vector<Image> &images,
+                                               float scale);
+void nearest_neighbor_zoom_batch(const std::vector<Image> &images, float scale,
+                                 std::vector<Image> &outputs);
+
+std::vector<Image> rotate_batch(const std::vector<Image> &images,
+                                double theta);
+void rotate_batch(const std::vector<Image> &images, double theta,
+                  std::vector<Image> &outputs);
+
+} // namespace algorithms
+
+// 以下算法位于 dip 命名空间，批量版本与其保持一致
+
+std::vector<Image> invert_image_batch(const std::vector<Image> &images,
+                                      int max_gray = 255);
+void invert_image_batch(const std::vector<Image> &images, int max_gray,
+                        std::vector<Image> &outputs);
+
+std::vector<Image> set_complement_batch(const std::vector<Image> &images,
+                                        int K = 255);
+void set_complement_batch(const std::vector<Image> &images, int K,
+                          std::vector<Image> &outputs);
+
+// 逐对运算：images1[i] 与 images2[i]，两组图像数量必须相同
+std::vector<Image> logical_and_batch(const std::vector<Image> &images1,
+                                     const std::vector<Image> &images2);
+std::vector<Image> logical_xor_batch(const std::vector<Image> &images1,
+                                     const std::vector<Image> &images2);
+
+} // namespace dip
+
+#endif // ALGORITHMS_BATCH_HPP
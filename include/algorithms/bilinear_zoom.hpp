@@ -12,6 +12,10 @@ namespace algorithms {
 // @return 放大后的图像
 Image bilinear_zoom(const Image &img, float scale);
 
+// 同上，结果写入 dst；dst 的尺寸和类型匹配时复用其缓冲区，不重新分配
+// dst 不能是 img 本身
+void bilinear_zoom(const Image &img, float scale, Image &dst);
+
 } // namespace algorithms
 } // namespace dip
 
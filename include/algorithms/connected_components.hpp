@@ -0,0 +1,53 @@
+#ifndef ALGORITHMS_CONNECTED_COMPONENTS_HPP
+#define ALGORITHMS_CONNECTED_COMPONENTS_HPP
+
+#include "algorithms/connectivity.hpp"
+#include "core/image.hpp"
+
+namespace dip {
+
+// 连通分量标记结果
+struct LabelResult {
+  Image labels;       // INT32单通道标记图像，背景为0，分量编号从1开始
+  int num_components; // 连通分量数量
+};
+
+/**
+ * 连通分量标记（两遍扫描 + 并查集等价表）
+ * 分量按其首个像素在光栅扫描顺序中出现的先后编号
+ * 注意：m-连通与8-连通得到的分量相同，m-连通只是在对角像素已经
+ * 通过共同的4-邻域像素连通时不再合并对角等价关系
+ * @param img 输入图像（UINT8，只使用第0通道）
+ * @param type 邻域类型
+ * @param V 前景像素的灰度值
+ * @return 标记图像与连通分量数量
+ */
+LabelResult label_components(const Image &img, NeighborhoodType type,
+                             uint8_t V);
+
+// 同上，结果写入 result；result.labels 的尺寸和类型匹配时复用其缓冲区
+void label_components(const Image &img, NeighborhoodType type, uint8_t V,
+                      LabelResult &result);
+
+/**
+ * 并行连通分量标记
+ * 图像按水平条带划分，各条带在线程池上独立标记，随后用无锁并查集
+ * 合并条带边界上的等价关系，再并行重新编号
+ * 结果与 label_components 完全一致
+ * @param img 输入图像（UINT8，只使用第0通道）
+ * @param type 邻域类型
+ * @param V 前景像素的灰度值
+ * @param num_threads 条带数（0表示使用 get_num_threads()）
+ * @return 标记图像与连通分量数量
+ */
+LabelResult label_components_parallel(const Image &img, NeighborhoodType type,
+                                      uint8_t V, int num_threads = 0);
+
+// 同上，结果写入 result；result.labels 的尺寸和类型匹配时复用其缓冲区
+void label_components_parallel(const Image &img, NeighborhoodType type,
+                               uint8_t V, LabelResult &result,
+                               int num_threads = 0);
+
+} // namespace dip
+
+#endif // ALGORITHMS_CONNECTED_COMPONENTS_HPP
@@ -3,6 +3,7 @@
 
 #include "core/basic_types.hpp"
 #include "core/image.hpp"
+#include <type_traits>
 #include <vector>
 
 namespace dip {
@@ -14,6 +15,92 @@ enum class NeighborhoodType {
   M_CONNECTED = 'm' // m-连通邻域
 };
 
+// 邻域偏移量
+struct NeighborOffset {
+  int dx, dy;
+};
+
+// 预计算的邻域偏移表：前4项为4-邻域，后4项为对角邻域
+// N4 只使用前4项；N8 和 m-连通使用全部8项（m-连通对角项需额外判断）
+inline constexpr NeighborOffset NEIGHBOR_OFFSETS[8] = {
+    {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+inline constexpr int neighbor_offset_count(NeighborhoodType type) {
+  return type == NeighborhoodType::N4 ? 4 : 8;
+}
+
+// 固定容量的邻域缓冲区（内联存储，不分配堆内存）
+struct NeighborBuffer {
+  Point2i points[8];
+  int count = 0;
+
+  int size() const { return count; }
+  bool empty() const { return count == 0; }
+  const Point2i &operator[](int i) const { return points[i]; }
+  const Point2i *begin() const { return points; }
+  const Point2i *end() const { return points + count; }
+};
+
+/**
+ * 遍历像素的指定邻域（零堆分配）
+ * @param img 输入图像
+ * @param x 像素x坐标
+ * @param y 像素y坐标
+ * @param type 邻域类型
+ * @param visit 回调函数，参数为邻域像素坐标；若返回bool，返回false时提前终止
+ */
+template <typename Visitor>
+inline void for_each_neighbor(const Image &img, int x, int y,
+                              NeighborhoodType type, Visitor &&visit) {
+  const int width = img.width();
+  const int height = img.height();
+  const int count = neighbor_offset_count(type);
+  const bool m_adjacency = type == NeighborhoodType::M_CONNECTED;
+  const uint8_t center = m_adjacency ? img.get_pixel(x, y, 0) : 0;
+
+  for (int i = 0; i < count; ++i) {
+    const int dx = NEIGHBOR_OFFSETS[i].dx;
+    const int dy = NEIGHBOR_OFFSETS[i].dy;
+    const int nx = x + dx;
+    const int ny = y + dy;
+    if (nx < 0 || nx >= width || ny < 0 || ny >= height) {
+      continue;
+    }
+
+    // m-连通：对角像素q仅当p与q共有的两个4-邻域像素都不等于p的值时才加入
+    if (m_adjacency && i >= 4) {
+      // q已在图像内，中间像素是否越界只取决于p的坐标
+      const bool h_in = y >= 0 && y < height;
+      const bool v_in = x >= 0 && x < width;
+      if ((h_in && img.get_pixel(nx, y, 0) == center) ||
+          (v_in && img.get_pixel(x, ny, 0) == center)) {
+        continue;
+      }
+    }
+
+    if constexpr (std::is_same_v<std::invoke_result_t<Visitor, Point2i>,
+                                 bool>) {
+      if (!visit(Point2i(nx, ny))) {
+        return;
+      }
+    } else {
+      visit(Point2i(nx, ny));
+    }
+  }
+}
+
+/**
+ * 获取像素的指定邻域（写入固定容量缓冲区，零堆分配）
+ * @param img 输入图像
+ * @param x 像素x坐标
+ * @param y 像素y坐标
+ * @param type 邻域类型 (4, 8, 或 'm')
+ * @param out 输出缓冲区
+ * @return 邻域像素数量
+ */
+int get_neighbors(const Image &img, int x, int y, NeighborhoodType type,
+                  NeighborBuffer &out);
+
 /**
  * 获取像素的指定邻域
  * @param img 输入图像
@@ -12,6 +12,10 @@ namespace algorithms {
 // @return 下采样后的图像
 Image downsample(const Image &img, int factor);
 
+// 同上，结果写入 dst；dst 的尺寸和类型匹配时复用其缓冲区，不重新分配
+// dst 不能是 img 本身（factor<=1 时除外，此时不做任何操作）
+void downsample(const Image &img, int factor, Image &dst);
+
 } // namespace algorithms
 } // namespace dip
 
@@ -12,6 +12,10 @@ namespace algorithms {
 // @return 量化后的图像
 Image quantize(const Image &img, int levels);
 
+// 同上，结果写入 dst；dst 的尺寸和类型匹配时复用其缓冲区，不重新分配
+// dst 可以是 img 本身（原地量化）
+void quantize(const Image &img, int levels, Image &dst);
+
 } // namespace algorithms
 } // namespace dip
 
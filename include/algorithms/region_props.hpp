@@ -0,0 +1,60 @@
+#ifndef ALGORITHMS_REGION_PROPS_HPP
+#define ALGORITHMS_REGION_PROPS_HPP
+
+#include "algorithms/connected_components.hpp"
+#include "core/image.hpp"
+#include <vector>
+
+namespace dip {
+
+// 连通区域统计表（结构体数组SoA布局）
+// 各数组下标为 标号-1，访问函数的参数为标号（1..count）
+struct RegionProps {
+  int count = 0;
+  std::vector<int64_t> area;                // 像素数
+  std::vector<int32_t> min_x, min_y;        // 外接矩形左上角
+  std::vector<int32_t> max_x, max_y;        // 外接矩形右下角（含）
+  std::vector<int64_t> sum_x, sum_y;        // 坐标和，用于计算质心
+  std::vector<double> sum_intensity;        // 强度和
+  std::vector<double> min_intensity;        // 最小强度
+  std::vector<double> max_intensity;        // 最大强度
+
+  Rect bbox(int label) const {
+    int i = label - 1;
+    return Rect(min_x[i], min_y[i], max_x[i] - min_x[i] + 1,
+                max_y[i] - min_y[i] + 1);
+  }
+
+  Point2d centroid(int label) const {
+    int i = label - 1;
+    return Point2d(static_cast<double>(sum_x[i]) / area[i],
+                   static_cast<double>(sum_y[i]) / area[i]);
+  }
+
+  double mean_intensity(int label) const {
+    int i = label - 1;
+    return sum_intensity[i] / area[i];
+  }
+};
+
+/**
+ * 单遍流式计算各连通区域的面积、外接矩形、质心和强度统计
+ * 计算量与像素数成正比，与区域数量无关
+ * @param labels INT32标记图像（背景为0，区域编号1..num_components）
+ * @param num_components 区域数量
+ * @param intensity 强度图像（只使用第0通道）；为空时不计算强度统计
+ * @return 区域统计表
+ * @throws std::invalid_argument 标号为负或大于 num_components
+ */
+RegionProps region_props(const Image &labels, int num_components,
+                         const Image &intensity = Image());
+
+// 使用 label_components 的结果计算区域统计
+inline RegionProps region_props(const LabelResult &result,
+                                const Image &intensity = Image()) {
+  return region_props(result.labels, result.num_components, intensity);
+}
+
+} // namespace dip
+
+#endif // ALGORITHMS_REGION_PROPS_HPP
@@ -12,6 +12,10 @@ namespace algorithms {
 // @return 旋转后的图像
 Image rotate(const Image &img, double theta);
 
+// 同上，结果写入 dst；dst 的尺寸和类型匹配时复用其缓冲区，不重新分配
+// dst 不能是 img 本身
+void rotate(const Image &img, double theta, Image &dst);
+
 } // namespace algorithms
 } // namespace dip
 
@@ -0,0 +1,34 @@
+#ifndef ALGORITHMS_SCALED_LOAD_HPP
+#define ALGORITHMS_SCALED_LOAD_HPP
+
+#include <core/core.hpp>
+#include <memory>
+#include <string>
+
+namespace dip {
+namespace algorithms {
+
+// 使长边不超过 max_size 的最小 downsample 因子（不需要缩小时为1）
+int scale_factor_for(int width, int height, int max_size);
+
+/**
+ * 加载并缩小图像，使长边不超过 max_size（用于生成缩略图）
+ * 先用文件头规划缩小因子，结果与 downsample(load_from_file(path), factor)
+ * 逐字节一致
+ * - 8位二进制PNM：在映射的文件上按行条带（约4MB）逐条缩小，处理完的
+ *   条带随即释放，常驻内存为一个条带加输出图像，不载入整幅图像
+ * - 其它格式：stb 不支持按行解码，整幅解码后缩小，并立即释放解码结果
+ * 返回的图像总是使用自有缓冲区，不引用映射的文件
+ * @param path 文件路径
+ * @param max_size 长边的最大像素数（>=1）
+ * @param desired_channels 期望通道数（0 为文件原有通道数）
+ * @return 加载失败时返回 nullptr
+ * @throws std::invalid_argument max_size < 1
+ */
+std::shared_ptr<Image> load_scaled(const std::string &path, int max_size,
+                                   int desired_channels = 0);
+
+} // namespace algorithms
+} // namespace dip
+
+#endif // ALGORITHMS_SCALED_LOAD_HPP
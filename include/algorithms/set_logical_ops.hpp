@@ -5,14 +5,20 @@
 
 namespace dip {
 
+// 以下各运算的 dst 重载将结果写入 dst：dst 的尺寸和类型匹配时复用其
+// 缓冲区，不重新分配；dst 可以是某个输入图像本身（原地运算）
+
 // 集合运算：灰度图补集（K=255）
 Image set_complement(const Image &img, int K = 255);
+void set_complement(const Image &img, int K, Image &dst);
 
 // 逻辑运算：二值图AND
 Image logical_and(const Image &img1, const Image &img2);
+void logical_and(const Image &img1, const Image &img2, Image &dst);
 
 // 逻辑运算：二值图XOR
 Image logical_xor(const Image &img1, const Image &img2);
+void logical_xor(const Image &img1, const Image &img2, Image &dst);
 
 } // namespace dip
 
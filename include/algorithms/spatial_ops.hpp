@@ -8,6 +8,9 @@ namespace dip {
 // 图像求反算法（空间域操作）
 Image invert_image(const Image &img, int max_gray = 255);
 
+// 结果写入 dst，dst 的尺寸和类型匹配时复用其缓冲区；dst 可以是 img 本身
+void invert_image(const Image &img, int max_gray, Image &dst);
+
 } // namespace dip
 
 #endif // ALGORITHMS_SPATIAL_OPS_HPP
@@ -0,0 +1,81 @@
+#ifndef ALGORITHMS_STREAMING_HPP
+#define ALGORITHMS_STREAMING_HPP
+
+#include <core/core.hpp>
+#include <core/strip_io.hpp>
+#include <string>
+
+namespace dip {
+namespace algorithms {
+
+// 流式处理：从PNM文件按行带读取，处理后按行带写入PNM文件，
+// 结果与整幅加载后调用对应算法逐字节一致
+// 内存占用约为两个行带（输入和输出），与图像高度无关
+// 输入不是8位二进制PNM或无法读写时抛出 std::runtime_error
+
+// 默认每个行带的输入行数
+constexpr int kDefaultBandRows = 256;
+
+/**
+ * 对每个行带调用逐像素运算 op(const Image &src, Image &dst)，
+ * dst 必须与 src 同尺寸（op 不能依赖邻域行）
+ */
+template <typename Op>
+void stream_point_op(const std::string &input, const std::string &output,
+                     const Op &op, int band_rows = kDefaultBandRows);
+
+void stream_quantize(const std::string &input, const std::string &output,
+                     int levels, int band_rows = kDefaultBandRows);
+
+void stream_invert_image(const std::string &input, const std::string &output,
+                         int max_gray = 255,
+                         int band_rows = kDefaultBandRows);
+
+void stream_set_complement(const std::string &input,
+                           const std::string &output, int K = 255,
+                           int band_rows = kDefaultBandRows);
+
+// 行带按 factor 对齐，每个行带整体调用 downsample
+void stream_downsample(const std::string &input, const std::string &output,
+                       int factor, int band_rows = kDefaultBandRows);
+
+// 按输出行带读取所需的输入行（双线性附带下一行）
+void stream_bilinear_zoom(const std::string &input, const std::string &output,
+                          float scale, int band_rows = kDefaultBandRows);
+
+void stream_nearest_neighbor_zoom(const std::string &input,
+                                  const std::string &output, float scale,
+                                  int band_rows = kDefaultBandRows);
+
+namespace detail {
+
+// 打开输入（必须为8位二进制PNM），失败时抛出 std::runtime_error
+void open_input(const std::string &path, int band_rows, int halo,
+                StripReader &reader);
+void open_output(const std::string &path, int width, int height,
+                 int channels, StripWriter &writer);
+void close_output(StripWriter &writer, const std::string &path);
+
+} // namespace detail
+
+template <typename Op>
+void stream_point_op(const std::string &input, const std::string &output,
+                     const Op &op, int band_rows) {
+  StripReader reader;
+  StripWriter writer;
+  detail::open_input(input, band_rows, 0, reader);
+  detail::open_output(output, reader.width(), reader.height(),
+                      reader.channels(), writer);
+  Band band;
+  Image result;
+  while (reader.next(band)) {
+    op(band.image, result);
+    writer.write(result);
+  }
+  detail::close_output(writer, output);
+}
+
+} // namespace algorithms
+} // namespace dip
+
+#endif // ALGORITHMS_STREAMING_HPP
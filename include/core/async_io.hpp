@@ -0,0 +1,231 @@
+#ifndef CORE_ASYNC_IO_HPP
+#define CORE_ASYNC_IO_HPP
+
+// 异步图像读写：按顺序预取的 ImagePrefetcher 和内存有界的 AsyncImageWriter
+// 解码在 ThreadPool::io() 上、编码在写线程上执行，与调用线程上的处理重叠
+
+#include "image.hpp"
+#include "image_loader.hpp"
+#include "thread_pool.hpp"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dip {
+
+/**
+ * 按顺序遍历文件列表，并在后台预先解码之后的 depth 个文件
+ * 同一时刻最多有 depth 个已解码或正在解码的图像，内存占用有界
+ *
+ * 用法：
+ *   ImagePrefetcher prefetcher(paths, 4);
+ *   std::shared_ptr<Image> img;
+ *   while (prefetcher.next(img)) { ... }
+ */
+class ImagePrefetcher {
+private:
+  std::vector<std::string> paths_;
+  std::deque<std::future<std::shared_ptr<Image>>> pending_;
+  size_t depth_;
+  size_t submitted_ = 0; // 已提交解码的文件数
+  size_t position_ = 0;  // 已由 next() 返回的文件数
+  int desired_channels_;
+
+  void submit_more() {
+    while (submitted_ < paths_.size() && pending_.size() < depth_) {
+      const std::string path = paths_[submitted_++];
+      const int channels = desired_channels_;
+      pending_.push_back(ThreadPool::io().submit(
+          [path, channels] {
+            return ImageLoader::load_from_file(path, channels);
+          }));
+    }
+  }
+
+public:
+  explicit ImagePrefetcher(std::vector<std::string> paths, size_t depth = 4,
+                           int desired_channels = 0)
+      : paths_(std::move(paths)), depth_(std::max<size_t>(1, depth)),
+        desired_channels_(desired_channels) {
+    submit_more();
+  }
+
+  // 等待仍在后台解码的文件，避免任务比对象存活更久
+  ~ImagePrefetcher() {
+    for (auto &f : pending_) {
+      if (f.valid())
+        f.wait();
+    }
+  }
+
+  ImagePrefetcher(const ImagePrefetcher &) = delete;
+  ImagePrefetcher &operator=(const ImagePrefetcher &) = delete;
+
+  /**
+   * 取出下一个图像（按 paths 的顺序）
+   * @param image 输出，加载失败时为 nullptr
+   * @param path 可选，输出对应的文件路径
+   * @return 已遍历完时返回 false
+   */
+  bool next(std::shared_ptr<Image> &image, std::string *path = nullptr) {
+    if (pending_.empty())
+      return false;
+    image = pending_.front().get();
+    pending_.pop_front();
+    if (path)
+      *path = paths_[position_];
+    ++position_;
+    submit_more();
+    return true;
+  }
+
+  size_t size() const { return paths_.size(); }
+  size_t position() const { return position_; }
+};
+
+/**
+ * 异步保存图像，write() 将图像放入队列后立即返回，由写线程依次保存
+ * 队列中尚未写完的图像总字节数不超过 max_pending_bytes，超过时 write()
+ * 阻塞直到有图像写完（单个图像超过上限时等队列清空后再放入）
+ * 写线程为本对象独有，因此在I/O线程池的任务（如 load_batch 回调）中
+ * 调用 write() 也不会因线程池被占满而死锁
+ * 写入失败不会抛出异常，通过 failed_count() 查询
+ */
+class AsyncImageWriter {
+public:
+  using Saver = std::function<bool(const Image &, const std::string &)>;
+
+private:
+  struct Job {
+    Image image;
+    std::string path;
+    size_t bytes;
+  };
+
+  Saver saver_;
+  size_t max_pending_bytes_;
+  std::vector<std::thread> workers_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Job> queue_;
+  size_t pending_bytes_ = 0; // 队列中和正在写入的图像字节数
+  size_t in_progress_ = 0;   // 正在写入的图像数
+  size_t peak_pending_bytes_ = 0;
+  size_t written_ = 0;
+  size_t failed_ = 0;
+  bool stop_ = false;
+
+  static size_t bytes_of(const Image &image) {
+    return image.matrix().total() * image.matrix().elemSize();
+  }
+
+  void worker_loop() {
+    for (;;) {
+      Job job;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (queue_.empty())
+          return;
+        job = std::move(queue_.front());
+        queue_.pop_front();
+        ++in_progress_;
+      }
+
+      bool ok = false;
+      try {
+        ok = saver_(job.image, job.path);
+      } catch (...) {
+        ok = false;
+      }
+      job.image.release();
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_bytes_ -= job.bytes;
+      --in_progress_;
+      ++(ok ? written_ : failed_);
+      cv_.notify_all();
+    }
+  }
+
+public:
+  /**
+   * @param max_pending_bytes 队列中允许的最大字节数
+   * @param threads 写线程数
+   * @param saver 保存函数，默认按扩展名调用 image_saver::save_binary
+   */
+  explicit AsyncImageWriter(size_t max_pending_bytes = size_t(256) << 20,
+                            int threads = 2, Saver saver = nullptr)
+      : saver_(saver ? std::move(saver)
+                     : [](const Image &image, const std::string &path) {
+                         return image_saver::save_binary(image, path);
+                       }),
+        max_pending_bytes_(max_pending_bytes) {
+    for (int i = 0; i < std::max(1, threads); ++i)
+      workers_.emplace_back([this] { worker_loop(); });
+  }
+
+  // 写完队列中的全部图像后退出
+  ~AsyncImageWriter() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_)
+      worker.join();
+  }
+
+  AsyncImageWriter(const AsyncImageWriter &) = delete;
+  AsyncImageWriter &operator=(const AsyncImageWriter &) = delete;
+
+  // 放入写队列；传入右值可避免拷贝图像数据
+  void write(Image image, const std::string &path) {
+    const size_t bytes = bytes_of(image);
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] {
+        return pending_bytes_ == 0 ||
+               pending_bytes_ + bytes <= max_pending_bytes_;
+      });
+      queue_.push_back({std::move(image), path, bytes});
+      pending_bytes_ += bytes;
+      peak_pending_bytes_ = std::max(peak_pending_bytes_, pending_bytes_);
+    }
+    cv_.notify_all();
+  }
+
+  // 等待已放入队列的图像全部写完
+  void flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return queue_.empty() && in_progress_ == 0; });
+  }
+
+  size_t pending_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_bytes_;
+  }
+  size_t peak_pending_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return peak_pending_bytes_;
+  }
+  size_t written_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_;
+  }
+  size_t failed_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+  }
+};
+
+} // namespace dip
+
+#endif // CORE_ASYNC_IO_HPP
@@ -0,0 +1,52 @@
+#ifndef CORE_ATOMIC_FILE_HPP
+#define CORE_ATOMIC_FILE_HPP
+
+#include <string>
+
+namespace dip {
+
+/**
+ * 原子地替换文件：先写入同目录下的临时文件，commit() 时 rename() 覆盖目标
+ * - 写入失败或未 commit 时目标文件保持不变，临时文件在析构时删除
+ * - 正在映射或读取旧文件的对象（PnmReader、map_dipm 等）继续看到旧内容，
+ *   因此可以把载入的图像保存回同一路径
+ * 目标是符号链接时替换其指向的文件；目标已存在且不是普通文件（设备、
+ * 管道等）时直接写入目标
+ *
+ * 用法：
+ *   AtomicFile out(path);
+ *   std::ofstream file(out.path(), std::ios::binary);
+ *   ...
+ *   file.close();
+ *   return file && out.commit();
+ */
+class AtomicFile {
+public:
+  AtomicFile() = default;
+  explicit AtomicFile(const std::string &target) { reset(target); }
+  ~AtomicFile() { discard(); }
+
+  AtomicFile(const AtomicFile &) = delete;
+  AtomicFile &operator=(const AtomicFile &) = delete;
+
+  // 丢弃未提交的临时文件，改为写入 target
+  void reset(const std::string &target);
+
+  // 实际写入的路径（临时文件，或直接写入时的目标）
+  const std::string &path() const { return path_; }
+  const std::string &target() const { return target_; }
+
+  // 用写好的文件替换目标；失败时删除临时文件并返回 false
+  bool commit(std::string *error = nullptr);
+
+  // 删除未提交的临时文件
+  void discard();
+
+private:
+  std::string target_;
+  std::string path_;
+};
+
+} // namespace dip
+
+#endif // CORE_ATOMIC_FILE_HPP
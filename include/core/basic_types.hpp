@@ -15,6 +15,9 @@ enum class DataType {
   INT8,    // 8-bit signed char
   UINT16,  // 16-bit unsigned short
   INT16,   // 16-bit signed short
+  UINT32,  // 32-bit unsigned int
+  INT32,   // 32-bit signed int
+  FLOAT16, // 16-bit half float
   FLOAT32, // 32-bit float
   FLOAT64  // 64-bit double
 };
@@ -27,7 +30,10 @@ inline int dataTypeSize(DataType type) {
     return 1;
   case DataType::UINT16:
   case DataType::INT16:
+  case DataType::FLOAT16:
     return 2;
+  case DataType::UINT32:
+  case DataType::INT32:
   case DataType::FLOAT32:
     return 4;
   case DataType::FLOAT64:
@@ -48,6 +54,12 @@ inline std::string dataTypeName(DataType type) {
     return "UINT16";
   case DataType::INT16:
     return "INT16";
+  case DataType::UINT32:
+    return "UINT32";
+  case DataType::INT32:
+    return "INT32";
+  case DataType::FLOAT16:
+    return "FLOAT16";
   case DataType::FLOAT32:
     return "FLOAT32";
   case DataType::FLOAT64:
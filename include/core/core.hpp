@@ -4,10 +4,27 @@
 // 核心数据结构和功能模块
 // 这是一个header-only库，包含了所有必需的图像处理基础组件
 
+#include "async_io.hpp"
+#include "atomic_file.hpp"
 #include "basic_types.hpp"
+#include "cpu_features.hpp"
+#include "dipm.hpp"
+#include "dipz.hpp"
+#include "float16.hpp"
 #include "image.hpp"
+#include "image_cache.hpp"
 #include "image_loader.hpp"
 #include "matrix.hpp"
+#include "memory_stats.hpp"
+#include "parallel.hpp"
+#include "perf_counters.hpp"
+#include "pnm_reader.hpp"
+#include "simd.hpp"
+#include "strip_io.hpp"
+#include "task_scheduler.hpp"
+#include "thread_pool.hpp"
+#include "tiled_image.hpp"
+#include "trace.hpp"
 #include "vector_types.hpp"
 
 // 导出所有核心类型到dip命名空间
@@ -0,0 +1,33 @@
+#ifndef CORE_CPU_FEATURES_HPP
+#define CORE_CPU_FEATURES_HPP
+
+namespace dip {
+
+// SIMD指令集级别（数值越大指令集越新）
+enum class CpuLevel {
+  SCALAR, // 不使用显式SIMD
+  SSE2,   // 128位
+  AVX2,   // 256位（含F16C）
+  AVX512  // 512位（AVX-512F + AVX-512BW）
+};
+
+// 级别名称（scalar / sse2 / avx2 / avx512）
+const char *cpu_level_name(CpuLevel level);
+
+// 通过cpuid检测当前CPU（及操作系统）支持的最高级别
+CpuLevel detect_cpu_level();
+
+/**
+ * 当前使用的SIMD级别
+ * 首次调用时确定：默认为 detect_cpu_level()，可通过环境变量
+ * DIP_CPU_LEVEL=scalar|sse2|avx2|avx512 强制降级（用于测试），
+ * 选定的级别会输出一条日志
+ */
+CpuLevel cpu_level();
+
+// 运行时切换级别（超过CPU支持的级别时取支持的最高级别），返回实际级别
+CpuLevel set_cpu_level(CpuLevel level);
+
+} // namespace dip
+
+#endif // CORE_CPU_FEATURES_HPP
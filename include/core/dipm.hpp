@@ -0,0 +1,67 @@
+#ifndef CORE_DIPM_HPP
+#define CORE_DIPM_HPP
+
+// .dipm：原生二进制 Matrix/Image 容器，用于在流水线之间缓存中间结果
+// 64 字节文件头之后是原始像素数据，保留 DataType 和通道数，无需解析
+
+#include "image.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace dip {
+
+// .dipm 文件头
+struct DipmHeader {
+  int rows = 0;       // 矩阵行数（图像高度）
+  int cols = 0;       // 矩阵列数（图像宽度 * 通道数）
+  int channels = 1;
+  DataType type = DataType::UINT8;
+  uint64_t step = 0;        // 每行字节数（>= cols * 元素大小）
+  uint32_t alignment = 0;   // 像素数据在文件中的对齐字节数
+  uint64_t data_offset = 0; // 像素数据的起始位置
+
+  // 像素数据的字节数（读取文件头时已检查不会溢出）
+  uint64_t payload_bytes() const { return step * rows; }
+};
+
+/**
+ * 将矩阵写为 .dipm 文件
+ * 文件头和像素数据由一次 writev 写出（ROI 矩阵按行紧密排列写出）；
+ * 数据为本机字节序。先写入临时文件再替换目标（见 AtomicFile），
+ * 可以保存回映射来源的同一路径
+ * @return 失败时返回 false，error 不为空时写入原因
+ */
+bool write_dipm(const Matrix &mat, int channels, const std::string &path,
+                std::string *error = nullptr);
+
+inline bool write_dipm(const Image &image, const std::string &path,
+                       std::string *error = nullptr) {
+  return write_dipm(image.matrix(), image.channels(), path, error);
+}
+
+// 只读取文件头
+bool read_dipm_header(const std::string &path, DipmHeader &header,
+                      std::string *error = nullptr);
+
+/**
+ * 内存映射 .dipm 文件，返回直接引用映射内存的只读图像（零拷贝，任意
+ * DataType）；拷贝得到自有存储的可修改图像。不支持 mmap 的平台上整体读入
+ * 映射不是快照：图像存活期间原地改写或截断该文件会改变像素，或在访问时
+ * 触发 SIGBUS（write_dipm 替换文件而不是原地改写，不受影响）
+ * @return 失败时返回 nullptr，error 不为空时写入原因
+ */
+std::shared_ptr<const Image> map_dipm(const std::string &path,
+                                      std::string *error = nullptr);
+
+/**
+ * 将 .dipm 文件读入 dst 自有的缓冲区，不保留对文件的引用；
+ * dst 尺寸和类型匹配时复用其缓冲区
+ * @return 失败时返回 false，error 不为空时写入原因
+ */
+bool read_dipm(const std::string &path, Image &dst,
+               std::string *error = nullptr);
+
+} // namespace dip
+
+#endif // CORE_DIPM_HPP
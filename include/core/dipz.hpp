@@ -0,0 +1,39 @@
+#ifndef CORE_DIPZ_HPP
+#define CORE_DIPZ_HPP
+
+// .dipz：面向速度的无损压缩格式，用于磁盘上的中间结果缓存
+// 每行选择 left/up/Paeth 预测，残差经 zigzag 映射后用自适应 Rice 编码
+// （每64个样本选择一次参数，全零段只占6位）；图像按行分块，块之间相互
+// 独立，由 parallel_for 并行编码和解码，编码后不小于原始数据的块直接存储
+
+#include "image.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dip {
+
+// .dipz 编码参数
+struct DipzOptions {
+  int block_rows = 0; // 每块的行数，0 按约256KB原始数据自动选择
+};
+
+/**
+ * 将图像编码为 .dipz 文件内容，结果写入 out（替换原有内容）
+ * 支持所有 DataType（按样本位宽处理，浮点数按位模式预测）和任意通道数，
+ * 数据为本机字节序；输出与线程数无关
+ * @throws std::invalid_argument 图像为空
+ */
+void encode_dipz(const Image &image, std::vector<uint8_t> &out,
+                 const DipzOptions &options = DipzOptions());
+
+/**
+ * 解码 .dipz 文件内容到 dst（尺寸和类型匹配时复用其缓冲区）
+ * @return 数据损坏或格式不支持时返回 false，error 不为空时写入原因
+ */
+bool decode_dipz(const uint8_t *data, size_t size, Image &dst,
+                 std::string *error = nullptr);
+
+} // namespace dip
+
+#endif // CORE_DIPZ_HPP
@@ -0,0 +1,138 @@
+#ifndef CORE_FLOAT16_HPP
+#define CORE_FLOAT16_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace dip {
+
+// 半精度浮点数转换（IEEE 754 binary16，舍入到最近偶数）
+// 编译器启用F16C时（如 -mf16c 或 -march=native）使用硬件指令
+inline float halfToFloat(uint16_t h) {
+#if defined(__F16C__)
+  return _cvtsh_ss(h);
+#else
+  uint32_t sign = static_cast<uint32_t>(h & 0x8000u) << 16;
+  uint32_t exp = (h >> 10) & 0x1fu;
+  uint32_t mant = h & 0x3ffu;
+  uint32_t bits;
+
+  if (exp == 0) {
+    if (mant == 0) {
+      bits = sign; // ±0
+    } else {
+      // 非规格化数：规格化后转为float的规格化数
+      exp = 127 - 15 + 1;
+      while ((mant & 0x400u) == 0) {
+        mant <<= 1;
+        --exp;
+      }
+      bits = sign | (exp << 23) | ((mant & 0x3ffu) << 13);
+    }
+  } else if (exp == 0x1f) {
+    bits = sign | 0x7f800000u | (mant << 13); // Inf / NaN
+  } else {
+    bits = sign | ((exp + 127 - 15) << 23) | (mant << 13);
+  }
+
+  float f;
+  std::memcpy(&f, &bits, sizeof(f));
+  return f;
+#endif
+}
+
+inline uint16_t floatToHalf(float f) {
+#if defined(__F16C__)
+  return _cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT);
+#else
+  uint32_t x;
+  std::memcpy(&x, &f, sizeof(x));
+  const uint16_t sign = static_cast<uint16_t>((x >> 16) & 0x8000u);
+  const uint32_t absx = x & 0x7fffffffu;
+
+  if (absx >= 0x7f800000u) {
+    // Inf / NaN（保留NaN的高位尾数并保证仍为NaN）
+    uint16_t nan_bits =
+        absx > 0x7f800000u ? static_cast<uint16_t>(0x200u | (absx >> 13)) : 0;
+    return static_cast<uint16_t>(sign | 0x7c00u | (nan_bits & 0x3ffu));
+  }
+  if (absx >= 0x477ff000u) {
+    return static_cast<uint16_t>(sign | 0x7c00u); // 上溢（>= 65520）为Inf
+  }
+  if (absx < 0x38800000u) {
+    // 结果为非规格化数或0（< 2^-14）
+    if (absx < 0x33000000u) {
+      return sign; // < 2^-25 舍入为0
+    }
+    const uint32_t exp = absx >> 23;
+    const uint32_t mant = (absx & 0x7fffffu) | 0x800000u;
+    const uint32_t shift = 126 - exp;
+    uint32_t h = mant >> shift;
+    const uint32_t rem = mant & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    if (rem > halfway || (rem == halfway && (h & 1u)))
+      ++h;
+    return static_cast<uint16_t>(sign | h);
+  }
+
+  // 规格化数：指数偏置由127改为15，尾数舍入（进位可自然进入指数）
+  uint32_t h = (absx - 0x38000000u) >> 13;
+  const uint32_t rem = absx & 0x1fffu;
+  if (rem > 0x1000u || (rem == 0x1000u && (h & 1u)))
+    ++h;
+  return static_cast<uint16_t>(sign | h);
+#endif
+}
+
+// 批量转换
+inline void halfToFloat(const uint16_t *src, float *dst, size_t n) {
+  size_t i = 0;
+#if defined(__F16C__)
+  for (; i + 8 <= n; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+  }
+#endif
+  for (; i < n; ++i)
+    dst[i] = halfToFloat(src[i]);
+}
+
+inline void floatToHalf(const float *src, uint16_t *dst, size_t n) {
+  size_t i = 0;
+#if defined(__F16C__)
+  for (; i + 8 <= n; i += 8) {
+    __m128i h =
+        _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), h);
+  }
+#endif
+  for (; i < n; ++i)
+    dst[i] = floatToHalf(src[i]);
+}
+
+// 半精度浮点数存储类型，运算时转换为float
+struct Float16 {
+  uint16_t bits;
+
+  Float16() : bits(0) {}
+  explicit Float16(float f) : bits(floatToHalf(f)) {}
+
+  operator float() const { return halfToFloat(bits); }
+
+  static Float16 fromBits(uint16_t b) {
+    Float16 h;
+    h.bits = b;
+    return h;
+  }
+};
+
+static_assert(sizeof(Float16) == 2, "Float16 must be 2 bytes");
+
+} // namespace dip
+
+#endif // CORE_FLOAT16_HPP
@@ -28,6 +28,9 @@ public:
   explicit Image(const Matrix &mat, int channels = 1)
       : mat_(mat), channels_(channels) {}
 
+  explicit Image(Matrix &&mat, int channels = 1)
+      : mat_(std::move(mat)), channels_(channels) {}
+
   // 从现有图像创建
   Image(const Image &other) = default;
   Image(Image &&other) = default;
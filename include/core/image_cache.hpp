@@ -0,0 +1,112 @@
+#ifndef CORE_IMAGE_CACHE_HPP
+#define CORE_IMAGE_CACHE_HPP
+
+#include "image.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace dip {
+
+// 图像缓存的统计
+struct ImageCacheStats {
+  size_t hits = 0;
+  size_t misses = 0;        // 即实际调用加载函数的次数
+  size_t coalesced = 0;     // 等待其他线程正在进行的同一加载
+  size_t invalidations = 0; // 文件大小或修改时间变化而丢弃的条目
+  size_t evictions = 0;
+  size_t entries = 0;
+  size_t bytes = 0;         // 当前缓存的字节数
+  size_t peak_bytes = 0;
+
+  // 命中率（等待进行中的加载也算命中，因为没有重复解码）
+  double hit_rate() const {
+    const size_t total = hits + coalesced + misses;
+    return total > 0 ? static_cast<double>(hits + coalesced) / total : 0.0;
+  }
+};
+
+/**
+ * 已解码图像的缓存，按字节上限做LRU淘汰
+ * 键为 路径 + 期望通道数，条目记录文件大小和修改时间；文件变化后旧条目
+ * 失效并重新加载。返回的图像共享且不可修改
+ * 路径按原样作为键，不做规范化："./a.png"、"a.png" 和指向同一文件的
+ * 符号链接是不同的条目
+ * 多个线程同时请求同一个未缓存的文件时只加载一次，其余线程等待结果
+ *
+ * 用法：
+ *   auto img = ImageLoader::load_cached("input.png"); // 使用 global()
+ *   spdlog::info("命中率 {:.1f}%",
+ *                100 * ImageCache::global().stats().hit_rate());
+ *
+ * 所有接口都是线程安全的
+ */
+class ImageCache {
+public:
+  using Loader = std::function<std::shared_ptr<Image>()>;
+
+  explicit ImageCache(size_t budget_bytes = size_t(512) << 20)
+      : budget_(budget_bytes) {}
+
+  ImageCache(const ImageCache &) = delete;
+  ImageCache &operator=(const ImageCache &) = delete;
+
+  // 进程级缓存（ImageLoader::load_cached 使用）
+  static ImageCache &global() {
+    static ImageCache cache;
+    return cache;
+  }
+
+  /**
+   * 取得 path 对应的图像，未缓存时调用 loader 加载
+   * 文件不存在或 loader 返回 nullptr 时返回 nullptr（失败不缓存）；
+   * 大于缓存上限的图像直接返回，不放入缓存
+   * loader 抛出的异常传给所有等待该文件的调用者
+   * loader 应返回自有存储的图像：引用文件映射的图像（load_pnm、load_dipm）
+   * 会随文件的原地改写而改变
+   */
+  std::shared_ptr<const Image> get(const std::string &path,
+                                   int desired_channels, const Loader &loader);
+
+  // 丢弃 path 的所有缓存条目（文件在同一时间戳内被改写时使用）
+  void invalidate(const std::string &path);
+
+  void set_budget(size_t bytes);
+  size_t budget() const;
+  ImageCacheStats stats() const;
+  void reset_stats();
+  void clear();
+
+private:
+  using Result = std::shared_future<std::shared_ptr<const Image>>;
+
+  struct Entry {
+    uint64_t id = 0; // 区分同一个键先后创建的条目
+    uint64_t file_size = 0;
+    int64_t mtime = 0;
+    std::shared_ptr<const Image> image; // 为空表示正在加载
+    Result pending;                     // 正在加载时等待的结果
+    size_t bytes = 0;
+    std::list<std::string>::iterator lru; // 在 lru_ 中的位置（已缓存时）
+  };
+
+  void erase_locked(std::unordered_map<std::string, Entry>::iterator it);
+  void evict_locked();
+
+  mutable std::mutex mutex_;
+  size_t budget_;
+  uint64_t next_id_ = 0;
+  std::list<std::string> lru_; // 最近使用的键在前
+  std::unordered_map<std::string, Entry> cache_;
+  ImageCacheStats stats_;
+};
+
+} // namespace dip
+
+#endif // CORE_IMAGE_CACHE_HPP
@@ -1,21 +1,90 @@
 #ifndef CORE_IMAGE_LOADER_HPP
 #define CORE_IMAGE_LOADER_HPP
 
+#include "atomic_file.hpp"
+#include "dipm.hpp"
+#include "dipz.hpp"
 #include "image.hpp"
+#include "image_cache.hpp"
+#include "parallel.hpp"
+#include "png_encoder.hpp"
+#include "pnm_reader.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <exception>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include <stb/stb_image.h>
+#include <stb/stb_image_write.h>
 
 namespace dip {
 
+namespace detail {
+
+// 将一行 UINT8 样本格式化为 ASCII PNM 文本（空格分隔，行尾换行），
+// out 至少需要 samples * 4 字节，返回写入的字节数
+inline size_t format_ascii_row(const uint8_t *row, size_t samples,
+                               char *out) {
+  char *p = out;
+  for (size_t i = 0; i < samples; ++i) {
+    p = std::to_chars(p, p + 3, row[i]).ptr;
+    *p++ = i + 1 < samples ? ' ' : '\n';
+  }
+  if (samples == 0)
+    *p++ = '\n';
+  return static_cast<size_t>(p - out);
+}
+
+} // namespace detail
+
+// 压缩格式的保存参数
+struct SaveOptions {
+  int jpeg_quality = 90;   // JPEG质量 1..100
+  int png_compression = 6; // PNG压缩级别 0..9（0 不压缩）
+};
+
 class ImageLoader {
 public:
   // 从文件加载图像
   static std::shared_ptr<Image> load_from_file(const std::string &filename,
                                                int desired_channels = 0) {
+    DIP_TRACE_SCOPE("ImageLoader::load_from_file");
+    DIP_MEMORY_SCOPE("ImageLoader::load_from_file");
+    // 二进制PNM优先使用原生读取器，直接读入图像自有的缓冲区（不映射文件，
+    // 之后改写或截断文件不影响返回的图像）；通道数需要转换或文件不是P5/P6
+    // 时交给stb处理
+    if (is_pnm_extension(filename)) {
+      PnmHeader header;
+      if (read_pnm_header(filename, header) &&
+          header.type() == DataType::UINT8 &&
+          (desired_channels == 0 || desired_channels == header.channels)) {
+        auto image = std::make_shared<Image>();
+        if (read_pnm(filename, *image))
+          return image;
+      }
+    }
+    // .dipm/.dipz 保留原有的 DataType（.dipm 直接读入自有缓冲区，零拷贝
+    // 映射见 load_dipm）
+    if (is_native_extension(filename)) {
+      auto image = has_extension(filename, "dipm") ? read_dipm_file(filename)
+                                                   : load_dipz(filename);
+      if (!image || desired_channels == 0 ||
+          desired_channels == image->channels())
+        return image;
+      std::cerr << "Error: Cannot convert channels of '" << filename << "'"
+                << std::endl;
+      return nullptr;
+    }
+
     int width, height, channels;
     unsigned char *data = stbi_load(filename.c_str(), &width, &height,
                                     &channels, desired_channels);
@@ -40,10 +109,164 @@ public:
     return image;
   }
 
+  /**
+   * 经进程级缓存 ImageCache::global() 加载：同一文件（大小和修改时间未变）
+   * 只解码一次，并发请求同一文件时只有一个线程解码
+   * 缓存的图像总是自有存储（引用外部存储时先拷贝），之后改写或截断文件
+   * 不影响已返回的图像；图像与其他调用者共享，需要修改时先 clone()
+   * 路径不做规范化，"./a.png" 和 "a.png" 是不同的缓存条目
+   */
+  static std::shared_ptr<const Image>
+  load_cached(const std::string &filename, int desired_channels = 0) {
+    DIP_TRACE_SCOPE("ImageLoader::load_cached");
+    return ImageCache::global().get(filename, desired_channels, [&]() {
+      auto image = load_from_file(filename, desired_channels);
+      if (image && image->matrix().isExternal())
+        image = std::make_shared<Image>(image->clone());
+      return image;
+    });
+  }
+
+  /**
+   * 加载 .dipm 文件（任意 DataType 和通道数）
+   * 返回直接引用只读映射内存的图像，不解析、不拷贝；图像存活期间不能原地
+   * 改写或截断该文件（见 map_dipm）。加载失败时返回 nullptr
+   */
+  static std::shared_ptr<const Image> load_dipm(const std::string &filename) {
+    DIP_TRACE_SCOPE("ImageLoader::load_dipm");
+    std::string error;
+    auto image = map_dipm(filename, &error);
+    if (!image)
+      std::cerr << "Error: Failed to load .dipm " << error << std::endl;
+    return image;
+  }
+
+  /**
+   * 加载 .dipz 文件（任意 DataType 和通道数），各块并行解码
+   * 加载失败时返回 nullptr
+   */
+  static std::shared_ptr<Image> load_dipz(const std::string &filename) {
+    DIP_TRACE_SCOPE("ImageLoader::load_dipz");
+    DIP_MEMORY_SCOPE("ImageLoader::load_dipz");
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+      std::cerr << "Error: Cannot open file: " << filename << std::endl;
+      return nullptr;
+    }
+    std::vector<uint8_t> encoded(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(encoded.data()), encoded.size());
+    if (!file) {
+      std::cerr << "Error: Failed to read file: " << filename << std::endl;
+      return nullptr;
+    }
+
+    auto image = std::make_shared<Image>();
+    std::string error;
+    if (!decode_dipz(encoded.data(), encoded.size(), *image, &error)) {
+      std::cerr << "Error: Failed to load .dipz '" << filename
+                << "': " << error << std::endl;
+      return nullptr;
+    }
+    return image;
+  }
+
+  /**
+   * 使用原生读取器加载二进制PNM（P5/P6）文件
+   * 8位文件返回直接引用映射内存的图像（零拷贝）；maxval > 255 的文件返回
+   * UINT16 图像（本机字节序），stb 会将其截断为8位
+   * 映射不是快照：图像存活期间原地改写或截断该文件（包括保存回同一路径）
+   * 会改变像素，或在访问时触发 SIGBUS；需要独立副本时使用
+   * load_from_file / load_auto
+   * 加载失败时返回 nullptr
+   */
+  static std::shared_ptr<Image> load_pnm(const std::string &filename) {
+    DIP_TRACE_SCOPE("ImageLoader::load_pnm");
+    DIP_MEMORY_SCOPE("ImageLoader::load_pnm");
+    PnmReader reader;
+    if (!reader.open(filename)) {
+      std::cerr << "Error: Failed to load PNM " << reader.error() << std::endl;
+      return nullptr;
+    }
+    return std::make_shared<Image>(reader.image());
+  }
+
+  /**
+   * 加载为 UINT16 图像（stbi_load_16），16位PNG/PNM不损失精度，
+   * 8位文件按 v * 257 扩展到16位
+   * 直接使用 stb 分配的缓冲区，不再拷贝；加载失败时返回 nullptr
+   */
+  static std::shared_ptr<Image> load_16(const std::string &filename,
+                                        int desired_channels = 0) {
+    DIP_TRACE_SCOPE("ImageLoader::load_16");
+    DIP_MEMORY_SCOPE("ImageLoader::load_16");
+    int width, height, channels;
+    stbi_us *data = stbi_load_16(filename.c_str(), &width, &height, &channels,
+                                 desired_channels);
+    if (!data) {
+      std::cerr << "Error: Failed to load image '" << filename
+                << "': " << stbi_failure_reason() << std::endl;
+      return nullptr;
+    }
+    return adopt_stb_buffer(data, width, height,
+                            desired_channels > 0 ? desired_channels : channels,
+                            DataType::UINT16);
+  }
+
+  /**
+   * 加载为 FLOAT32 图像（stbi_loadf），HDR（.hdr）文件保留原始线性值；
+   * 8/16位文件由 stb 按 gamma 2.2 转换到线性 [0, 1]
+   * 直接使用 stb 分配的缓冲区，不再拷贝；加载失败时返回 nullptr
+   */
+  static std::shared_ptr<Image> load_float(const std::string &filename,
+                                           int desired_channels = 0) {
+    DIP_TRACE_SCOPE("ImageLoader::load_float");
+    DIP_MEMORY_SCOPE("ImageLoader::load_float");
+    int width, height, channels;
+    float *data = stbi_loadf(filename.c_str(), &width, &height, &channels,
+                             desired_channels);
+    if (!data) {
+      std::cerr << "Error: Failed to load image '" << filename
+                << "': " << stbi_failure_reason() << std::endl;
+      return nullptr;
+    }
+    return adopt_stb_buffer(data, width, height,
+                            desired_channels > 0 ? desired_channels : channels,
+                            DataType::FLOAT32);
+  }
+
+  /**
+   * 按文件的位深选择加载方式：HDR 文件为 FLOAT32，16位文件为 UINT16，
+   * 其余为 UINT8（同 load_from_file）
+   * 二进制PNM优先使用原生读取器
+   */
+  static std::shared_ptr<Image> load_auto(const std::string &filename,
+                                          int desired_channels = 0) {
+    DIP_TRACE_SCOPE("ImageLoader::load_auto");
+    if (is_native_extension(filename))
+      return load_from_file(filename, desired_channels);
+    if (is_pnm_extension(filename)) {
+      PnmHeader header;
+      if (read_pnm_header(filename, header) &&
+          (desired_channels == 0 || desired_channels == header.channels)) {
+        auto image = std::make_shared<Image>();
+        if (read_pnm(filename, *image))
+          return image;
+      }
+    }
+    if (stbi_is_hdr(filename.c_str()))
+      return load_float(filename, desired_channels);
+    if (stbi_is_16_bit(filename.c_str()))
+      return load_16(filename, desired_channels);
+    return load_from_file(filename, desired_channels);
+  }
+
   // 从内存加载图像
   static std::shared_ptr<Image> load_from_memory(const unsigned char *buffer,
                                                  int len,
                                                  int desired_channels = 0) {
+    DIP_TRACE_SCOPE("ImageLoader::load_from_memory");
+    DIP_MEMORY_SCOPE("ImageLoader::load_from_memory");
     int width, height, channels;
     unsigned char *data = stbi_load_from_memory(buffer, len, &width, &height,
                                                 &channels, desired_channels);
@@ -65,9 +288,117 @@ public:
     return image;
   }
 
+  /**
+   * 在I/O线程池上并行加载多个文件，立即返回
+   * 每个 future 在对应文件解码完成后就绪，可以边加载边处理已就绪的图像
+   * 加载失败时 future 的值为 nullptr（与 load_from_file 一致）
+   * @param paths 文件路径
+   * @param threads 最多同时解码的文件数（0 表示I/O线程池的线程数）
+   * @param desired_channels 期望通道数（0 表示保持原始通道数）
+   */
+  static std::vector<std::future<std::shared_ptr<Image>>>
+  load_batch(const std::vector<std::string> &paths, int threads = 0,
+             int desired_channels = 0) {
+    struct State {
+      std::vector<std::string> paths;
+      std::vector<std::promise<std::shared_ptr<Image>>> promises;
+      std::atomic<size_t> next{0};
+      int desired_channels;
+    };
+    auto state = std::make_shared<State>();
+    state->paths = paths;
+    state->promises.resize(paths.size());
+    state->desired_channels = desired_channels;
+
+    std::vector<std::future<std::shared_ptr<Image>>> futures;
+    futures.reserve(paths.size());
+    for (auto &promise : state->promises)
+      futures.push_back(promise.get_future());
+
+    // 每个工作任务按顺序领取文件，先提交的文件先完成
+    ThreadPool &pool = ThreadPool::io();
+    const size_t workers =
+        std::min(paths.size(), threads > 0 ? static_cast<size_t>(threads)
+                                           : pool.size());
+    for (size_t w = 0; w < workers; ++w) {
+      pool.post([state] {
+        for (;;) {
+          const size_t i = state->next.fetch_add(1);
+          if (i >= state->paths.size())
+            return;
+          try {
+            state->promises[i].set_value(
+                load_from_file(state->paths[i], state->desired_channels));
+          } catch (...) {
+            state->promises[i].set_exception(std::current_exception());
+          }
+        }
+      });
+    }
+    return futures;
+  }
+
+  /**
+   * 并行加载多个文件，每个文件解码完成后立即调用 on_loaded(index, image)
+   * 回调在I/O线程（以及调用线程）上并发执行，因此处理与其余文件的解码重叠
+   * 函数在所有回调返回后才返回；回调抛出的第一个异常在此时重新抛出
+   * 加载失败的文件以 nullptr 调用回调
+   */
+  static void load_batch(
+      const std::vector<std::string> &paths,
+      const std::function<void(size_t, std::shared_ptr<Image>)> &on_loaded,
+      int threads = 0, int desired_channels = 0) {
+    struct State {
+      std::atomic<size_t> next{0};
+      std::atomic<size_t> done{0};
+      std::mutex mutex;
+      std::condition_variable cv;
+      std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+    const size_t count = paths.size();
+
+    // 领取并处理文件，直到没有剩余；迟到的任务不会再访问 paths/on_loaded
+    auto run = [state, &paths, &on_loaded, count, desired_channels] {
+      for (;;) {
+        const size_t i = state->next.fetch_add(1);
+        if (i >= count)
+          return;
+        try {
+          on_loaded(i, load_from_file(paths[i], desired_channels));
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          if (!state->error)
+            state->error = std::current_exception();
+        }
+        if (state->done.fetch_add(1) + 1 == count) {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          state->cv.notify_all();
+        }
+      }
+    };
+
+    ThreadPool &pool = ThreadPool::io();
+    const size_t workers =
+        std::min(count, threads > 0 ? static_cast<size_t>(threads)
+                                    : pool.size());
+    for (size_t w = 1; w < workers; ++w)
+      pool.post(run);
+
+    // 调用线程也参与，即使在I/O线程内调用也不会死锁
+    run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->done.load() == count; });
+    if (state->error)
+      std::rethrow_exception(state->error);
+  }
+
   // 获取图像信息（不加载完整图像数据）
   static bool get_image_info(const std::string &filename, int &width,
                              int &height, int &channels) {
+    DIP_TRACE_SCOPE("ImageLoader::get_image_info");
+    DIP_MEMORY_SCOPE("ImageLoader::get_image_info");
     return stbi_info(filename.c_str(), &width, &height, &channels) != 0;
   }
 
@@ -92,91 +423,239 @@ public:
 
   // 保存图像为PPM格式（简化实现）
   static bool save_as_ppm(const Image &image, const std::string &filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-      std::cerr << "Error: Cannot open file for writing: " << filename
+    DIP_TRACE_SCOPE("ImageLoader::save_as_ppm");
+    DIP_MEMORY_SCOPE("ImageLoader::save_as_ppm");
+    if (image.channels() != 1 && image.channels() != 3) {
+      std::cerr << "Error: Only 1 or 3 channel images supported for PPM saving"
+                << std::endl;
+      return false;
+    }
+    // 文本格式按8位样本格式化；16位图像使用 save_as_ppm_binary
+    if (image.type() != DataType::UINT8) {
+      std::cerr << "Error: Only UINT8 images supported for PPM saving"
                 << std::endl;
       return false;
     }
 
-    if (image.channels() == 1) {
-      // PGM (grayscale)
-      file << "P2\n";
-      file << image.width() << " " << image.height() << "\n";
-      file << "255\n";
-
-      for (int y = 0; y < image.height(); ++y) {
-        for (int x = 0; x < image.width(); ++x) {
-          file << static_cast<int>(image.at<uint8_t>(y, x, 0));
-          if (x < image.width() - 1)
-            file << " ";
-        }
-        file << "\n";
-      }
-    } else if (image.channels() == 3) {
-      // PPM (color)
-      file << "P3\n";
-      file << image.width() << " " << image.height() << "\n";
-      file << "255\n";
-
-      for (int y = 0; y < image.height(); ++y) {
-        for (int x = 0; x < image.width(); ++x) {
-          for (int c = 0; c < 3; ++c) {
-            file << static_cast<int>(image.at<uint8_t>(y, x, c));
-            if (c < 2 || x < image.width() - 1)
-              file << " ";
-          }
-        }
-        file << "\n";
-      }
-    } else {
-      std::cerr << "Error: Only 1 or 3 channel images supported for PPM saving"
+    AtomicFile out(filename);
+    std::ofstream file(out.path());
+    if (!file.is_open()) {
+      std::cerr << "Error: Cannot open file for writing: " << filename
                 << std::endl;
       return false;
     }
 
+    // P2 灰度 / P3 彩色
+    file << (image.channels() == 1 ? "P2\n" : "P3\n");
+    file << image.width() << " " << image.height() << "\n";
+    file << "255\n";
+
+    // 按行块格式化到缓冲区（每块约1MB），每轮由各线程并行格式化若干块，
+    // 再按顺序整块写出，输出与逐像素写入完全一致
+    const size_t samples =
+        static_cast<size_t>(image.width()) * image.channels();
+    const size_t row_capacity = samples * 4 + 1;
+    const int block_rows = static_cast<int>(
+        std::max<size_t>(1, (size_t(1) << 20) / row_capacity));
+    const int blocks = (image.height() + block_rows - 1) / block_rows;
+    const int blocks_per_round = std::max(1, get_num_threads() * 2);
+    std::vector<std::string> buffers(std::min(blocks, blocks_per_round));
+
+    for (int first = 0; first < blocks; first += blocks_per_round) {
+      const int count = std::min(blocks_per_round, blocks - first);
+      parallel_for(
+          0, count,
+          [&](int b0, int b1) {
+            for (int b = b0; b < b1; ++b) {
+              const int y0 = (first + b) * block_rows;
+              const int y1 = std::min(image.height(), y0 + block_rows);
+              std::string &buffer = buffers[b];
+              buffer.resize(row_capacity * (y1 - y0));
+              size_t length = 0;
+              for (int y = y0; y < y1; ++y)
+                length += detail::format_ascii_row(image.ptr<uint8_t>(y),
+                                                   samples, &buffer[length]);
+              buffer.resize(length);
+            }
+          },
+          1);
+      for (int b = 0; b < count; ++b)
+        file.write(buffers[b].data(), buffers[b].size());
+    }
+
     file.close();
-    return true;
+    return static_cast<bool>(file) && commit_file(out, filename);
   }
 
   // 保存图像为二进制PPM格式
   static bool save_as_ppm_binary(const Image &image,
                                  const std::string &filename) {
-    std::ofstream file(filename, std::ios::binary);
+    DIP_TRACE_SCOPE("ImageLoader::save_as_ppm_binary");
+    DIP_MEMORY_SCOPE("ImageLoader::save_as_ppm_binary");
+    AtomicFile out(filename);
+    std::ofstream file(out.path(), std::ios::binary);
     if (!file.is_open()) {
       std::cerr << "Error: Cannot open file for writing: " << filename
                 << std::endl;
       return false;
     }
 
-    if (image.channels() == 1) {
-      // PGM binary
-      file << "P5\n";
-      file << image.width() << " " << image.height() << "\n";
-      file << "255\n";
+    if (image.channels() != 1 && image.channels() != 3) {
+      std::cerr
+          << "Error: Only 1 or 3 channel images supported for PPM binary saving"
+          << std::endl;
+      return false;
+    }
+    if (image.type() != DataType::UINT8 && image.type() != DataType::UINT16) {
+      std::cerr << "Error: Only UINT8 or UINT16 images supported for PPM "
+                   "binary saving"
+                << std::endl;
+      return false;
+    }
+
+    // P5 灰度 / P6 彩色；UINT16 图像写为 maxval 65535，样本为大端字节序
+    const bool wide = image.type() == DataType::UINT16;
+    file << (image.channels() == 1 ? "P5\n" : "P6\n");
+    file << image.width() << " " << image.height() << "\n";
+    file << (wide ? "65535\n" : "255\n");
 
+    const size_t samples =
+        static_cast<size_t>(image.width()) * image.channels();
+    if (!wide) {
       for (int y = 0; y < image.height(); ++y) {
         file.write(reinterpret_cast<const char *>(image.ptr<uint8_t>(y)),
-                   image.width());
+                   samples);
       }
-    } else if (image.channels() == 3) {
-      // PPM binary
-      file << "P6\n";
-      file << image.width() << " " << image.height() << "\n";
-      file << "255\n";
-
+    } else {
+      std::vector<uint8_t> row(samples * 2);
       for (int y = 0; y < image.height(); ++y) {
-        file.write(reinterpret_cast<const char *>(image.ptr<uint8_t>(y)),
-                   image.width() * 3);
+        const uint16_t *src = image.ptr<uint16_t>(y);
+        for (size_t i = 0; i < samples; ++i) {
+          row[2 * i] = static_cast<uint8_t>(src[i] >> 8);
+          row[2 * i + 1] = static_cast<uint8_t>(src[i] & 0xFF);
+        }
+        file.write(reinterpret_cast<const char *>(row.data()), row.size());
       }
-    } else {
-      std::cerr
-          << "Error: Only 1 or 3 channel images supported for PPM binary saving"
-          << std::endl;
+    }
+
+    file.close();
+    if (!file) {
+      std::cerr << "Error: Failed to write PPM file: " << filename
+                << std::endl;
+      return false;
+    }
+    return commit_file(out, filename);
+  }
+
+  /**
+   * 保存为PNG，支持 UINT8/UINT16，1-4 通道
+   * 大图像按条带并行滤波和压缩，见 encode_png()
+   */
+  static bool save_as_png(const Image &image, const std::string &filename,
+                          int compression_level = 6) {
+    DIP_TRACE_SCOPE("ImageLoader::save_as_png");
+    DIP_MEMORY_SCOPE("ImageLoader::save_as_png");
+    std::vector<uint8_t> encoded;
+    try {
+      PngOptions options;
+      options.compression_level = compression_level;
+      encode_png(image, encoded, options);
+    } catch (const std::exception &e) {
+      std::cerr << "Error: Failed to encode PNG '" << filename
+                << "': " << e.what() << std::endl;
       return false;
     }
 
+    AtomicFile out(filename);
+    std::ofstream file(out.path(), std::ios::binary);
+    if (!file.is_open()) {
+      std::cerr << "Error: Cannot open file for writing: " << filename
+                << std::endl;
+      return false;
+    }
+    file.write(reinterpret_cast<const char *>(encoded.data()),
+               encoded.size());
+    file.close();
+    return static_cast<bool>(file) && commit_file(out, filename);
+  }
+
+  // 保存为JPEG（UINT8，1-4 通道，Alpha 通道被忽略），quality 为 1..100
+  static bool save_as_jpeg(const Image &image, const std::string &filename,
+                           int quality = 90) {
+    DIP_TRACE_SCOPE("ImageLoader::save_as_jpeg");
+    DIP_MEMORY_SCOPE("ImageLoader::save_as_jpeg");
+    if (!check_stb_writable(image, "JPEG"))
+      return false;
+    AtomicFile out(filename);
+    std::vector<uint8_t> scratch;
+    const int written = stbi_write_jpg(
+        out.path().c_str(), image.width(), image.height(), image.channels(),
+        contiguous_pixels(image, scratch), quality);
+    return report_stb_write(written, filename) && commit_file(out, filename);
+  }
+
+  // 保存为BMP（UINT8，1-4 通道）
+  static bool save_as_bmp(const Image &image, const std::string &filename) {
+    DIP_TRACE_SCOPE("ImageLoader::save_as_bmp");
+    DIP_MEMORY_SCOPE("ImageLoader::save_as_bmp");
+    if (!check_stb_writable(image, "BMP"))
+      return false;
+    AtomicFile out(filename);
+    std::vector<uint8_t> scratch;
+    const int written = stbi_write_bmp(out.path().c_str(), image.width(),
+                                       image.height(), image.channels(),
+                                       contiguous_pixels(image, scratch));
+    return report_stb_write(written, filename) && commit_file(out, filename);
+  }
+
+  // 保存为TGA（UINT8，1-4 通道，RLE压缩）
+  static bool save_as_tga(const Image &image, const std::string &filename) {
+    DIP_TRACE_SCOPE("ImageLoader::save_as_tga");
+    DIP_MEMORY_SCOPE("ImageLoader::save_as_tga");
+    if (!check_stb_writable(image, "TGA"))
+      return false;
+    AtomicFile out(filename);
+    std::vector<uint8_t> scratch;
+    const int written = stbi_write_tga(out.path().c_str(), image.width(),
+                                       image.height(), image.channels(),
+                                       contiguous_pixels(image, scratch));
+    return report_stb_write(written, filename) && commit_file(out, filename);
+  }
+
+  // 保存为 .dipz（无损压缩，任意 DataType，保留通道数），各块并行编码
+  static bool save_as_dipz(const Image &image, const std::string &filename) {
+    DIP_TRACE_SCOPE("ImageLoader::save_as_dipz");
+    DIP_MEMORY_SCOPE("ImageLoader::save_as_dipz");
+    std::vector<uint8_t> encoded;
+    try {
+      encode_dipz(image, encoded);
+    } catch (const std::exception &e) {
+      std::cerr << "Error: Failed to encode .dipz '" << filename
+                << "': " << e.what() << std::endl;
+      return false;
+    }
+
+    AtomicFile out(filename);
+    std::ofstream file(out.path(), std::ios::binary);
+    if (!file.is_open()) {
+      std::cerr << "Error: Cannot open file for writing: " << filename
+                << std::endl;
+      return false;
+    }
+    file.write(reinterpret_cast<const char *>(encoded.data()),
+               encoded.size());
     file.close();
+    return static_cast<bool>(file) && commit_file(out, filename);
+  }
+
+  // 保存为 .dipm（任意 DataType，保留通道数），可由 load_dipm 零拷贝载入
+  static bool save_as_dipm(const Image &image, const std::string &filename) {
+    DIP_TRACE_SCOPE("ImageLoader::save_as_dipm");
+    std::string error;
+    if (!write_dipm(image, filename, &error)) {
+      std::cerr << "Error: Failed to save .dipm " << error << std::endl;
+      return false;
+    }
     return true;
   }
 
@@ -204,12 +683,120 @@ public:
 
 private:
   ImageLoader() = default; // 静态类，禁止实例化
+
+  // 将 .dipm 读入自有缓冲区（load_from_file 使用）
+  static std::shared_ptr<Image> read_dipm_file(const std::string &filename) {
+    auto image = std::make_shared<Image>();
+    std::string error;
+    if (read_dipm(filename, *image, &error))
+      return image;
+    std::cerr << "Error: Failed to load .dipm " << error << std::endl;
+    return nullptr;
+  }
+
+  static std::string lower_extension(const std::string &filename) {
+    const size_t dot = filename.find_last_of('.');
+    if (dot == std::string::npos)
+      return std::string();
+    std::string ext = filename.substr(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext;
+  }
+
+  static bool is_pnm_extension(const std::string &filename) {
+    const std::string ext = lower_extension(filename);
+    return ext == "pgm" || ext == "ppm" || ext == "pnm";
+  }
+
+  static bool has_extension(const std::string &filename, const char *ext) {
+    return lower_extension(filename) == ext;
+  }
+
+  // 本库的原生格式（.dipm/.dipz）
+  static bool is_native_extension(const std::string &filename) {
+    const std::string ext = lower_extension(filename);
+    return ext == "dipm" || ext == "dipz";
+  }
+
+  // 用 stb 分配的像素缓冲区构造图像（零拷贝），图像释放时调用 stbi_image_free
+  static std::shared_ptr<Image> adopt_stb_buffer(void *data, int width,
+                                                 int height, int channels,
+                                                 DataType type) {
+    std::shared_ptr<void> owner(data, stbi_image_free);
+    return std::make_shared<Image>(
+        Matrix::fromExternal(height, width * channels, type, data,
+                             std::move(owner)),
+        channels);
+  }
+
+  // stb_image_write 只接受 8 位数据
+  static bool check_stb_writable(const Image &image, const char *format) {
+    if (image.empty() || image.type() != DataType::UINT8 ||
+        image.channels() < 1 || image.channels() > 4) {
+      std::cerr << "Error: Only non-empty UINT8 images with 1-4 channels "
+                   "supported for "
+                << format << " saving" << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  // 行连续存放的像素；ROI 图像的行跨度大于行宽，先拷贝到 scratch
+  static const uint8_t *contiguous_pixels(const Image &image,
+                                          std::vector<uint8_t> &scratch) {
+    const size_t row_bytes =
+        static_cast<size_t>(image.width()) * image.channels();
+    if (image.matrix().step() == row_bytes)
+      return image.ptr<uint8_t>();
+    scratch.resize(row_bytes * image.height());
+    for (int y = 0; y < image.height(); ++y)
+      std::memcpy(scratch.data() + row_bytes * y, image.ptr<uint8_t>(y),
+                  row_bytes);
+    return scratch.data();
+  }
+
+  // 用写好的临时文件替换目标文件
+  static bool commit_file(AtomicFile &out, const std::string &filename) {
+    std::string error;
+    if (!out.commit(&error)) {
+      std::cerr << "Error: Failed to write image '" << filename
+                << "': " << error << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  static bool report_stb_write(int result, const std::string &filename) {
+    if (result == 0) {
+      std::cerr << "Error: Failed to write image: " << filename << std::endl;
+      return false;
+    }
+    return true;
+  }
 };
 
 // 图像保存工具类
 namespace image_saver {
 
-inline bool save(const Image &image, const std::string &filename) {
+// 压缩格式（PNG/JPEG/BMP/TGA），文本和二进制保存时相同
+inline bool is_encoded_format(const std::string &ext) {
+  return ext == "png" || ext == "jpg" || ext == "jpeg" || ext == "bmp" ||
+         ext == "tga";
+}
+
+inline bool save_encoded(const Image &image, const std::string &filename,
+                         const std::string &ext, const SaveOptions &options) {
+  if (ext == "png")
+    return ImageLoader::save_as_png(image, filename, options.png_compression);
+  if (ext == "jpg" || ext == "jpeg")
+    return ImageLoader::save_as_jpeg(image, filename, options.jpeg_quality);
+  if (ext == "bmp")
+    return ImageLoader::save_as_bmp(image, filename);
+  return ImageLoader::save_as_tga(image, filename);
+}
+
+inline bool save(const Image &image, const std::string &filename,
+                 const SaveOptions &options = SaveOptions()) {
   // 根据扩展名选择保存格式
   std::string ext = filename.substr(filename.find_last_of('.') + 1);
   std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
@@ -218,14 +805,23 @@ inline bool save(const Image &image, const std::string &filename) {
     return ImageLoader::save_as_ppm(image, filename);
   } else if (ext == "pgm") {
     return ImageLoader::save_as_pgm(image, filename);
+  } else if (is_encoded_format(ext)) {
+    return save_encoded(image, filename, ext, options);
+  } else if (ext == "dipm") {
+    return ImageLoader::save_as_dipm(image, filename);
+  } else if (ext == "dipz") {
+    return ImageLoader::save_as_dipz(image, filename);
   } else {
     std::cerr << "Error: Unsupported output format: " << ext << std::endl;
-    std::cerr << "Supported formats: .ppm, .pgm" << std::endl;
+    std::cerr << "Supported formats: .ppm, .pgm, .png, .jpg, .bmp, .tga, "
+                 ".dipm, .dipz"
+              << std::endl;
     return false;
   }
 }
 
-inline bool save_binary(const Image &image, const std::string &filename) {
+inline bool save_binary(const Image &image, const std::string &filename,
+                        const SaveOptions &options = SaveOptions()) {
   std::string ext = filename.substr(filename.find_last_of('.') + 1);
   std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
 
@@ -233,13 +829,46 @@ inline bool save_binary(const Image &image, const std::string &filename) {
     return ImageLoader::save_as_ppm_binary(image, filename);
   } else if (ext == "pgm") {
     return ImageLoader::save_as_pgm_binary(image, filename);
+  } else if (is_encoded_format(ext)) {
+    return save_encoded(image, filename, ext, options);
+  } else if (ext == "dipm") {
+    return ImageLoader::save_as_dipm(image, filename);
+  } else if (ext == "dipz") {
+    return ImageLoader::save_as_dipz(image, filename);
   } else {
     std::cerr << "Error: Unsupported output format: " << ext << std::endl;
-    std::cerr << "Supported formats: .ppm, .pgm" << std::endl;
+    std::cerr << "Supported formats: .ppm, .pgm, .png, .jpg, .bmp, .tga, "
+                 ".dipm, .dipz"
+              << std::endl;
     return false;
   }
 }
 
+/**
+ * 并行保存多张图像（按扩展名选择格式，同 save_binary）
+ * 各图像按张分配到线程上独立编码和写入（单张内部不再并行）
+ * @return 成功保存的图像数
+ * @throws std::invalid_argument images 与 filenames 数量不一致
+ */
+inline size_t save_batch(const std::vector<Image> &images,
+                         const std::vector<std::string> &filenames,
+                         const SaveOptions &options = SaveOptions()) {
+  if (images.size() != filenames.size())
+    throw std::invalid_argument("save_batch: images and filenames differ in "
+                                "size");
+  std::atomic<size_t> saved{0};
+  parallel_for(
+      0, static_cast<int>(images.size()),
+      [&](int i0, int i1) {
+        for (int i = i0; i < i1; ++i) {
+          if (save_binary(images[i], filenames[i], options))
+            ++saved;
+        }
+      },
+      1);
+  return saved.load();
+}
+
 } // namespace image_saver
 
 } // namespace dip
@@ -2,11 +2,15 @@
 #define CORE_MATRIX_HPP
 
 #include "basic_types.hpp"
+#include "float16.hpp"
+#include "memory_stats.hpp"
+#include "simd.hpp"
 #include "vector_types.hpp"
 #include <algorithm>
 #include <cstring>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 namespace dip {
@@ -17,9 +21,23 @@ private:
   int rows_;
   int cols_;
   DataType dtype_;
-  std::vector<uint8_t> data_;
+  std::vector<uint8_t, memory::ByteAllocator> data_;
   size_t step_; // 每行字节数
 
+  // 外部存储（如内存映射的文件）：external_ 非空时数据位于其中，
+  // owner_ 保证其有效；拷贝外部存储的矩阵得到自有存储的深拷贝
+  uint8_t *external_ = nullptr;
+  std::shared_ptr<void> owner_;
+
+  uint8_t *base() { return external_ ? external_ : data_.data(); }
+  const uint8_t *base() const { return external_ ? external_ : data_.data(); }
+  size_t byteSize() const { return static_cast<size_t>(rows_) * step_; }
+
+  void detachExternal() {
+    external_ = nullptr;
+    owner_.reset();
+  }
+
 public:
   // 构造函数
   Matrix() : rows_(0), cols_(0), dtype_(DataType::UINT8), step_(0) {}
@@ -39,10 +57,78 @@ public:
       : Matrix(size.height, size.width, dtype) {}
 
   // 拷贝/移动构造
-  Matrix(const Matrix &other) = default;
-  Matrix(Matrix &&other) = default;
-  Matrix &operator=(const Matrix &other) = default;
-  Matrix &operator=(Matrix &&other) = default;
+  Matrix(const Matrix &other)
+      : rows_(other.rows_), cols_(other.cols_), dtype_(other.dtype_),
+        step_(other.step_) {
+    if (other.external_)
+      data_.assign(other.base(), other.base() + other.byteSize());
+    else
+      data_ = other.data_;
+  }
+
+  Matrix(Matrix &&other) noexcept
+      : rows_(other.rows_), cols_(other.cols_), dtype_(other.dtype_),
+        data_(std::move(other.data_)), step_(other.step_),
+        external_(other.external_), owner_(std::move(other.owner_)) {
+    other.rows_ = other.cols_ = 0;
+    other.step_ = 0;
+    other.external_ = nullptr;
+  }
+
+  Matrix &operator=(const Matrix &other) {
+    if (this == &other)
+      return *this;
+    if (other.external_) {
+      data_.assign(other.base(), other.base() + other.byteSize());
+    } else {
+      data_ = other.data_;
+    }
+    detachExternal();
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    dtype_ = other.dtype_;
+    step_ = other.step_;
+    return *this;
+  }
+
+  Matrix &operator=(Matrix &&other) noexcept {
+    if (this == &other)
+      return *this;
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    dtype_ = other.dtype_;
+    data_ = std::move(other.data_);
+    step_ = other.step_;
+    external_ = other.external_;
+    owner_ = std::move(other.owner_);
+    other.rows_ = other.cols_ = 0;
+    other.step_ = 0;
+    other.external_ = nullptr;
+    return *this;
+  }
+
+  /**
+   * 包装外部数据而不复制（如内存映射的文件）
+   * 每行 step 字节（0 表示按行连续存放，即 cols * elemSize 字节）
+   * owner 在矩阵（及其移动后的对象）存活期间保持数据有效
+   */
+  static Matrix fromExternal(int rows, int cols, DataType dtype, void *data,
+                             std::shared_ptr<void> owner, size_t step = 0) {
+    Matrix result;
+    const size_t row_bytes = static_cast<size_t>(cols) * dataTypeSize(dtype);
+    if (rows <= 0 || cols <= 0 || !data || (step != 0 && step < row_bytes))
+      return result;
+    result.rows_ = rows;
+    result.cols_ = cols;
+    result.dtype_ = dtype;
+    result.step_ = step != 0 ? step : row_bytes;
+    result.external_ = static_cast<uint8_t *>(data);
+    result.owner_ = std::move(owner);
+    return result;
+  }
+
+  // 数据是否位于外部存储
+  bool isExternal() const { return external_ != nullptr; }
 
   // 基本属性
   int rows() const { return rows_; }
@@ -55,20 +141,19 @@ public:
   size_t total() const { return static_cast<size_t>(rows_) * cols_; }
 
   // 数据访问
-  void *data() { return data_.data(); }
-  const void *data() const { return data_.data(); }
+  void *data() { return base(); }
+  const void *data() const { return base(); }
 
   template <typename T> T *ptr(int row = 0) {
     if (row < 0 || row >= rows_)
       throw std::out_of_range("Row index out of range");
-    return reinterpret_cast<T *>(data_.data() +
-                                 static_cast<size_t>(row) * step_);
+    return reinterpret_cast<T *>(base() + static_cast<size_t>(row) * step_);
   }
 
   template <typename T> const T *ptr(int row = 0) const {
     if (row < 0 || row >= rows_)
       throw std::out_of_range("Row index out of range");
-    return reinterpret_cast<const T *>(data_.data() +
+    return reinterpret_cast<const T *>(base() +
                                        static_cast<size_t>(row) * step_);
   }
 
@@ -98,7 +183,7 @@ public:
     result.step_ = step_;
 
     // 复制ROI数据
-    const uint8_t *src_ptr = data_.data() +
+    const uint8_t *src_ptr = base() +
                              static_cast<size_t>(region.y) * step_ +
                              static_cast<size_t>(region.x) * elemSize();
     result.data_.resize(static_cast<size_t>(result.rows_) * result.step_);
@@ -139,6 +224,15 @@ public:
     case DataType::INT16:
       convertFrom<int16_t>(result, newType);
       break;
+    case DataType::UINT32:
+      convertFrom<uint32_t>(result, newType);
+      break;
+    case DataType::INT32:
+      convertFrom<int32_t>(result, newType);
+      break;
+    case DataType::FLOAT16:
+      convertFrom<Float16>(result, newType);
+      break;
     case DataType::FLOAT32:
       convertFrom<float>(result, newType);
       break;
@@ -157,12 +251,19 @@ public:
     result.cols_ = cols_;
     result.dtype_ = dtype_;
     result.step_ = step_;
-    result.data_ = data_;
+    result.data_.assign(base(), base() + byteSize());
     return result;
   }
 
   // 重置大小
   void create(int rows, int cols, DataType dtype = DataType::UINT8) {
+    // 尺寸和类型相同时不做任何改变：保留现有存储（外部存储或自有存储）和
+    // 行跨度（ROI 矩阵保留原图的行跨度），dst 与 src 为同一矩阵的原地调用
+    // 按原有跨度访问各行
+    if (rows == rows_ && cols == cols_ && dtype == dtype_ && rows > 0 &&
+        cols > 0)
+      return;
+    detachExternal();
     rows_ = rows;
     cols_ = cols;
     dtype_ = dtype;
@@ -182,7 +283,8 @@ public:
   void release() {
     rows_ = cols_ = 0;
     step_ = 0;
-    data_.clear();
+    decltype(data_)().swap(data_); // 归还内存，而不只是清空
+    detachExternal();
   }
 
   // 填充操作
@@ -191,6 +293,24 @@ public:
     case DataType::UINT8:
       fillValue<uint8_t>(value);
       break;
+    case DataType::INT8:
+      fillValue<int8_t>(value);
+      break;
+    case DataType::UINT16:
+      fillValue<uint16_t>(value);
+      break;
+    case DataType::INT16:
+      fillValue<int16_t>(value);
+      break;
+    case DataType::UINT32:
+      fillValue<uint32_t>(value);
+      break;
+    case DataType::INT32:
+      fillValue<int32_t>(value);
+      break;
+    case DataType::FLOAT16:
+      fillValue<Float16>(value);
+      break;
     case DataType::FLOAT32:
       fillValue<float>(value);
       break;
@@ -206,9 +326,18 @@ public:
   void ones() { setTo(Scalar(1)); }
 
   // 比较操作
+  // 逐行比较元素（两者的行跨度可以不同，不比较行尾的填充字节）
   bool operator==(const Matrix &other) const {
-    return rows_ == other.rows_ && cols_ == other.cols_ &&
-           dtype_ == other.dtype_ && data_ == other.data_;
+    if (rows_ != other.rows_ || cols_ != other.cols_ || dtype_ != other.dtype_)
+      return false;
+    const size_t row_bytes = static_cast<size_t>(cols_) * elemSize();
+    for (int y = 0; y < rows_; ++y) {
+      const uint8_t *a = base() + static_cast<size_t>(y) * step_;
+      if (!std::equal(a, a + row_bytes,
+                      other.base() + static_cast<size_t>(y) * other.step_))
+        return false;
+    }
+    return true;
   }
 
   bool operator!=(const Matrix &other) const { return !(*this == other); }
@@ -244,9 +373,24 @@ private:
     case DataType::UINT8:
       convertToType<SrcT, uint8_t>(dst);
       break;
+    case DataType::INT8:
+      convertToType<SrcT, int8_t>(dst);
+      break;
+    case DataType::UINT16:
+      convertToType<SrcT, uint16_t>(dst);
+      break;
     case DataType::INT16:
       convertToType<SrcT, int16_t>(dst);
       break;
+    case DataType::UINT32:
+      convertToType<SrcT, uint32_t>(dst);
+      break;
+    case DataType::INT32:
+      convertToType<SrcT, int32_t>(dst);
+      break;
+    case DataType::FLOAT16:
+      convertToType<SrcT, Float16>(dst);
+      break;
     case DataType::FLOAT32:
       convertToType<SrcT, float>(dst);
       break;
@@ -262,10 +406,31 @@ private:
   void convertToType(Matrix &dst) const {
     const SrcT *src = ptr<SrcT>();
     DstT *d = dst.ptr<DstT>();
-
     size_t total_elements = total();
-    for (size_t i = 0; i < total_elements; ++i) {
-      d[i] = static_cast<DstT>(src[i]);
+
+    // 常用转换使用运行时选择的SIMD内核（结果与逐元素转换一致）
+    if constexpr (std::is_same_v<SrcT, float> &&
+                  std::is_same_v<DstT, Float16>) {
+      simd::convert_f32_f16(src, reinterpret_cast<uint16_t *>(d),
+                            total_elements);
+    } else if constexpr (std::is_same_v<SrcT, Float16> &&
+                         std::is_same_v<DstT, float>) {
+      simd::convert_f16_f32(reinterpret_cast<const uint16_t *>(src), d,
+                            total_elements);
+    } else if constexpr (std::is_same_v<SrcT, uint8_t> &&
+                         std::is_same_v<DstT, float>) {
+      simd::convert_u8_f32(src, d, total_elements);
+    } else if constexpr (std::is_same_v<SrcT, float> &&
+                         std::is_same_v<DstT, uint8_t>) {
+      simd::convert_f32_u8(src, d, total_elements);
+    } else if constexpr (std::is_same_v<SrcT, Float16>) {
+      for (size_t i = 0; i < total_elements; ++i) {
+        d[i] = static_cast<DstT>(static_cast<float>(src[i]));
+      }
+    } else {
+      for (size_t i = 0; i < total_elements; ++i) {
+        d[i] = static_cast<DstT>(src[i]);
+      }
     }
   }
 
@@ -363,44 +528,22 @@ inline Matrix transpose(const Matrix &src) {
   return result;
 }
 
-// 矩阵相加
-inline Matrix add(const Matrix &a, const Matrix &b) {
-  if (a.size() != b.size() || a.type() != b.type()) {
-    throw std::invalid_argument("Matrix sizes or types don't match");
-  }
-
-  Matrix result(a.rows(), a.cols(), a.type());
+namespace detail {
 
-  switch (a.type()) {
-  case DataType::FLOAT32: {
-    const float *pa = a.ptr<float>();
-    const float *pb = b.ptr<float>();
-    float *pr = result.ptr<float>();
-    size_t total = a.total();
-    for (size_t i = 0; i < total; ++i) {
-      pr[i] = pa[i] + pb[i];
-    }
-    break;
+// 逐元素二元运算，Acc为中间计算类型（FLOAT16按float计算后舍入）
+template <typename T, typename Acc, typename Op>
+void elementwise(const Matrix &a, const Matrix &b, Matrix &result, Op op) {
+  const T *pa = a.ptr<T>();
+  const T *pb = b.ptr<T>();
+  T *pr = result.ptr<T>();
+  size_t total = a.total();
+  for (size_t i = 0; i < total; ++i) {
+    pr[i] = static_cast<T>(op(static_cast<Acc>(pa[i]), static_cast<Acc>(pb[i])));
   }
-  case DataType::FLOAT64: {
-    const double *pa = a.ptr<double>();
-    const double *pb = b.ptr<double>();
-    double *pr = result.ptr<double>();
-    size_t total = a.total();
-    for (size_t i = 0; i < total; ++i) {
-      pr[i] = pa[i] + pb[i];
-    }
-    break;
-  }
-  default:
-    throw std::runtime_error("Unsupported data type for add");
-  }
-
-  return result;
 }
 
-// 矩阵相减
-inline Matrix subtract(const Matrix &a, const Matrix &b) {
+template <typename Op>
+Matrix binaryOp(const Matrix &a, const Matrix &b, Op op, const char *name) {
   if (a.size() != b.size() || a.type() != b.type()) {
     throw std::invalid_argument("Matrix sizes or types don't match");
   }
@@ -408,33 +551,42 @@ inline Matrix subtract(const Matrix &a, const Matrix &b) {
   Matrix result(a.rows(), a.cols(), a.type());
 
   switch (a.type()) {
-  case DataType::FLOAT32: {
-    const float *pa = a.ptr<float>();
-    const float *pb = b.ptr<float>();
-    float *pr = result.ptr<float>();
-    size_t total = a.total();
-    for (size_t i = 0; i < total; ++i) {
-      pr[i] = pa[i] - pb[i];
-    }
+  case DataType::UINT32:
+    elementwise<uint32_t, uint32_t>(a, b, result, op); // 按模2^32回绕
     break;
-  }
-  case DataType::FLOAT64: {
-    const double *pa = a.ptr<double>();
-    const double *pb = b.ptr<double>();
-    double *pr = result.ptr<double>();
-    size_t total = a.total();
-    for (size_t i = 0; i < total; ++i) {
-      pr[i] = pa[i] - pb[i];
-    }
+  case DataType::INT32:
+    elementwise<int32_t, int64_t>(a, b, result, op);
+    break;
+  case DataType::FLOAT16:
+    elementwise<Float16, float>(a, b, result, op);
+    break;
+  case DataType::FLOAT32:
+    elementwise<float, float>(a, b, result, op);
+    break;
+  case DataType::FLOAT64:
+    elementwise<double, double>(a, b, result, op);
     break;
-  }
   default:
-    throw std::runtime_error("Unsupported data type for subtract");
+    throw std::runtime_error(std::string("Unsupported data type for ") + name);
   }
 
   return result;
 }
 
+} // namespace detail
+
+// 矩阵相加
+inline Matrix add(const Matrix &a, const Matrix &b) {
+  return detail::binaryOp(
+      a, b, [](auto x, auto y) { return x + y; }, "add");
+}
+
+// 矩阵相减
+inline Matrix subtract(const Matrix &a, const Matrix &b) {
+  return detail::binaryOp(
+      a, b, [](auto x, auto y) { return x - y; }, "subtract");
+}
+
 } // namespace matrix_ops
 
 } // namespace dip
@@ -0,0 +1,125 @@
+#ifndef CORE_MEMORY_STATS_HPP
+#define CORE_MEMORY_STATS_HPP
+
+// Matrix 内存统计：当前占用、峰值、分配次数和最大单次分配
+// 只有在CMake中开启 DIP_ENABLE_MEMORY_TRACKING 时才生效，此时 Matrix 使用
+// 带统计的分配器；否则 Matrix 使用 std::allocator，下列函数为空实现
+//
+// DIP_MEMORY_SCOPE("name") 将当前线程在作用域内的分配归到该标签下，
+// 释放时按分配时的标签扣除（标签记录在缓冲区头部），未标记的分配归为
+// "untagged"。标签最多 kMaxTags 个，超出的归为 "untagged"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace dip {
+namespace memory {
+
+struct MemoryStats {
+  size_t current_bytes = 0;      // 当前占用
+  size_t peak_bytes = 0;         // 峰值占用
+  size_t allocations = 0;        // 累计分配次数
+  size_t largest_allocation = 0; // 最大单次分配
+};
+
+struct TagStats {
+  std::string tag;
+  MemoryStats stats;
+};
+
+#if defined(DIP_ENABLE_MEMORY_TRACKING)
+
+constexpr int kMaxTags = 64;
+
+namespace detail {
+
+// 当前线程的标签编号（0 为 untagged）
+inline thread_local int current_tag = 0;
+
+// 按名称注册标签，同名标签共享编号
+int register_tag(const char *name);
+
+void *allocate(size_t bytes);
+void deallocate(void *p, size_t bytes);
+
+} // namespace detail
+
+// 作用域标签对象，可嵌套
+class MemoryScope {
+public:
+  explicit MemoryScope(int tag) : previous_(detail::current_tag) {
+    detail::current_tag = tag;
+  }
+  ~MemoryScope() { detail::current_tag = previous_; }
+
+  MemoryScope(const MemoryScope &) = delete;
+  MemoryScope &operator=(const MemoryScope &) = delete;
+
+private:
+  int previous_;
+};
+
+// 带统计的分配器（无状态，所有实例相等）
+template <typename T> struct TrackingAllocator {
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  TrackingAllocator() = default;
+  template <typename U> TrackingAllocator(const TrackingAllocator<U> &) {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(detail::allocate(n * sizeof(T)));
+  }
+  void deallocate(T *p, size_t n) { detail::deallocate(p, n * sizeof(T)); }
+
+  template <typename U> bool operator==(const TrackingAllocator<U> &) const {
+    return true;
+  }
+  template <typename U> bool operator!=(const TrackingAllocator<U> &) const {
+    return false;
+  }
+};
+
+using ByteAllocator = TrackingAllocator<uint8_t>;
+
+constexpr bool compiled_in() { return true; }
+
+// 全部分配的统计
+MemoryStats stats();
+
+// 各标签的统计（只包含有过分配的标签）
+std::vector<TagStats> tag_stats();
+
+// 将总峰值重置为当前占用，用于测量某一阶段的峰值；
+// 各标签的峰值不受影响，始终为进程内的最大值
+void reset_peak();
+
+#define DIP_MEMORY_CONCAT_IMPL(a, b) a##b
+#define DIP_MEMORY_CONCAT(a, b) DIP_MEMORY_CONCAT_IMPL(a, b)
+#define DIP_MEMORY_SCOPE(name)                                                 \
+  static const int DIP_MEMORY_CONCAT(dip_memory_tag_, __LINE__) =              \
+      ::dip::memory::detail::register_tag(name);                               \
+  ::dip::memory::MemoryScope DIP_MEMORY_CONCAT(dip_memory_scope_, __LINE__)(   \
+      DIP_MEMORY_CONCAT(dip_memory_tag_, __LINE__))
+
+#else // DIP_ENABLE_MEMORY_TRACKING
+
+using ByteAllocator = std::allocator<uint8_t>;
+
+constexpr bool compiled_in() { return false; }
+inline MemoryStats stats() { return MemoryStats(); }
+inline std::vector<TagStats> tag_stats() { return {}; }
+inline void reset_peak() {}
+
+#define DIP_MEMORY_SCOPE(name) ((void)0)
+
+#endif // DIP_ENABLE_MEMORY_TRACKING
+
+} // namespace memory
+} // namespace dip
+
+#endif // CORE_MEMORY_STATS_HPP
@@ -0,0 +1,140 @@
+#ifndef CORE_PARALLEL_HPP
+#define CORE_PARALLEL_HPP
+
+#include "task_scheduler.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace dip {
+
+namespace detail {
+
+// 0 表示使用默认值
+inline std::atomic<int> parallel_num_threads{0};
+inline std::atomic<int> parallel_grain_size{0};
+
+// 当前线程是否正在执行某个 parallel_for 的块（调用线程也会执行块）
+inline thread_local bool in_parallel_body = false;
+
+inline int default_num_threads() {
+  // 环境变量 DIP_NUM_THREADS 优先于硬件线程数
+  static const int value = [] {
+    const char *env = std::getenv("DIP_NUM_THREADS");
+    int n = env ? std::atoi(env) : 0;
+    return n > 0 ? n : static_cast<int>(ThreadPool::default_thread_count());
+  }();
+  return value;
+}
+
+} // namespace detail
+
+// 设置并行线程数（含调用线程），0 恢复默认值
+inline void set_num_threads(int num_threads) {
+  detail::parallel_num_threads.store(std::max(0, num_threads));
+}
+
+inline int get_num_threads() {
+  int n = detail::parallel_num_threads.load();
+  return n > 0 ? n : detail::default_num_threads();
+}
+
+// 设置每个任务的最小行数，0 表示自动（约每线程4个任务）
+inline void set_grain_size(int rows) {
+  detail::parallel_grain_size.store(std::max(0, rows));
+}
+
+inline int get_grain_size() { return detail::parallel_grain_size.load(); }
+
+/**
+ * 按行区间并行执行 body(row_begin, row_end)
+ * 区间 [begin, end) 被切分为若干块，由调用线程和全局线程池共同处理
+ * 各块互不重叠，只要 body 对每一行的结果与划分方式无关，输出即与串行一致
+ * 在线程池或任务调度器的工作线程内、或另一个 parallel_for 的块内调用时
+ * （嵌套并行）直接串行执行
+ * @param begin 起始行
+ * @param end 结束行（不含）
+ * @param body 处理函数，参数为行区间
+ * @param grain 每块最小行数（0 使用 set_grain_size 的设置）
+ */
+template <typename Body>
+void parallel_for(int begin, int end, const Body &body, int grain = 0) {
+  if (end <= begin)
+    return;
+
+  const int rows = end - begin;
+  const int threads = get_num_threads();
+  if (grain <= 0)
+    grain = get_grain_size();
+  if (grain <= 0)
+    grain = std::max(1, (rows + threads * 4 - 1) / (threads * 4));
+  const int chunks = (rows + grain - 1) / grain;
+
+  if (threads <= 1 || chunks <= 1 || detail::in_parallel_body ||
+      ThreadPool::is_worker_thread() || TaskScheduler::is_worker_thread()) {
+    body(begin, end);
+    return;
+  }
+
+  struct State {
+    std::atomic<int> next{0};
+    std::atomic<int> done{0};
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::exception_ptr error;
+  };
+  auto state = std::make_shared<State>();
+
+  // 领取并执行块，直到没有剩余；迟到的辅助线程不会再访问 body
+  auto run = [state, &body, begin, end, grain, chunks] {
+    for (;;) {
+      const int c = state->next.fetch_add(1);
+      if (c >= chunks)
+        return;
+
+      const int r0 = begin + c * grain;
+      const int r1 = std::min(end, r0 + grain);
+      try {
+        DIP_TRACE_SCOPE("parallel_for.chunk");
+        detail::in_parallel_body = true;
+        body(r0, r1);
+        detail::in_parallel_body = false;
+      } catch (...) {
+        detail::in_parallel_body = false;
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (!state->error)
+          state->error = std::current_exception();
+      }
+
+      if (state->done.fetch_add(1) + 1 == chunks) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->cv.notify_all();
+      }
+    }
+  };
+
+  const int helpers = std::min(threads, chunks) - 1;
+  ThreadPool &pool = ThreadPool::global();
+  pool.reserve(static_cast<size_t>(helpers));
+  for (int i = 0; i < helpers; ++i) {
+    pool.post(run);
+  }
+
+  // 调用线程也参与计算，因此即使线程池繁忙也不会死锁
+  run();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->cv.wait(lock, [&] { return state->done.load() == chunks; });
+  if (state->error)
+    std::rethrow_exception(state->error);
+}
+
+} // namespace dip
+
+#endif // CORE_PARALLEL_HPP
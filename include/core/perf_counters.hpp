@@ -0,0 +1,90 @@
+#ifndef CORE_PERF_COUNTERS_HPP
+#define CORE_PERF_COUNTERS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dip {
+
+// 硬件性能计数器的一次采样结果，不可用的计数器值为 -1
+struct PerfSample {
+  double seconds = 0;         // 墙钟时间
+  int64_t task_clock_ns = -1; // 所有线程的CPU时间（软件计数器）
+  int64_t cycles = -1;
+  int64_t instructions = -1;
+  int64_t llc_misses = -1; // 末级缓存未命中
+  int64_t branch_misses = -1;
+
+  bool has_hardware() const { return cycles >= 0 || instructions >= 0; }
+
+  // 每周期指令数（不可用时为0）
+  double ipc() const {
+    return cycles > 0 && instructions >= 0
+               ? static_cast<double>(instructions) / cycles
+               : 0.0;
+  }
+
+  // 每像素周期数（不可用时为0）
+  double cycles_per_pixel(double pixels) const {
+    return cycles >= 0 && pixels > 0 ? cycles / pixels : 0.0;
+  }
+
+  double llc_misses_per_pixel(double pixels) const {
+    return llc_misses >= 0 && pixels > 0 ? llc_misses / pixels : 0.0;
+  }
+};
+
+/**
+ * 基于 Linux perf_event_open 的性能计数器
+ * start() 时为进程内所有已存在的线程（含线程池工作线程）打开计数器，
+ * stop() 时汇总，因此并行算法的计数包含全部工作线程
+ * 计数器设置了 inherit，start() 之后由这些线程创建的线程（如首次并行
+ * 调用时才启动的线程池）也计入；start() 枚举线程期间恰好正在创建的
+ * 线程可能不计入
+ * 计数器被复用（multiplexing）时按启用/运行时间比例缩放
+ * 内核不支持、权限不足（perf_event_paranoid）或虚拟机未暴露PMU时，
+ * 对应计数器为 -1，不影响被测代码运行
+ */
+class PerfCounters {
+private:
+  std::vector<int> fds_;
+  std::vector<int> events_; // 每个fd对应的计数器编号
+  std::string error_;
+  std::chrono::steady_clock::time_point start_time_;
+  bool running_ = false;
+
+  void close_all();
+
+public:
+  PerfCounters() = default;
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  // 开始计数；返回是否有任何计数器可用
+  bool start();
+
+  // 停止计数并返回结果
+  PerfSample stop();
+
+  // 最近一次 start() 中打开计数器失败的原因（全部成功时为空）
+  const std::string &error() const { return error_; }
+
+  // 当前系统是否能打开硬件计数器（结果缓存）
+  static bool hardware_available();
+};
+
+// 测量一次调用的性能计数
+template <typename F> PerfSample measure_perf(F &&f) {
+  PerfCounters counters;
+  counters.start();
+  f();
+  return counters.stop();
+}
+
+} // namespace dip
+
+#endif // CORE_PERF_COUNTERS_HPP
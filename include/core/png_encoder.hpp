@@ -0,0 +1,29 @@
+#ifndef CORE_PNG_ENCODER_HPP
+#define CORE_PNG_ENCODER_HPP
+
+#include "image.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace dip {
+
+// PNG编码参数
+struct PngOptions {
+  int compression_level = 6; // 0..9，0 为不压缩（stored 块）
+  int strip_rows = 0;        // 每个条带的行数，0 按约1MB自动选择
+};
+
+/**
+ * 将图像编码为PNG文件内容，结果写入 out（替换原有内容）
+ * 支持 UINT8/UINT16，1-4 通道（灰度、灰度+Alpha、RGB、RGBA）
+ * 图像按行分为条带，各条带的行滤波和deflate压缩由 parallel_for 并行执行，
+ * 压缩结果以同步刷新拼接为一个zlib流（条带之间不共享字典），
+ * 校验和由各条带的 Adler-32 合并得到。输出与线程数无关
+ * @throws std::invalid_argument 图像为空或类型、通道数不支持
+ */
+void encode_png(const Image &image, std::vector<uint8_t> &out,
+                const PngOptions &options = PngOptions());
+
+} // namespace dip
+
+#endif // CORE_PNG_ENCODER_HPP
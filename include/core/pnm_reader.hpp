@@ -0,0 +1,111 @@
+#ifndef CORE_PNM_READER_HPP
+#define CORE_PNM_READER_HPP
+
+#include "image.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace dip {
+
+// 二进制PNM（P5灰度 / P6彩色）文件头
+struct PnmHeader {
+  int width = 0;
+  int height = 0;
+  int channels = 0;      // P5 为1，P6 为3
+  int maxval = 0;        // 1..65535，大于255时每个样本为2字节大端
+  size_t data_offset = 0; // 像素数据在文件中的偏移
+
+  DataType type() const {
+    return maxval > 255 ? DataType::UINT16 : DataType::UINT8;
+  }
+  size_t sample_bytes() const { return maxval > 255 ? 2 : 1; }
+  size_t row_bytes() const {
+    return static_cast<size_t>(width) * channels * sample_bytes();
+  }
+};
+
+/**
+ * 基于内存映射的二进制PNM读取器
+ * 打开时只解析文件头并映射文件（MAP_PRIVATE），像素数据由页缓存按需读入
+ * - image()：8位文件直接返回引用映射内存的图像（零拷贝，写入时写时复制，
+ *   不会修改文件）；16位文件转换为本机字节序的 UINT16 图像
+ * - row_data()/read_rows()：按行流式访问，处理大文件时无需整幅载入
+ * 返回的图像持有映射的引用，读取器关闭或析构后仍然有效
+ *
+ * 注意：映射不是快照。图像存活期间文件被改写，像素会随之改变；文件被截断
+ * 后访问超出部分的页会触发 SIGBUS。不能保证文件不变时使用 read_pnm()
+ */
+class PnmReader {
+public:
+  struct Mapping; // 映射的文件（实现细节）
+
+  PnmReader() = default;
+  ~PnmReader() = default;
+
+  PnmReader(const PnmReader &) = delete;
+  PnmReader &operator=(const PnmReader &) = delete;
+  PnmReader(PnmReader &&) = default;
+  PnmReader &operator=(PnmReader &&) = default;
+
+  // 打开文件；失败时返回 false，原因见 error()
+  bool open(const std::string &path);
+  void close();
+
+  bool is_open() const { return mapping_ != nullptr; }
+  const std::string &error() const { return error_; }
+
+  const PnmHeader &header() const { return header_; }
+  int width() const { return header_.width; }
+  int height() const { return header_.height; }
+  int channels() const { return header_.channels; }
+  DataType type() const { return header_.type(); }
+
+  // 第 y 行在文件中的原始字节（16位样本为大端字节序）
+  const uint8_t *row_data(int y) const;
+
+  // 读取 [y0, y0 + count) 行到 dst（16位转换为本机字节序），dst 尺寸匹配时
+  // 复用其缓冲区
+  void read_rows(int y0, int count, Image &dst) const;
+
+  // 整幅图像，见类说明
+  Image image() const;
+
+  // [y0, y0 + count) 行的图像：8位文件直接引用映射内存（零拷贝），
+  // 16位文件同 read_rows
+  Image view_rows(int y0, int count) const;
+
+  // 提示内核丢弃 [y0, y0 + count) 行占用的页（流式处理完一段后调用，
+  // 限制常驻内存）；之后再访问这些行会重新从文件读入，对这些行的修改
+  // （写时复制的页）会丢失
+  void release_rows(int y0, int count) const;
+
+  // 提示内核按顺序预读（流式逐行读取时调用）
+  void advise_sequential() const;
+
+private:
+  std::shared_ptr<Mapping> mapping_;
+  PnmHeader header_;
+  std::string error_;
+};
+
+// 解析PNM文件头；data 不是有效的P5/P6文件头时返回 false
+bool parse_pnm_header(const uint8_t *data, size_t size, PnmHeader &header,
+                      std::string *error = nullptr);
+
+// 只读取文件头；失败时返回 false，error 不为空时写入原因
+bool read_pnm_header(const std::string &path, PnmHeader &header,
+                     std::string *error = nullptr);
+
+/**
+ * 将二进制PNM文件整体读入 dst 自有的缓冲区（16位转换为本机字节序），
+ * 不保留对文件的引用；dst 尺寸和类型匹配时复用其缓冲区
+ * @return 失败时返回 false，error 不为空时写入原因
+ */
+bool read_pnm(const std::string &path, Image &dst,
+              std::string *error = nullptr);
+
+} // namespace dip
+
+#endif // CORE_PNM_READER_HPP
@@ -0,0 +1,42 @@
+#ifndef CORE_SIMD_HPP
+#define CORE_SIMD_HPP
+
+#include "cpu_features.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace dip {
+namespace simd {
+
+// 连续数组上的向量化内核，按 cpu_level() 在运行时选择实现
+// 各级别的结果与标量实现逐位一致
+
+// dst[i] = uint8(k - src[i])（按256取模，与 static_cast<uint8_t> 一致）
+void subtract_from(const uint8_t *src, uint8_t *dst, size_t n, int k);
+
+// 均匀量化：dst[i] = uint8((src[i] / step) * step + step / 2)，step 为 1..256
+void quantize(const uint8_t *src, uint8_t *dst, size_t n, int step);
+
+// 二值图逻辑运算：dst[i] = (a[i] == 1 && b[i] == 1)
+void binary_and(const uint8_t *a, const uint8_t *b, uint8_t *dst, size_t n);
+
+// 二值图逻辑运算：dst[i] = (a[i] != b[i])
+void binary_xor(const uint8_t *a, const uint8_t *b, uint8_t *dst, size_t n);
+
+// acc[i] += src[i]（下采样按行累加）
+void accumulate(const uint8_t *src, uint32_t *acc, size_t n);
+
+// 类型转换：uint8 -> float
+void convert_u8_f32(const uint8_t *src, float *dst, size_t n);
+
+// 类型转换：float -> uint8（截断取低8位，与 static_cast<uint8_t> 一致）
+void convert_f32_u8(const float *src, uint8_t *dst, size_t n);
+
+// 半精度转换（AVX2及以上使用F16C）
+void convert_f16_f32(const uint16_t *src, float *dst, size_t n);
+void convert_f32_f16(const float *src, uint16_t *dst, size_t n);
+
+} // namespace simd
+} // namespace dip
+
+#endif // CORE_SIMD_HPP
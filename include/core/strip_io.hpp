@@ -0,0 +1,134 @@
+#ifndef CORE_STRIP_IO_HPP
+#define CORE_STRIP_IO_HPP
+
+// 按行带流式读写二进制PNM，处理无法整幅载入内存的大图像
+// 内存占用只与行带大小有关，与图像高度无关
+
+#include "atomic_file.hpp"
+#include "image.hpp"
+#include "pnm_reader.hpp"
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace dip {
+
+// 一个行带：核心行 [y, y + rows) 以及上下各若干 halo 行
+struct Band {
+  Image image;         // 像素（包含 halo 行），第一行为 image_y()
+  int y = 0;           // 核心行在整幅图像中的起始行
+  int rows = 0;        // 核心行数
+  int halo_top = 0;    // 核心行之前的行数（在图像上边界处被裁剪）
+  int halo_bottom = 0; // 核心行之后的行数（在图像下边界处被裁剪）
+
+  int image_y() const { return y - halo_top; }
+};
+
+/**
+ * 按行带读取二进制PNM（P5/P6，8位或16位）
+ * 每个行带拷贝到 Band::image（尺寸不变时复用缓冲区），可以就地修改；
+ * 顺序读取时已读过的页会被释放，常驻内存约为一个行带
+ *
+ * 用法：
+ *   StripReader reader;
+ *   reader.open("scan.pgm", 256, 1);
+ *   Band band;
+ *   while (reader.next(band)) { ... }
+ */
+class StripReader {
+public:
+  StripReader() = default;
+
+  /**
+   * @param band_rows 每个行带的核心行数（>=1）
+   * @param halo 核心行上下各附带的行数（邻域运算使用）
+   * @return 失败时返回 false，原因见 error()
+   */
+  bool open(const std::string &path, int band_rows, int halo = 0);
+  void close();
+
+  bool is_open() const { return reader_.is_open(); }
+  const std::string &error() const { return error_; }
+
+  int width() const { return reader_.width(); }
+  int height() const { return reader_.height(); }
+  int channels() const { return reader_.channels(); }
+  DataType type() const { return reader_.type(); }
+  int band_rows() const { return band_rows_; }
+  int halo() const { return halo_; }
+
+  // 依次读取下一个行带，已读完时返回 false
+  bool next(Band &band);
+
+  // 回到第一个行带
+  void rewind() { next_y_ = 0; }
+
+  // 读取核心行为 [y, y + rows) 的行带（越界部分被裁剪），可随机访问
+  void read_band(int y, int rows, Band &band);
+
+private:
+  PnmReader reader_;
+  std::string error_;
+  int band_rows_ = 0;
+  int halo_ = 0;
+  int next_y_ = 0;
+  int released_y_ = 0; // 此行之前的页已释放
+};
+
+/**
+ * 按行增量写入二进制PNM（P5/P6）
+ * 打开时写入文件头，之后按顺序追加行；UINT16 图像写为 maxval 65535
+ * 写入临时文件，close() 时全部行都已写入才替换目标文件（见 AtomicFile），
+ * 因此输出路径可以与正在流式读取的输入相同
+ */
+class StripWriter {
+public:
+  StripWriter() = default;
+  ~StripWriter() { close(); }
+
+  StripWriter(const StripWriter &) = delete;
+  StripWriter &operator=(const StripWriter &) = delete;
+
+  /**
+   * @param channels 1（P5）或 3（P6）
+   * @param type UINT8 或 UINT16
+   * @return 失败时返回 false，原因见 error()
+   */
+  bool open(const std::string &path, int width, int height, int channels,
+            DataType type = DataType::UINT8);
+
+  /**
+   * 追加 rows 的第 [y0, y0 + count) 行（count 为负时到最后一行）
+   * @throws std::invalid_argument 宽度、通道数或类型不匹配，或超出图像高度
+   * @throws std::runtime_error 未打开或写入失败
+   */
+  void write(const Image &rows, int y0 = 0, int count = -1);
+
+  // 追加行带的核心行
+  void write(const Band &band) {
+    write(band.image, band.halo_top, band.rows);
+  }
+
+  // 关闭文件；写入的行数不等于图像高度或写入出错时返回 false，
+  // 此时目标文件保持不变
+  bool close();
+
+  bool is_open() const { return file_.is_open(); }
+  const std::string &error() const { return error_; }
+  int rows_written() const { return rows_written_; }
+
+private:
+  AtomicFile target_;
+  std::ofstream file_;
+  std::string error_;
+  std::vector<uint8_t> buffer_; // 16位样本转换为大端字节序
+  int width_ = 0;
+  int height_ = 0;
+  int channels_ = 0;
+  DataType type_ = DataType::UINT8;
+  int rows_written_ = 0;
+};
+
+} // namespace dip
+
+#endif // CORE_STRIP_IO_HPP
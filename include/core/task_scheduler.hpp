@@ -0,0 +1,346 @@
+#ifndef CORE_TASK_SCHEDULER_HPP
+#define CORE_TASK_SCHEDULER_HPP
+
+#include "thread_pool.hpp"
+#include "trace.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace dip {
+
+namespace detail {
+
+// 任务图中的节点
+struct TaskNode {
+  std::function<void()> fn;
+  // 未完成的前驱数量（另加1作为提交保护，注册完依赖后释放）
+  std::atomic<int> pending{1};
+  std::atomic<bool> done{false};
+  std::exception_ptr error;
+  std::mutex mutex;
+  std::condition_variable cv;
+  // 依赖本任务的后继任务（continuation）
+  std::vector<std::shared_ptr<TaskNode>> continuations;
+};
+
+} // namespace detail
+
+// 任务句柄，用于声明依赖和等待完成
+class TaskHandle {
+private:
+  std::shared_ptr<detail::TaskNode> node_;
+
+  friend class TaskScheduler;
+  explicit TaskHandle(std::shared_ptr<detail::TaskNode> node)
+      : node_(std::move(node)) {}
+
+public:
+  TaskHandle() = default;
+
+  bool valid() const { return node_ != nullptr; }
+  bool done() const { return node_ && node_->done.load(); }
+};
+
+/**
+ * 工作窃取任务调度器
+ * 每个工作线程拥有独立的双端队列：本线程从尾部取任务（LIFO，缓存友好），
+ * 空闲线程从其他线程队列头部窃取（FIFO，窃取较早、通常较大的任务）
+ * 任务可声明依赖，所有前驱完成后才会就绪；完成时就绪的第一个后继
+ * 由当前线程直接执行，其余放入本线程队列供其他线程窃取
+ * 前驱抛出的异常会传递给所有后继（后继不再执行），在 wait() 时重新抛出
+ */
+class TaskScheduler {
+private:
+  using NodePtr = std::shared_ptr<detail::TaskNode>;
+
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<NodePtr> tasks;
+  };
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  // 外部线程提交的任务
+  WorkerQueue inject_;
+
+  // 队列中任务总数，用于空闲线程休眠/唤醒
+  std::atomic<int> queued_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+  bool stop_ = false;
+
+  // 已提交但尚未完成的任务数
+  std::atomic<int> outstanding_{0};
+  std::mutex idle_mutex_;
+  std::condition_variable idle_cv_;
+
+  struct WorkerContext {
+    TaskScheduler *scheduler = nullptr;
+    size_t index = 0;
+  };
+
+  static WorkerContext &context() {
+    static thread_local WorkerContext ctx;
+    return ctx;
+  }
+
+  bool on_own_worker() const { return context().scheduler == this; }
+
+  void push(NodePtr node) {
+    WorkerQueue &queue =
+        on_own_worker() ? *queues_[context().index] : inject_;
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.push_back(std::move(node));
+    }
+    queued_.fetch_add(1);
+    {
+      // 持锁通知，避免与工作线程检查条件之间丢失唤醒
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    sleep_cv_.notify_one();
+  }
+
+  // 依次尝试：本线程队列尾部、外部提交队列、其他线程队列头部
+  NodePtr find_task() {
+    const size_t n = queues_.size();
+    const bool own = on_own_worker();
+    const size_t self = own ? context().index : 0;
+
+    if (own) {
+      WorkerQueue &queue = *queues_[self];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.tasks.empty()) {
+        NodePtr node = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        queued_.fetch_sub(1);
+        return node;
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(inject_.mutex);
+      if (!inject_.tasks.empty()) {
+        NodePtr node = std::move(inject_.tasks.front());
+        inject_.tasks.pop_front();
+        queued_.fetch_sub(1);
+        return node;
+      }
+    }
+
+    for (size_t i = 1; i <= n; ++i) {
+      const size_t victim = (self + i) % n;
+      if (own && victim == self)
+        continue;
+      WorkerQueue &queue = *queues_[victim];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.tasks.empty()) {
+        NodePtr node = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        queued_.fetch_sub(1);
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  // 执行任务，并沿就绪的后继链继续执行
+  void execute(NodePtr node) {
+    while (node) {
+      if (!node->error) {
+        try {
+          DIP_TRACE_SCOPE("task");
+          node->fn();
+        } catch (...) {
+          node->error = std::current_exception();
+        }
+      }
+      node->fn = nullptr; // 尽早释放任务捕获的资源
+
+      std::vector<NodePtr> continuations;
+      {
+        std::lock_guard<std::mutex> lock(node->mutex);
+        node->done.store(true);
+        continuations.swap(node->continuations);
+      }
+      node->cv.notify_all();
+
+      NodePtr next;
+      for (auto &cont : continuations) {
+        if (node->error) {
+          std::lock_guard<std::mutex> lock(cont->mutex);
+          if (!cont->error)
+            cont->error = node->error;
+        }
+        if (cont->pending.fetch_sub(1) == 1) {
+          if (!next)
+            next = std::move(cont);
+          else
+            push(std::move(cont));
+        }
+      }
+
+      if (outstanding_.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        idle_cv_.notify_all();
+      }
+      node = std::move(next);
+    }
+  }
+
+  void worker_loop(size_t index) {
+    context().scheduler = this;
+    context().index = index;
+    for (;;) {
+      if (NodePtr node = find_task()) {
+        execute(std::move(node));
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      sleep_cv_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+      if (stop_ && queued_.load() == 0)
+        return;
+    }
+  }
+
+public:
+  explicit TaskScheduler(
+      size_t num_threads = ThreadPool::default_thread_count()) {
+    num_threads = std::max<size_t>(1, num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+      queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i = 0; i < num_threads; ++i) {
+      workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+  }
+
+  // 等待所有已提交任务完成后退出
+  ~TaskScheduler() {
+    wait_all();
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stop_ = true;
+    }
+    sleep_cv_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  TaskScheduler(const TaskScheduler &) = delete;
+  TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+  /**
+   * 提交任务
+   * @param fn 任务函数
+   * @param deps 前驱任务，全部完成后才执行 fn（无效句柄被忽略）
+   * @return 任务句柄
+   */
+  TaskHandle spawn(std::function<void()> fn,
+                   const std::vector<TaskHandle> &deps = {}) {
+    auto node = std::make_shared<detail::TaskNode>();
+    node->fn = std::move(fn);
+    node->pending.store(1 + static_cast<int>(deps.size()));
+    outstanding_.fetch_add(1);
+
+    for (const auto &dep : deps) {
+      const NodePtr &pre = dep.node_;
+      bool registered = false;
+      std::exception_ptr error;
+      if (pre) {
+        std::lock_guard<std::mutex> lock(pre->mutex);
+        if (!pre->done.load()) {
+          pre->continuations.push_back(node);
+          registered = true;
+        } else {
+          error = pre->error;
+        }
+      }
+      if (error) {
+        std::lock_guard<std::mutex> lock(node->mutex);
+        if (!node->error)
+          node->error = error;
+      }
+      if (!registered)
+        node->pending.fetch_sub(1);
+    }
+
+    // 释放提交保护；若依赖均已完成则立即就绪
+    if (node->pending.fetch_sub(1) == 1)
+      push(node);
+    return TaskHandle(node);
+  }
+
+  TaskHandle spawn(std::function<void()> fn,
+                   std::initializer_list<TaskHandle> deps) {
+    return spawn(std::move(fn), std::vector<TaskHandle>(deps));
+  }
+
+  // 在 task 完成后执行 fn
+  TaskHandle then(const TaskHandle &task, std::function<void()> fn) {
+    return spawn(std::move(fn), {task});
+  }
+
+  /**
+   * 等待任务完成，任务（或其前驱）抛出的异常在此重新抛出
+   * 在工作线程中调用时，等待期间会执行其他任务而不是阻塞
+   */
+  void wait(const TaskHandle &task) {
+    const NodePtr &node = task.node_;
+    if (!node)
+      return;
+
+    if (on_own_worker()) {
+      while (!node->done.load()) {
+        if (NodePtr other = find_task()) {
+          execute(std::move(other));
+        } else {
+          std::unique_lock<std::mutex> lock(node->mutex);
+          node->cv.wait_for(lock, std::chrono::microseconds(100),
+                            [&] { return node->done.load(); });
+        }
+      }
+    } else {
+      std::unique_lock<std::mutex> lock(node->mutex);
+      node->cv.wait(lock, [&] { return node->done.load(); });
+    }
+
+    if (node->error)
+      std::rethrow_exception(node->error);
+  }
+
+  // 等待所有已提交任务完成（不能在任务内部调用）
+  void wait_all() {
+    if (on_own_worker())
+      throw std::logic_error("TaskScheduler::wait_all called from a task");
+    std::unique_lock<std::mutex> lock(idle_mutex_);
+    idle_cv_.wait(lock, [this] { return outstanding_.load() == 0; });
+  }
+
+  size_t size() const { return workers_.size(); }
+
+  // 当前线程是否为某个调度器的工作线程
+  static bool is_worker_thread() { return context().scheduler != nullptr; }
+
+  // 进程级共享调度器（首次使用时创建）
+  static TaskScheduler &global() {
+    static TaskScheduler scheduler;
+    return scheduler;
+  }
+};
+
+} // namespace dip
+
+#endif // CORE_TASK_SCHEDULER_HPP
@@ -0,0 +1,128 @@
+#ifndef CORE_THREAD_POOL_HPP
+#define CORE_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace dip {
+
+// 常驻线程池（FIFO任务队列）
+class ThreadPool {
+private:
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_;
+
+  static bool &worker_flag() {
+    static thread_local bool is_worker = false;
+    return is_worker;
+  }
+
+  void worker_loop() {
+    worker_flag() = true;
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+        if (stop_ && tasks_.empty())
+          return;
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+public:
+  explicit ThreadPool(size_t num_threads = default_thread_count())
+      : stop_(false) {
+    reserve(std::max<size_t>(1, num_threads));
+  }
+
+  // 等待队列中已提交的任务全部完成后退出
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // 确保至少有 num_threads 个工作线程（只增不减）
+  void reserve(size_t num_threads) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (workers_.size() < num_threads) {
+      workers_.emplace_back([this] { worker_loop(); });
+    }
+  }
+
+  // 提交无返回值的任务（不创建future，任务不应抛出异常）
+  void post(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.emplace_back(std::move(task));
+    }
+    cv_.notify_one();
+  }
+
+  // 提交任务，返回可等待结果（任务抛出的异常通过future传递）
+  template <typename F>
+  auto submit(F &&f) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+    using R = std::invoke_result_t<std::decay_t<F>>;
+    auto task =
+        std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+    std::future<R> result = task->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.emplace_back([task] { (*task)(); });
+    }
+    cv_.notify_one();
+    return result;
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return workers_.size();
+  }
+
+  // 当前线程是否为某个线程池的工作线程
+  static bool is_worker_thread() { return worker_flag(); }
+
+  static size_t default_thread_count() {
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // 进程级共享线程池（首次使用时创建）
+  static ThreadPool &global() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  // 进程级I/O线程池，用于文件读写和编解码
+  // 与计算线程池分开，阻塞在磁盘上的任务不会占用 parallel_for 的线程
+  static ThreadPool &io() {
+    static ThreadPool pool(std::max<size_t>(2, default_thread_count()));
+    return pool;
+  }
+};
+
+} // namespace dip
+
+#endif // CORE_THREAD_POOL_HPP
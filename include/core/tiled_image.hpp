@@ -0,0 +1,148 @@
+#ifndef CORE_TILED_IMAGE_HPP
+#define CORE_TILED_IMAGE_HPP
+
+#include "image.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace dip {
+
+// 分块缓存的统计
+struct TileCacheStats {
+  size_t hits = 0;
+  size_t misses = 0;      // 即从文件读取的分块数
+  size_t evictions = 0;
+  size_t bytes = 0;       // 当前缓存的字节数
+  size_t peak_bytes = 0;
+
+  double hit_rate() const {
+    const size_t total = hits + misses;
+    return total > 0 ? static_cast<double>(hits) / total : 0.0;
+  }
+};
+
+/**
+ * 分块存储、按需加载的大图像
+ * 图像以固定大小的分块保存在分块文件中（按分块行优先排列，边缘分块补零
+ * 到完整大小），访问时才读取所需的分块，放入按字节上限淘汰的LRU缓存
+ * 用于超大图像的随机浏览和ROI分析，内存占用由缓存上限决定
+ *
+ * 用法：
+ *   TiledImage::build_from_pnm("scan.pgm", "scan.tiles", 256);
+ *   TiledImage tiled;
+ *   tiled.open("scan.tiles", size_t(512) << 20);
+ *   Image view = tiled.roi(Rect(x, y, 1024, 768));
+ *
+ * 所有读取接口都是线程安全的
+ */
+class TiledImage {
+public:
+  TiledImage() = default;
+  ~TiledImage() { close(); }
+
+  TiledImage(const TiledImage &) = delete;
+  TiledImage &operator=(const TiledImage &) = delete;
+
+  /**
+   * 由图像生成分块文件
+   * @param tile_size 分块边长（像素）
+   * @return 失败时返回 false，error 不为空时写入原因
+   */
+  static bool build(const Image &image, const std::string &store_path,
+                    int tile_size = 256, std::string *error = nullptr);
+
+  // 由二进制PNM文件按行带流式生成分块文件，不载入整幅图像
+  static bool build_from_pnm(const std::string &pnm_path,
+                             const std::string &store_path,
+                             int tile_size = 256,
+                             std::string *error = nullptr);
+
+  /**
+   * 打开分块文件
+   * @param cache_bytes 分块缓存的字节上限
+   * @return 失败时返回 false，原因见 error()
+   */
+  bool open(const std::string &store_path,
+            size_t cache_bytes = size_t(256) << 20);
+  void close();
+
+  bool is_open() const { return file_ != nullptr; }
+  const std::string &error() const { return error_; }
+
+  int width() const { return width_; }
+  int height() const { return height_; }
+  int channels() const { return channels_; }
+  DataType type() const { return type_; }
+  Size size() const { return Size(width_, height_); }
+  int tile_width() const { return tile_width_; }
+  int tile_height() const { return tile_height_; }
+  int tiles_x() const { return tiles_x_; }
+  int tiles_y() const { return tiles_y_; }
+
+  // 分块 (tx, ty) 的像素（完整分块大小，边缘分块的越界部分为0）
+  // @throws std::out_of_range 分块索引越界
+  // @throws std::runtime_error 读取失败
+  std::shared_ptr<const Image> tile(int tx, int ty) const;
+
+  /**
+   * 提取ROI（像素坐标，与 Image::roi / Image::pixel_roi 相同），只读取
+   * 与区域相交的分块；结果的行紧密排列
+   * @throws std::invalid_argument 区域超出图像范围
+   */
+  Image roi(const Rect &region) const;
+  Image pixel_roi(const Rect &region) const { return roi(region); }
+
+  // 同上，结果写入 dst；dst 的尺寸和类型匹配时复用其缓冲区
+  void roi(const Rect &region, Image &dst) const;
+
+  // 单个像素（经过分块缓存）
+  template <typename T> T at(int y, int x, int c = 0) const {
+    const auto t = tile(x / tile_width_, y / tile_height_);
+    return t->at<T>(y % tile_height_, x % tile_width_, c);
+  }
+
+  // 缓存设置与统计
+  void set_cache_budget(size_t bytes);
+  size_t cache_budget() const;
+  TileCacheStats cache_stats() const;
+  void clear_cache();
+
+private:
+  struct File; // 打开的分块文件（实现细节）
+
+  struct CacheEntry {
+    std::shared_ptr<const Image> tile;
+    std::list<int64_t>::iterator lru; // 在 lru_ 中的位置
+  };
+
+  std::shared_ptr<const Image> load_tile(int tx, int ty) const;
+  void evict_locked() const;
+
+  std::shared_ptr<File> file_;
+  std::string error_;
+  int width_ = 0;
+  int height_ = 0;
+  int channels_ = 0;
+  DataType type_ = DataType::UINT8;
+  int tile_width_ = 0;
+  int tile_height_ = 0;
+  int tiles_x_ = 0;
+  int tiles_y_ = 0;
+  uint64_t data_offset_ = 0;
+  size_t tile_bytes_ = 0;
+
+  mutable std::mutex mutex_;
+  size_t budget_ = 0;
+  mutable std::list<int64_t> lru_; // 最近使用的分块在前
+  mutable std::unordered_map<int64_t, CacheEntry> cache_;
+  mutable TileCacheStats stats_;
+};
+
+} // namespace dip
+
+#endif // CORE_TILED_IMAGE_HPP
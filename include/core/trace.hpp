@@ -0,0 +1,153 @@
+#ifndef CORE_TRACE_HPP
+#define CORE_TRACE_HPP
+
+// 作用域追踪：DIP_TRACE_SCOPE("name") 记录所在作用域的开始时间和耗时
+// 只有在CMake中开启 DIP_ENABLE_TRACING 时才生效，否则宏展开为空，
+// 下列函数为空实现，不产生任何开销
+//
+// 事件写入每个线程独立的环形缓冲区（仅本线程写入，无锁），缓冲区满后
+// 覆盖最旧的事件；可导出为Chrome trace-event JSON，在 chrome://tracing
+// 或 Perfetto 中查看。设置环境变量 DIP_TRACE_FILE 时进程退出前自动导出
+
+#include <cstddef>
+#include <string>
+
+#if defined(DIP_ENABLE_TRACING)
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#endif
+
+namespace dip {
+namespace trace {
+
+#if defined(DIP_ENABLE_TRACING)
+
+struct TraceEvent {
+  const char *name;     // 必须是静态存储期的字符串（如字面量）
+  uint64_t start_ns;    // 相对于追踪起点
+  uint64_t duration_ns; // 持续时间
+};
+
+// 单线程写入的环形缓冲区
+class TraceBuffer {
+public:
+  static constexpr size_t kCapacity = size_t(1) << 16;
+
+  explicit TraceBuffer(uint32_t tid)
+      : events_(new TraceEvent[kCapacity]), tid_(tid) {}
+
+  void push(const TraceEvent &event) {
+    const uint64_t h = head_.load(std::memory_order_relaxed);
+    events_[h & (kCapacity - 1)] = event;
+    head_.store(h + 1, std::memory_order_release);
+  }
+
+  uint64_t head() const { return head_.load(std::memory_order_acquire); }
+  const TraceEvent &at(uint64_t i) const {
+    return events_[i & (kCapacity - 1)];
+  }
+  void reset() { head_.store(0, std::memory_order_release); }
+  uint32_t tid() const { return tid_; }
+
+private:
+  std::unique_ptr<TraceEvent[]> events_;
+  std::atomic<uint64_t> head_{0};
+  uint32_t tid_;
+};
+
+namespace detail {
+
+inline std::atomic<bool> trace_enabled{true};
+
+// 注册当前线程的缓冲区（每个线程首次记录事件时调用一次）
+TraceBuffer *register_thread();
+
+inline TraceBuffer *thread_buffer() {
+  static thread_local TraceBuffer *buffer = register_thread();
+  return buffer;
+}
+
+inline uint64_t now_ns() {
+  static const auto epoch = std::chrono::steady_clock::now();
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - epoch)
+          .count());
+}
+
+} // namespace detail
+
+// 作用域追踪对象
+class TraceScope {
+public:
+  explicit TraceScope(const char *name) : name_(nullptr), start_(0) {
+    if (detail::trace_enabled.load(std::memory_order_relaxed)) {
+      name_ = name;
+      start_ = detail::now_ns();
+    }
+  }
+
+  ~TraceScope() {
+    if (name_) {
+      const uint64_t end = detail::now_ns();
+      detail::thread_buffer()->push({name_, start_, end - start_});
+    }
+  }
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+  const char *name_;
+  uint64_t start_;
+};
+
+constexpr bool compiled_in() { return true; }
+
+// 暂停/恢复记录（默认记录）
+inline void set_enabled(bool enabled) {
+  detail::trace_enabled.store(enabled, std::memory_order_relaxed);
+}
+inline bool enabled() {
+  return detail::trace_enabled.load(std::memory_order_relaxed);
+}
+
+// 为当前线程设置显示名称
+void set_thread_name(const std::string &name);
+
+// 清空所有线程已记录的事件（应在没有线程正在记录时调用）
+void clear();
+
+// 当前缓冲区中的事件总数
+size_t event_count();
+
+// 导出为Chrome trace-event JSON（应在没有线程正在记录时调用）
+std::string chrome_trace_json();
+bool write_chrome_trace(const std::string &path);
+
+#define DIP_TRACE_CONCAT_IMPL(a, b) a##b
+#define DIP_TRACE_CONCAT(a, b) DIP_TRACE_CONCAT_IMPL(a, b)
+#define DIP_TRACE_SCOPE(name)                                                  \
+  ::dip::trace::TraceScope DIP_TRACE_CONCAT(dip_trace_scope_, __LINE__)(name)
+
+#else // DIP_ENABLE_TRACING
+
+constexpr bool compiled_in() { return false; }
+inline void set_enabled(bool) {}
+inline bool enabled() { return false; }
+inline void set_thread_name(const std::string &) {}
+inline void clear() {}
+inline size_t event_count() { return 0; }
+inline std::string chrome_trace_json() { return std::string(); }
+inline bool write_chrome_trace(const std::string &) { return false; }
+
+#define DIP_TRACE_SCOPE(name) ((void)0)
+
+#endif // DIP_ENABLE_TRACING
+
+} // namespace trace
+} // namespace dip
+
+#endif // CORE_TRACE_HPP
@@ -0,0 +1,166 @@
+#include <algorithms/batch.hpp>
+#include <algorithms/bilinear_zoom.hpp>
+#include <algorithms/downsample.hpp>
+#include <algorithms/nearest_neighbor_zoom.hpp>
+#include <algorithms/quantize.hpp>
+#include <algorithms/rotate.hpp>
+#include <algorithms/set_logical_ops.hpp>
+#include <algorithms/spatial_ops.hpp>
+#include <stdexcept>
+
+namespace dip {
+
+namespace {
+
+// 逐对运算：每次领取一对图像
+template <typename Op>
+std::vector<Image> pairwise(const char *name,
+                            const std::vector<Image> &images1,
+                            const std::vector<Image> &images2, const Op &op) {
+  if (images1.size() != images2.size()) {
+    throw std::invalid_argument(std::string(name) +
+                                " requires batches of equal size");
+  }
+  std::vector<Image> outputs(images1.size());
+  parallel_for(
+      0, static_cast<int>(images1.size()),
+      [&](int i0, int i1) {
+        for (int i = i0; i < i1; ++i) {
+          op(images1[i], images2[i], outputs[i]);
+        }
+      },
+      1);
+  return outputs;
+}
+
+} // namespace
+
+namespace algorithms {
+
+void quantize_batch(const std::vector<Image> &images, int levels,
+                    std::vector<Image> &outputs) {
+  DIP_TRACE_SCOPE("quantize_batch");
+  batch_apply(images, outputs, [levels](const Image &src, Image &dst) {
+    quantize(src, levels, dst);
+  });
+}
+
+std::vector<Image> quantize_batch(const std::vector<Image> &images,
+                                  int levels) {
+  std::vector<Image> outputs;
+  quantize_batch(images, levels, outputs);
+  return outputs;
+}
+
+void downsample_batch(const std::vector<Image> &images, int factor,
+                      std::vector<Image> &outputs) {
+  DIP_TRACE_SCOPE("downsample_batch");
+  batch_apply(images, outputs, [factor](const Image &src, Image &dst) {
+    downsample(src, factor, dst);
+  });
+}
+
+std::vector<Image> downsample_batch(const std::vector<Image> &images,
+                                    int factor) {
+  std::vector<Image> outputs;
+  downsample_batch(images, factor, outputs);
+  return outputs;
+}
+
+void bilinear_zoom_batch(const std::vector<Image> &images, float scale,
+                         std::vector<Image> &outputs) {
+  DIP_TRACE_SCOPE("bilinear_zoom_batch");
+  batch_apply(images, outputs, [scale](const Image &src, Image &dst) {
+    bilinear_zoom(src, scale, dst);
+  });
+}
+
+std::vector<Image> bilinear_zoom_batch(const std::vector<Image> &images,
+                                       float scale) {
+  std::vector<Image> outputs;
+  bilinear_zoom_batch(images, scale, outputs);
+  return outputs;
+}
+
+void nearest_neighbor_zoom_batch(const std::vector<Image> &images, float scale,
+                                 std::vector<Image> &outputs) {
+  DIP_TRACE_SCOPE("nearest_neighbor_zoom_batch");
+  batch_apply(images, outputs, [scale](const Image &src, Image &dst) {
+    nearest_neighbor_zoom(src, scale, dst);
+  });
+}
+
+std::vector<Image> nearest_neighbor_zoom_batch(const std::vector<Image> &images,
+                                               float scale) {
+  std::vector<Image> outputs;
+  nearest_neighbor_zoom_batch(images, scale, outputs);
+  return outputs;
+}
+
+void rotate_batch(const std::vector<Image> &images, double theta,
+                  std::vector<Image> &outputs) {
+  DIP_TRACE_SCOPE("rotate_batch");
+  batch_apply(images, outputs, [theta](const Image &src, Image &dst) {
+    rotate(src, theta, dst);
+  });
+}
+
+std::vector<Image> rotate_batch(const std::vector<Image> &images,
+                                double theta) {
+  std::vector<Image> outputs;
+  rotate_batch(images, theta, outputs);
+  return outputs;
+}
+
+} // namespace algorithms
+
+void invert_image_batch(const std::vector<Image> &images, int max_gray,
+                        std::vector<Image> &outputs) {
+  DIP_TRACE_SCOPE("invert_image_batch");
+  algorithms::batch_apply(images, outputs,
+                          [max_gray](const Image &src, Image &dst) {
+                            invert_image(src, max_gray, dst);
+                          });
+}
+
+std::vector<Image> invert_image_batch(const std::vector<Image> &images,
+                                      int max_gray) {
+  std::vector<Image> outputs;
+  invert_image_batch(images, max_gray, outputs);
+  return outputs;
+}
+
+void set_complement_batch(const std::vector<Image> &images, int K,
+                          std::vector<Image> &outputs) {
+  DIP_TRACE_SCOPE("set_complement_batch");
+  algorithms::batch_apply(images, outputs, [K](const Image &src, Image &dst) {
+    set_complement(src, K, dst);
+  });
+}
+
+std::vector<Image> set_complement_batch(const std::vector<Image> &images,
+                                        int K) {
+  std::vector<Image> outputs;
+  set_complement_batch(images, K, outputs);
+  return outputs;
+}
+
+std::vector<Image> logical_and_batch(const std::vector<Image> &images1,
+                                     const std::vector<Image> &images2) {
+  DIP_TRACE_SCOPE("logical_and_batch");
+  return pairwise("logical_and_batch", images1, images2,
+                  [](const Image &a, const Image &b, Image &dst) {
+                    logical_and(a, b, dst);
+                  });
+}
+
+std::vector<Image> logical_xor_batch(const std::vector<Image> &images1,
+                                     const std::vector<Image> &images2) {
+  DIP_TRACE_SCOPE("logical_xor_batch");
+  return pairwise("logical_xor_batch", images1, images2,
+                  [](const Image &a, const Image &b, Image &dst) {
+                    logical_xor(a, b, dst);
+                  });
+}
+
+} // namespace dip
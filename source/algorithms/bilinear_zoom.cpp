@@ -5,9 +5,20 @@ namespace dip {
 namespace algorithms {
 
 Image bilinear_zoom(const Image &img, float scale) {
+  Image result;
+  bilinear_zoom(img, scale, result);
+  return result;
+}
+
+void bilinear_zoom(const Image &img, float scale, Image &dst) {
+  DIP_TRACE_SCOPE("bilinear_zoom");
+  DIP_MEMORY_SCOPE("bilinear_zoom");
   if (scale <= 0.0f) {
     throw std::invalid_argument("Scale must be positive");
   }
+  if (&dst == &img) {
+    throw std::invalid_argument("bilinear_zoom cannot run in place");
+  }
 
   int height = img.height();
   int width = img.width();
@@ -16,22 +27,24 @@ Image bilinear_zoom(const Image &img, float scale) {
   int new_height = static_cast<int>(height * scale);
   int new_width = static_cast<int>(width * scale);
 
-  Image result(new_width, new_height, channels);
+  dst.create(new_width, new_height, channels);
 
-  for (int c = 0; c < channels; c++) {
-    for (int i = 0; i < new_height; i++) {
+  // 按输出行并行，每个像素的计算与遍历顺序无关
+  parallel_for(0, new_height, [&](int y0, int y1) {
+    for (int i = y0; i < y1; i++) {
       for (int j = 0; j < new_width; j++) {
         // 映射到原始图像浮点坐标
         float orig_y = i / scale;
         float orig_x = j / scale;
 
         // 使用公共的双线性插值函数
-        result.at<uint8_t>(i, j, c) = bilinear_interp(img, orig_x, orig_y, c);
+        for (int c = 0; c < channels; c++) {
+          dst.at<uint8_t>(i, j, c) =
+              bilinear_interp(img, orig_x, orig_y, c);
+        }
       }
     }
-  }
-
-  return result;
+  });
 }
 
 } // namespace algorithms
@@ -0,0 +1,292 @@
+#include <algorithms/connected_components.hpp>
+#include <atomic>
+#include <core/core.hpp>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace dip {
+
+namespace {
+
+// 并查集查找（路径减半），根节点始终是集合中最小的标号
+int32_t find_root(std::vector<int32_t> &parent, int32_t x) {
+  while (parent[x] != x) {
+    parent[x] = parent[parent[x]];
+    x = parent[x];
+  }
+  return x;
+}
+
+// 合并两个集合，较大的根指向较小的根，返回合并后的根
+int32_t unite(std::vector<int32_t> &parent, int32_t a, int32_t b) {
+  a = find_root(parent, a);
+  b = find_root(parent, b);
+  if (a < b) {
+    parent[b] = a;
+    return a;
+  }
+  parent[a] = b;
+  return b;
+}
+
+// 标记 [y0, y1) 行，不访问 y0 之上的行
+// 结果写入labels，编号为1..k（按光栅顺序），返回k
+int label_rows(const Image &img, int y0, int y1, NeighborhoodType type,
+               uint8_t V, Image &labels) {
+  const int width = img.width();
+  const int channels = img.channels();
+  const bool diagonal = type != NeighborhoodType::N4;
+  const bool m_adjacency = type == NeighborhoodType::M_CONNECTED;
+
+  // 等价表，标号0保留给背景
+  std::vector<int32_t> parent(1, 0);
+
+  // 第一遍：分配临时标号并记录等价关系
+  for (int y = y0; y < y1; ++y) {
+    const uint8_t *row = img.ptr<uint8_t>(y);
+    int32_t *lab = labels.ptr<int32_t>(y);
+    const int32_t *up = y > y0 ? labels.ptr<int32_t>(y - 1) : nullptr;
+
+    for (int x = 0; x < width; ++x) {
+      if (row[x * channels] != V) {
+        lab[x] = 0;
+        continue;
+      }
+
+      int32_t l = 0;
+      auto merge = [&](int32_t other) {
+        l = l == 0 ? other : (l == other ? l : unite(parent, l, other));
+      };
+
+      const bool w_fg = x > 0 && lab[x - 1] != 0;
+      const bool n_fg = up && up[x] != 0;
+
+      if (n_fg && type == NeighborhoodType::N8) {
+        // 8-连通时左、左上、右上都与上方像素8-邻接，已在同一集合中
+        lab[x] = up[x];
+        continue;
+      }
+
+      if (w_fg)
+        merge(lab[x - 1]);
+      if (n_fg)
+        merge(up[x]);
+
+      if (diagonal && up) {
+        // m-连通：对角像素与p共有的4-邻域像素中存在前景时不直接邻接
+        if (x > 0 && up[x - 1] != 0 && !(m_adjacency && (w_fg || n_fg)))
+          merge(up[x - 1]);
+        if (x + 1 < width && up[x + 1] != 0 &&
+            !(m_adjacency && (n_fg || row[(x + 1) * channels] == V)))
+          merge(up[x + 1]);
+      }
+
+      if (l == 0) {
+        l = static_cast<int32_t>(parent.size());
+        parent.push_back(l);
+      }
+      lab[x] = l;
+    }
+  }
+
+  // 压平等价表：parent[i] <= i，按标号递增顺序分配连续的最终编号
+  int32_t count = 0;
+  for (size_t i = 1; i < parent.size(); ++i) {
+    parent[i] = parent[i] < static_cast<int32_t>(i) ? parent[parent[i]]
+                                                     : ++count;
+  }
+
+  // 第二遍：替换为最终编号
+  for (int y = y0; y < y1; ++y) {
+    int32_t *lab = labels.ptr<int32_t>(y);
+    for (int x = 0; x < width; ++x) {
+      lab[x] = parent[lab[x]];
+    }
+  }
+
+  return count;
+}
+
+// 无锁并查集查找（CAS路径减半），parent[i] <= i 始终成立
+int32_t find_root(std::atomic<int32_t> *parent, int32_t x) {
+  for (;;) {
+    int32_t p = parent[x].load(std::memory_order_relaxed);
+    if (p == x)
+      return x;
+    int32_t gp = parent[p].load(std::memory_order_relaxed);
+    if (gp != p)
+      parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+    x = gp;
+  }
+}
+
+// 无锁合并：用CAS将较大的根链接到较小的根，失败时重新查找后重试
+void unite(std::atomic<int32_t> *parent, int32_t a, int32_t b) {
+  for (;;) {
+    a = find_root(parent, a);
+    b = find_root(parent, b);
+    if (a == b)
+      return;
+    if (a < b)
+      std::swap(a, b);
+    int32_t expected = a;
+    if (parent[a].compare_exchange_strong(expected, b,
+                                          std::memory_order_acq_rel))
+      return;
+  }
+}
+
+// 并行执行 f(0..n-1)，每个任务单独成块
+template <typename F> void run_tasks(int n, const F &f) {
+  parallel_for(
+      0, n,
+      [&](int begin, int end) {
+        for (int i = begin; i < end; ++i)
+          f(i);
+      },
+      1);
+}
+
+// 条带最小行数，避免条带过窄导致边界合并占比过高
+constexpr int MIN_STRIP_ROWS = 16;
+
+} // namespace
+
+LabelResult label_components(const Image &img, NeighborhoodType type,
+                             uint8_t V) {
+  LabelResult result{Image(), 0};
+  label_components(img, type, V, result);
+  return result;
+}
+
+void label_components(const Image &img, NeighborhoodType type, uint8_t V,
+                      LabelResult &result) {
+  DIP_TRACE_SCOPE("label_components");
+  DIP_MEMORY_SCOPE("label_components");
+  if (img.type() != DataType::UINT8) {
+    throw std::invalid_argument("label_components requires a UINT8 image");
+  }
+
+  result.labels.create(img.width(), img.height(), 1, DataType::INT32);
+  result.num_components = 0;
+  if (img.empty()) {
+    return;
+  }
+
+  result.num_components =
+      label_rows(img, 0, img.height(), type, V, result.labels);
+}
+
+
+LabelResult label_components_parallel(const Image &img, NeighborhoodType type,
+                                      uint8_t V, int num_threads) {
+  LabelResult result{Image(), 0};
+  label_components_parallel(img, type, V, result, num_threads);
+  return result;
+}
+
+void label_components_parallel(const Image &img, NeighborhoodType type,
+                               uint8_t V, LabelResult &result,
+                               int num_threads) {
+  DIP_TRACE_SCOPE("label_components_parallel");
+  DIP_MEMORY_SCOPE("label_components_parallel");
+  if (img.type() != DataType::UINT8) {
+    throw std::invalid_argument(
+        "label_components_parallel requires a UINT8 image");
+  }
+
+  const int width = img.width();
+  const int height = img.height();
+  if (num_threads <= 0) {
+    num_threads = get_num_threads();
+  }
+  const int strips =
+      std::max(1, std::min(num_threads, height / MIN_STRIP_ROWS));
+  if (strips <= 1 || img.empty()) {
+    label_components(img, type, V, result);
+    return;
+  }
+
+  result.labels.create(width, height, 1, DataType::INT32);
+  result.num_components = 0;
+  Image &labels = result.labels;
+
+  std::vector<int> strip_y(strips + 1);
+  for (int s = 0; s <= strips; ++s) {
+    strip_y[s] = static_cast<int>(static_cast<int64_t>(height) * s / strips);
+  }
+
+  // 第一步：各条带独立标记，编号为条带内的1..k
+  std::vector<int> counts(strips, 0);
+  run_tasks(strips, [&](int s) {
+    counts[s] = label_rows(img, strip_y[s], strip_y[s + 1], type, V, labels);
+  });
+
+  // 条带编号偏移，全局临时标号为 base[s] + 局部编号
+  std::vector<int32_t> base(strips, 0);
+  for (int s = 1; s < strips; ++s) {
+    base[s] = base[s - 1] + counts[s - 1];
+  }
+  const int32_t total = base[strips - 1] + counts[strips - 1];
+
+  std::unique_ptr<std::atomic<int32_t>[]> parent(
+      new std::atomic<int32_t>[total + 1]);
+  for (int32_t i = 0; i <= total; ++i) {
+    parent[i].store(i, std::memory_order_relaxed);
+  }
+
+  // 第二步：并行合并条带边界（相邻边界共享同一条带的标号，需无锁合并）
+  const bool diagonal = type != NeighborhoodType::N4;
+  const bool m_adjacency = type == NeighborhoodType::M_CONNECTED;
+  run_tasks(strips - 1, [&](int i) {
+    const int s = i + 1;
+    const int y = strip_y[s];
+    const int32_t *lab = labels.ptr<int32_t>(y);
+    const int32_t *up = labels.ptr<int32_t>(y - 1);
+    const int32_t lab_base = base[s];
+    const int32_t up_base = base[s - 1];
+
+    for (int x = 0; x < width; ++x) {
+      if (lab[x] == 0)
+        continue;
+
+      const int32_t a = lab[x] + lab_base;
+      const bool w_fg = x > 0 && lab[x - 1] != 0;
+      const bool n_fg = up[x] != 0;
+
+      if (n_fg)
+        unite(parent.get(), a, up[x] + up_base);
+
+      if (diagonal) {
+        if (x > 0 && up[x - 1] != 0 && !(m_adjacency && (w_fg || n_fg)))
+          unite(parent.get(), a, up[x - 1] + up_base);
+        if (x + 1 < width && up[x + 1] != 0 &&
+            !(m_adjacency && (n_fg || lab[x + 1] != 0)))
+          unite(parent.get(), a, up[x + 1] + up_base);
+      }
+    }
+  });
+
+  // 第三步：按最小临时标号（即光栅顺序）分配最终编号
+  std::vector<int32_t> final_label(total + 1, 0);
+  int32_t count = 0;
+  for (int32_t i = 1; i <= total; ++i) {
+    int32_t root = find_root(parent.get(), i);
+    final_label[i] = root == i ? ++count : final_label[root];
+  }
+  result.num_components = count;
+
+  // 第四步：并行重新编号
+  run_tasks(strips, [&](int s) {
+    for (int y = strip_y[s]; y < strip_y[s + 1]; ++y) {
+      int32_t *lab = labels.ptr<int32_t>(y);
+      for (int x = 0; x < width; ++x) {
+        if (lab[x] != 0)
+          lab[x] = final_label[lab[x] + base[s]];
+      }
+    }
+  });
+}
+
+} // namespace dip
@@ -7,37 +7,58 @@ Image downsample(const Image &img, int factor) {
   if (factor <= 1) {
     return img; // 不需要下采样
   }
+  Image result;
+  downsample(img, factor, result);
+  return result;
+}
+
+void downsample(const Image &img, int factor, Image &dst) {
+  DIP_TRACE_SCOPE("downsample");
+  DIP_MEMORY_SCOPE("downsample");
+  if (factor <= 1) {
+    if (&dst != &img)
+      dst = img; // 不需要下采样
+    return;
+  }
+  if (&dst == &img) {
+    throw std::invalid_argument("downsample cannot run in place");
+  }
 
   int new_width = img.width() / factor;
   int new_height = img.height() / factor;
 
-  Image result(new_width, new_height, img.channels());
+  dst.create(new_width, new_height, img.channels());
 
-  for (int y = 0; y < new_height; y++) {
-    for (int x = 0; x < new_width; x++) {
-      for (int c = 0; c < img.channels(); c++) {
-        int sum = 0;
-        int count = 0;
+  // 输出尺寸取整，每个输出像素的邻域都完整落在图像内（共 factor² 个像素）
+  const int channels = img.channels();
+  const size_t span = static_cast<size_t>(new_width) * factor * channels;
+  const int count = factor * factor;
 
-        // 计算邻域平均值
-        for (int dy = 0; dy < factor; dy++) {
-          for (int dx = 0; dx < factor; dx++) {
-            int src_x = x * factor + dx;
-            int src_y = y * factor + dy;
+  parallel_for(0, new_height, [&](int y0, int y1) {
+    // 先将 factor 行纵向累加，再对每个输出像素横向求和
+    // 累加缓冲区按线程复用，批量处理小图像时不必每次重新分配
+    thread_local std::vector<uint32_t> acc;
+    acc.resize(span);
+    for (int y = y0; y < y1; y++) {
+      std::fill(acc.begin(), acc.end(), 0);
+      for (int dy = 0; dy < factor; dy++) {
+        simd::accumulate(img.ptr<uint8_t>(y * factor + dy), acc.data(), span);
+      }
 
-            if (src_x < img.width() && src_y < img.height()) {
-              sum += img.at<uint8_t>(src_y, src_x, c);
-              count++;
-            }
+      uint8_t *out = dst.ptr<uint8_t>(y);
+      for (int x = 0; x < new_width; x++) {
+        const uint32_t *block = acc.data() + static_cast<size_t>(x) * factor *
+                                                 channels;
+        for (int c = 0; c < channels; c++) {
+          uint32_t sum = 0;
+          for (int dx = 0; dx < factor; dx++) {
+            sum += block[dx * channels + c];
           }
+          out[x * channels + c] = static_cast<uint8_t>(sum / count);
         }
-
-        result.at<uint8_t>(y, x, c) = static_cast<uint8_t>(sum / count);
       }
     }
-  }
-
-  return result;
+  });
 }
 
 } // namespace algorithms
@@ -8,6 +8,7 @@ namespace algorithms {
 
 LinearFitResult linear_fit(const std::vector<double> &x_data,
                            const std::vector<double> &y_data) {
+  DIP_TRACE_SCOPE("linear_fit");
   LinearFitResult result{0.0, 0.0, 0.0, false};
 
   // 检查数据有效性
@@ -52,6 +53,7 @@ LinearFitResult linear_fit(const std::vector<double> &x_data,
 std::vector<double> polynomial_fit(const std::vector<double> &x_data,
                                    const std::vector<double> &y_data,
                                    int degree) {
+  DIP_TRACE_SCOPE("polynomial_fit");
   std::vector<double> coefficients;
 
   // 检查数据有效性
@@ -132,6 +134,7 @@ std::vector<double> polynomial_fit(const std::vector<double> &x_data,
 
 double calculate_r_squared(const std::vector<double> &y_true,
                            const std::vector<double> &y_pred) {
+  DIP_TRACE_SCOPE("calculate_r_squared");
   if (y_true.size() != y_pred.size() || y_true.empty()) {
     return 0.0;
   }
@@ -4,27 +4,31 @@ namespace dip {
 namespace algorithms {
 
 Image quantize(const Image &img, int levels) {
+  Image result;
+  quantize(img, levels, result);
+  return result;
+}
+
+void quantize(const Image &img, int levels, Image &dst) {
+  DIP_TRACE_SCOPE("quantize");
+  DIP_MEMORY_SCOPE("quantize");
   if (levels <= 0 || levels > 256) {
     throw std::invalid_argument("Levels must be between 1 and 256");
   }
 
-  Image result(img.width(), img.height(), img.channels());
+  // dst 与 img 相同时尺寸已匹配，create 不会改动数据，逐元素原地计算
+  dst.create(img.width(), img.height(), img.channels());
 
   // 计算量化步长
   int step = 256 / levels;
+  const int row_elems = img.width() * img.channels();
 
-  for (int y = 0; y < img.height(); y++) {
-    for (int x = 0; x < img.width(); x++) {
-      for (int c = 0; c < img.channels(); c++) {
-        uint8_t pixel = img.at<uint8_t>(y, x, c);
-        // 量化：将像素值映射到最近的级别
-        uint8_t quantized = (pixel / step) * step + step / 2;
-        result.at<uint8_t>(y, x, c) = quantized;
-      }
-    }
-  }
-
-  return result;
+  // 量化：将像素值映射到最近的级别
+  parallel_for(0, img.height(), [&](int y0, int y1) {
+    for (int y = y0; y < y1; y++)
+      simd::quantize(img.ptr<uint8_t>(y), dst.ptr<uint8_t>(y), row_elems,
+                     step);
+  });
 }
 
 } // namespace algorithms
@@ -0,0 +1,144 @@
+#include <algorithms/region_props.hpp>
+#include <algorithm>
+#include <core/core.hpp>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace dip {
+
+namespace {
+
+// 几何统计：按行内同标号的连续段（run）累加，每段只更新一次
+// 同时检查每个标号都在 0..count 内，之后的强度统计不再检查
+void accumulate_geometry(const Image &labels, RegionProps &props) {
+  const int width = labels.width();
+  for (int y = 0; y < labels.height(); ++y) {
+    const int32_t *lab = labels.ptr<int32_t>(y);
+    int x = 0;
+    while (x < width) {
+      const int32_t l = lab[x];
+      const int start = x;
+      while (x < width && lab[x] == l)
+        ++x;
+      if (l == 0)
+        continue;
+      if (l < 0 || l > props.count) {
+        throw std::invalid_argument(
+            "Label " + std::to_string(l) +
+            " is outside the range 1.." + std::to_string(props.count));
+      }
+
+      const int i = l - 1;
+      const int64_t len = x - start;
+      props.area[i] += len;
+      props.sum_x[i] += (static_cast<int64_t>(start) + x - 1) * len / 2;
+      props.sum_y[i] += static_cast<int64_t>(y) * len;
+      props.min_x[i] = std::min(props.min_x[i], start);
+      props.max_x[i] = std::max(props.max_x[i], x - 1);
+      props.min_y[i] = std::min(props.min_y[i], y);
+      props.max_y[i] = std::max(props.max_y[i], y);
+    }
+  }
+}
+
+template <typename T>
+void accumulate_intensity(const Image &labels, const Image &intensity,
+                          RegionProps &props) {
+  const int width = labels.width();
+  const int channels = intensity.channels();
+  for (int y = 0; y < labels.height(); ++y) {
+    const int32_t *lab = labels.ptr<int32_t>(y);
+    const T *row = intensity.ptr<T>(y);
+    for (int x = 0; x < width; ++x) {
+      const int32_t l = lab[x];
+      if (l == 0)
+        continue;
+
+      const int i = l - 1;
+      // Float16 只能经 float 转换；其余类型直接转 double，不丢失精度
+      double v;
+      if constexpr (std::is_same_v<T, Float16>)
+        v = static_cast<float>(row[x * channels]);
+      else
+        v = static_cast<double>(row[x * channels]);
+      props.sum_intensity[i] += v;
+      props.min_intensity[i] = std::min(props.min_intensity[i], v);
+      props.max_intensity[i] = std::max(props.max_intensity[i], v);
+    }
+  }
+}
+
+} // namespace
+
+RegionProps region_props(const Image &labels, int num_components,
+                         const Image &intensity) {
+  DIP_TRACE_SCOPE("region_props");
+  DIP_MEMORY_SCOPE("region_props");
+  if (labels.type() != DataType::INT32 || labels.channels() != 1) {
+    throw std::invalid_argument(
+        "region_props requires a single-channel INT32 label image");
+  }
+  const bool with_intensity = !intensity.empty();
+  if (with_intensity && intensity.size() != labels.size()) {
+    throw std::invalid_argument(
+        "Intensity image must have the same size as the label image");
+  }
+
+  RegionProps props;
+  const size_t n = static_cast<size_t>(std::max(0, num_components));
+  props.count = static_cast<int>(n);
+  props.area.assign(n, 0);
+  props.min_x.assign(n, std::numeric_limits<int32_t>::max());
+  props.min_y.assign(n, std::numeric_limits<int32_t>::max());
+  props.max_x.assign(n, -1);
+  props.max_y.assign(n, -1);
+  props.sum_x.assign(n, 0);
+  props.sum_y.assign(n, 0);
+  props.sum_intensity.assign(n, 0.0);
+  props.min_intensity.assign(n, std::numeric_limits<double>::infinity());
+  props.max_intensity.assign(n, -std::numeric_limits<double>::infinity());
+
+  if (labels.empty()) {
+    return props;
+  }
+
+  accumulate_geometry(labels, props);
+
+  if (with_intensity) {
+    switch (intensity.type()) {
+    case DataType::UINT8:
+      accumulate_intensity<uint8_t>(labels, intensity, props);
+      break;
+    case DataType::INT8:
+      accumulate_intensity<int8_t>(labels, intensity, props);
+      break;
+    case DataType::UINT16:
+      accumulate_intensity<uint16_t>(labels, intensity, props);
+      break;
+    case DataType::INT16:
+      accumulate_intensity<int16_t>(labels, intensity, props);
+      break;
+    case DataType::UINT32:
+      accumulate_intensity<uint32_t>(labels, intensity, props);
+      break;
+    case DataType::INT32:
+      accumulate_intensity<int32_t>(labels, intensity, props);
+      break;
+    case DataType::FLOAT16:
+      accumulate_intensity<Float16>(labels, intensity, props);
+      break;
+    case DataType::FLOAT32:
+      accumulate_intensity<float>(labels, intensity, props);
+      break;
+    case DataType::FLOAT64:
+      accumulate_intensity<double>(labels, intensity, props);
+      break;
+    }
+  }
+
+  return props;
+}
+
+} // namespace dip
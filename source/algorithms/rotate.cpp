@@ -6,6 +6,17 @@ namespace dip {
 namespace algorithms {
 
 Image rotate(const Image &img, double theta) {
+  Image result;
+  rotate(img, theta, result);
+  return result;
+}
+
+void rotate(const Image &img, double theta, Image &dst) {
+  DIP_TRACE_SCOPE("rotate");
+  DIP_MEMORY_SCOPE("rotate");
+  if (&dst == &img) {
+    throw std::invalid_argument("rotate cannot run in place");
+  }
   // 注意：theta参数使用弧度而非角度
   // 常用弧度值：0 = 0°, π/6 = 30°, π/4 = 45°, π/2 = 90°, π = 180°
   int height = img.height();
@@ -13,7 +24,7 @@ Image rotate(const Image &img, double theta) {
   int channels = img.channels();
 
   // 创建输出图像（保持原始尺寸）
-  Image result(width, height, channels);
+  dst.create(width, height, channels);
 
   double cos_t = std::cos(theta);
   double sin_t = std::sin(theta);
@@ -22,29 +33,29 @@ Image rotate(const Image &img, double theta) {
   double cx = width / 2.0;
   double cy = height / 2.0;
 
-  // 遍历输出图像的每个像素
-  for (int y_out = 0; y_out < height; y_out++) {
-    for (int x_out = 0; x_out < width; x_out++) {
-      // 逆映射：从输出坐标反推原坐标
-      double x = (x_out - cx) * cos_t + (y_out - cy) * sin_t + cx;
-      double y = -(x_out - cx) * sin_t + (y_out - cy) * cos_t + cy;
-
-      // 检查原坐标是否在图像范围内
-      if (x >= 0 && x < width && y >= 0 && y < height) {
-        // 对每个通道进行双线性插值
-        for (int c = 0; c < channels; c++) {
-          result.at<uint8_t>(y_out, x_out, c) = bilinear_interp(img, x, y, c);
-        }
-      } else {
-        // 超出范围设为黑色（0）
-        for (int c = 0; c < channels; c++) {
-          result.at<uint8_t>(y_out, x_out, c) = 0;
+  // 遍历输出图像的每个像素（按行并行）
+  parallel_for(0, height, [&](int y0, int y1) {
+    for (int y_out = y0; y_out < y1; y_out++) {
+      for (int x_out = 0; x_out < width; x_out++) {
+        // 逆映射：从输出坐标反推原坐标
+        double x = (x_out - cx) * cos_t + (y_out - cy) * sin_t + cx;
+        double y = -(x_out - cx) * sin_t + (y_out - cy) * cos_t + cy;
+
+        // 检查原坐标是否在图像范围内
+        if (x >= 0 && x < width && y >= 0 && y < height) {
+          // 对每个通道进行双线性插值
+          for (int c = 0; c < channels; c++) {
+            dst.at<uint8_t>(y_out, x_out, c) = bilinear_interp(img, x, y, c);
+          }
+        } else {
+          // 超出范围设为黑色（0）
+          for (int c = 0; c < channels; c++) {
+            dst.at<uint8_t>(y_out, x_out, c) = 0;
+          }
         }
       }
     }
-  }
-
-  return result;
+  });
 }
 
 } // namespace algorithms
@@ -0,0 +1,97 @@
+#include <algorithms/downsample.hpp>
+#include <algorithms/scaled_load.hpp>
+
+namespace dip {
+namespace algorithms {
+
+namespace {
+
+// 每个输入条带的目标字节数
+constexpr size_t kStripBytes = size_t(4) << 20;
+
+bool is_pnm_path(const std::string &path) {
+  const size_t dot = path.find_last_of('.');
+  if (dot == std::string::npos)
+    return false;
+  std::string ext = path.substr(dot + 1);
+  std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+  return ext == "pgm" || ext == "ppm" || ext == "pnm";
+}
+
+// 按条带缩小PNM：每个条带包含整数个 factor 行的输入块
+std::shared_ptr<Image> load_pnm_scaled(const PnmReader &reader, int factor) {
+  const int out_width = reader.width() / factor;
+  const int out_height = reader.height() / factor;
+  const int channels = reader.channels();
+  auto result = std::make_shared<Image>(out_width, out_height, channels);
+  if (result->empty())
+    return result;
+
+  const size_t in_row_bytes = reader.header().row_bytes();
+  const int out_rows_per_strip = static_cast<int>(std::max<size_t>(
+      1, kStripBytes / (in_row_bytes * static_cast<size_t>(factor))));
+  const size_t out_row_bytes = static_cast<size_t>(out_width) * channels;
+
+  // 条带直接引用映射内存，缩小后丢弃已处理的页，常驻内存保持在一个条带
+  reader.advise_sequential();
+  Image reduced;
+  for (int oy = 0; oy < out_height; oy += out_rows_per_strip) {
+    const int rows = std::min(out_rows_per_strip, out_height - oy);
+    const Image strip = reader.view_rows(oy * factor, rows * factor);
+    downsample(strip, factor, reduced);
+    for (int r = 0; r < rows; ++r)
+      std::memcpy(result->ptr<uint8_t>(oy + r), reduced.ptr<uint8_t>(r),
+                  out_row_bytes);
+    reader.release_rows(oy * factor, rows * factor);
+  }
+  return result;
+}
+
+} // namespace
+
+int scale_factor_for(int width, int height, int max_size) {
+  if (max_size < 1)
+    throw std::invalid_argument("max_size must be at least 1");
+  const int longest = std::max(width, height);
+  return std::max(1, (longest + max_size - 1) / max_size);
+}
+
+std::shared_ptr<Image> load_scaled(const std::string &path, int max_size,
+                                   int desired_channels) {
+  DIP_TRACE_SCOPE("load_scaled");
+  DIP_MEMORY_SCOPE("load_scaled");
+  if (max_size < 1)
+    throw std::invalid_argument("max_size must be at least 1");
+
+  if (is_pnm_path(path)) {
+    PnmReader reader;
+    if (reader.open(path) && reader.type() == DataType::UINT8 &&
+        (desired_channels == 0 || desired_channels == reader.channels())) {
+      const int factor =
+          scale_factor_for(reader.width(), reader.height(), max_size);
+      if (factor > 1)
+        return load_pnm_scaled(reader, factor);
+      // 不缩小时读入自有缓冲区：映射视图在源文件被覆盖或截断后失效
+      auto image = std::make_shared<Image>();
+      if (read_pnm(path, *image))
+        return image;
+    }
+  }
+
+  int width, height, channels;
+  if (!ImageLoader::get_image_info(path, width, height, channels)) {
+    std::cerr << "Error: Failed to read image info '" << path
+              << "': " << stbi_failure_reason() << std::endl;
+    return nullptr;
+  }
+  auto full = ImageLoader::load_from_file(path, desired_channels);
+  const int factor = scale_factor_for(width, height, max_size);
+  if (!full || factor <= 1)
+    return full;
+  auto result = std::make_shared<Image>();
+  downsample(*full, factor, *result);
+  return result;
+}
+
+} // namespace algorithms
+} // namespace dip
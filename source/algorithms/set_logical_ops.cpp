@@ -5,99 +5,117 @@
 namespace dip {
 
 Image set_complement(const Image &img, int K) {
-  spdlog::info("Applying set complement to {}x{} image with K={}", img.width(),
-               img.height(), K);
+  Image result;
+  set_complement(img, K, result);
+  return result;
+}
+
+void set_complement(const Image &img, int K, Image &dst) {
+  DIP_TRACE_SCOPE("set_complement");
+  DIP_MEMORY_SCOPE("set_complement");
+  spdlog::debug("Applying set complement to {}x{} image with K={}", img.width(),
+                img.height(), K);
 
   // 检查输入图像有效性
   if (img.empty()) {
     spdlog::error("Input image is empty");
-    return Image();
+    dst.release();
+    return;
   }
 
-  // 创建结果图像
-  Image result = img.clone();
+  // 每个像素都会被覆盖，无需复制输入；dst 与 img 相同时原地计算
+  dst.create(img.width(), img.height(), img.channels());
 
   // 对每个像素进行补集运算
-  for (int y = 0; y < img.height(); ++y) {
-    for (int x = 0; x < img.width(); ++x) {
-      for (int c = 0; c < img.channels(); ++c) {
-        uint8_t pixel_value = img.at<uint8_t>(y, x, c);
-        result.at<uint8_t>(y, x, c) = static_cast<uint8_t>(K - pixel_value);
-      }
+  const int row_elems = img.width() * img.channels();
+  parallel_for(0, img.height(), [&](int y0, int y1) {
+    for (int y = y0; y < y1; ++y) {
+      simd::subtract_from(img.ptr<uint8_t>(y), dst.ptr<uint8_t>(y),
+                          row_elems, K);
     }
-  }
+  });
+}
 
+Image logical_and(const Image &img1, const Image &img2) {
+  Image result;
+  logical_and(img1, img2, result);
   return result;
 }
 
-Image logical_and(const Image &img1, const Image &img2) {
-  spdlog::info("Applying logical AND to {}x{} and {}x{} images", img1.width(),
-               img1.height(), img2.width(), img2.height());
+void logical_and(const Image &img1, const Image &img2, Image &dst) {
+  DIP_TRACE_SCOPE("logical_and");
+  DIP_MEMORY_SCOPE("logical_and");
+  spdlog::debug("Applying logical AND to {}x{} and {}x{} images", img1.width(),
+                img1.height(), img2.width(), img2.height());
 
   // 检查输入图像有效性
   if (img1.empty() || img2.empty()) {
     spdlog::error("One or both input images are empty");
-    return Image();
+    dst.release();
+    return;
   }
 
   // 检查图像尺寸是否一致
   if (img1.width() != img2.width() || img1.height() != img2.height() ||
       img1.channels() != img2.channels()) {
     spdlog::error("Input images must have the same dimensions and channels");
-    return Image();
+    dst.release();
+    return;
   }
 
-  // 创建结果图像
-  Image result(img1.width(), img1.height(), img1.channels());
+  // dst 可以是 img1 或 img2 本身，逐元素原地计算
+  dst.create(img1.width(), img1.height(), img1.channels());
 
   // 对每个像素进行逻辑AND运算
-  for (int y = 0; y < img1.height(); ++y) {
-    for (int x = 0; x < img1.width(); ++x) {
-      for (int c = 0; c < img1.channels(); ++c) {
-        uint8_t pixel1 = img1.at<uint8_t>(y, x, c);
-        uint8_t pixel2 = img2.at<uint8_t>(y, x, c);
-        // 二值图逻辑AND：只有两个像素都为1时结果为1
-        result.at<uint8_t>(y, x, c) = (pixel1 == 1 && pixel2 == 1) ? 1 : 0;
-      }
+  const int row_elems = img1.width() * img1.channels();
+  parallel_for(0, img1.height(), [&](int y0, int y1) {
+    for (int y = y0; y < y1; ++y) {
+      // 二值图逻辑AND：只有两个像素都为1时结果为1
+      simd::binary_and(img1.ptr<uint8_t>(y), img2.ptr<uint8_t>(y),
+                       dst.ptr<uint8_t>(y), row_elems);
     }
-  }
+  });
+}
 
+Image logical_xor(const Image &img1, const Image &img2) {
+  Image result;
+  logical_xor(img1, img2, result);
   return result;
 }
 
-Image logical_xor(const Image &img1, const Image &img2) {
-  spdlog::info("Applying logical XOR to {}x{} and {}x{} images", img1.width(),
-               img1.height(), img2.width(), img2.height());
+void logical_xor(const Image &img1, const Image &img2, Image &dst) {
+  DIP_TRACE_SCOPE("logical_xor");
+  DIP_MEMORY_SCOPE("logical_xor");
+  spdlog::debug("Applying logical XOR to {}x{} and {}x{} images", img1.width(),
+                img1.height(), img2.width(), img2.height());
 
   // 检查输入图像有效性
   if (img1.empty() || img2.empty()) {
     spdlog::error("One or both input images are empty");
-    return Image();
+    dst.release();
+    return;
   }
 
   // 检查图像尺寸是否一致
   if (img1.width() != img2.width() || img1.height() != img2.height() ||
       img1.channels() != img2.channels()) {
     spdlog::error("Input images must have the same dimensions and channels");
-    return Image();
+    dst.release();
+    return;
   }
 
-  // 创建结果图像
-  Image result(img1.width(), img1.height(), img1.channels());
+  // dst 可以是 img1 或 img2 本身，逐元素原地计算
+  dst.create(img1.width(), img1.height(), img1.channels());
 
   // 对每个像素进行逻辑XOR运算
-  for (int y = 0; y < img1.height(); ++y) {
-    for (int x = 0; x < img1.width(); ++x) {
-      for (int c = 0; c < img1.channels(); ++c) {
-        uint8_t pixel1 = img1.at<uint8_t>(y, x, c);
-        uint8_t pixel2 = img2.at<uint8_t>(y, x, c);
-        // 二值图逻辑XOR：两个像素不相同时结果为1
-        result.at<uint8_t>(y, x, c) = (pixel1 != pixel2) ? 1 : 0;
-      }
+  const int row_elems = img1.width() * img1.channels();
+  parallel_for(0, img1.height(), [&](int y0, int y1) {
+    for (int y = y0; y < y1; ++y) {
+      // 二值图逻辑XOR：两个像素不相同时结果为1
+      simd::binary_xor(img1.ptr<uint8_t>(y), img2.ptr<uint8_t>(y),
+                       dst.ptr<uint8_t>(y), row_elems);
     }
-  }
-
-  return result;
+  });
 }
 
 } // namespace dip
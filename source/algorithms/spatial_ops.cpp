@@ -5,30 +5,35 @@
 namespace dip {
 
 Image invert_image(const Image &img, int max_gray) {
-  spdlog::info("Applying image inversion to {}x{} image with max_gray={}",
-               img.width(), img.height(), max_gray);
+  Image result;
+  invert_image(img, max_gray, result);
+  return result;
+}
+
+void invert_image(const Image &img, int max_gray, Image &dst) {
+  DIP_TRACE_SCOPE("invert_image");
+  DIP_MEMORY_SCOPE("invert_image");
+  spdlog::debug("Applying image inversion to {}x{} image with max_gray={}",
+                img.width(), img.height(), max_gray);
 
   // 检查输入图像有效性
   if (img.empty()) {
     spdlog::error("Input image is empty");
-    return Image();
+    dst.release();
+    return;
   }
 
-  // 创建结果图像
-  Image result = img.clone();
+  // 每个像素都会被覆盖，无需复制输入；dst 与 img 相同时原地计算
+  dst.create(img.width(), img.height(), img.channels());
 
   // 对每个像素进行求反运算：res[i][j] = maxGray - img[i][j]
-  for (int y = 0; y < img.height(); ++y) {
-    for (int x = 0; x < img.width(); ++x) {
-      for (int c = 0; c < img.channels(); ++c) {
-        uint8_t pixel_value = img.at<uint8_t>(y, x, c);
-        result.at<uint8_t>(y, x, c) =
-            static_cast<uint8_t>(max_gray - pixel_value);
-      }
+  const int row_elems = img.width() * img.channels();
+  parallel_for(0, img.height(), [&](int y0, int y1) {
+    for (int y = y0; y < y1; ++y) {
+      simd::subtract_from(img.ptr<uint8_t>(y), dst.ptr<uint8_t>(y),
+                          row_elems, max_gray);
     }
-  }
-
-  return result;
+  });
 }
 
 } // namespace dip
@@ -0,0 +1,209 @@
+#include <algorithms/bilinear_interp.hpp>
+#include <algorithms/downsample.hpp>
+#include <algorithms/quantize.hpp>
+#include <algorithms/set_logical_ops.hpp>
+#include <algorithms/spatial_ops.hpp>
+#include <algorithms/streaming.hpp>
+#include <cmath>
+
+namespace dip {
+namespace algorithms {
+
+namespace detail {
+
+void open_input(const std::string &path, int band_rows, int halo,
+                StripReader &reader) {
+  if (!reader.open(path, band_rows, halo))
+    throw std::runtime_error("Cannot stream '" + path + "': " +
+                             reader.error());
+  if (reader.type() != DataType::UINT8)
+    throw std::runtime_error("Cannot stream '" + path +
+                             "': only 8-bit PNM input is supported");
+}
+
+void open_output(const std::string &path, int width, int height,
+                 int channels, StripWriter &writer) {
+  if (!writer.open(path, width, height, channels))
+    throw std::runtime_error(writer.error());
+}
+
+void close_output(StripWriter &writer, const std::string &path) {
+  if (!writer.close())
+    throw std::runtime_error("Failed to write '" + path +
+                             "': " + writer.error());
+}
+
+} // namespace detail
+
+namespace {
+
+// 缩放后输出行的行带大小：输入约 band_rows 行
+int output_band_rows(int band_rows, float scale) {
+  return std::max(1, static_cast<int>(band_rows * scale));
+}
+
+} // namespace
+
+void stream_quantize(const std::string &input, const std::string &output,
+                     int levels, int band_rows) {
+  DIP_TRACE_SCOPE("stream_quantize");
+  stream_point_op(
+      input, output,
+      [levels](const Image &src, Image &dst) { quantize(src, levels, dst); },
+      band_rows);
+}
+
+void stream_invert_image(const std::string &input, const std::string &output,
+                         int max_gray, int band_rows) {
+  DIP_TRACE_SCOPE("stream_invert_image");
+  stream_point_op(input, output,
+                  [max_gray](const Image &src, Image &dst) {
+                    invert_image(src, max_gray, dst);
+                  },
+                  band_rows);
+}
+
+void stream_set_complement(const std::string &input,
+                           const std::string &output, int K, int band_rows) {
+  DIP_TRACE_SCOPE("stream_set_complement");
+  stream_point_op(
+      input, output,
+      [K](const Image &src, Image &dst) { set_complement(src, K, dst); },
+      band_rows);
+}
+
+void stream_downsample(const std::string &input, const std::string &output,
+                       int factor, int band_rows) {
+  DIP_TRACE_SCOPE("stream_downsample");
+  DIP_MEMORY_SCOPE("stream_downsample");
+  if (factor <= 1) {
+    stream_point_op(
+        input, output, [](const Image &src, Image &dst) { dst = src; },
+        band_rows);
+    return;
+  }
+
+  // 每个行带包含整数个 factor 行的输入块
+  const int out_band = std::max(1, band_rows / factor);
+  StripReader reader;
+  StripWriter writer;
+  detail::open_input(input, out_band * factor, 0, reader);
+  const int out_height = reader.height() / factor;
+  detail::open_output(output, reader.width() / factor, out_height,
+                      reader.channels(), writer);
+
+  Band band;
+  Image result;
+  for (int oy = 0; oy < out_height; oy += out_band) {
+    const int rows = std::min(out_band, out_height - oy);
+    reader.read_band(oy * factor, rows * factor, band);
+    downsample(band.image, factor, result);
+    writer.write(result);
+  }
+  detail::close_output(writer, output);
+}
+
+void stream_bilinear_zoom(const std::string &input, const std::string &output,
+                          float scale, int band_rows) {
+  DIP_TRACE_SCOPE("stream_bilinear_zoom");
+  DIP_MEMORY_SCOPE("stream_bilinear_zoom");
+  if (scale <= 0.0f) {
+    throw std::invalid_argument("Scale must be positive");
+  }
+
+  StripReader reader;
+  StripWriter writer;
+  detail::open_input(input, band_rows, 0, reader);
+  const int height = reader.height();
+  const int channels = reader.channels();
+  const int new_height = static_cast<int>(height * scale);
+  const int new_width = static_cast<int>(reader.width() * scale);
+  detail::open_output(output, new_width, new_height, channels, writer);
+
+  const int out_band = output_band_rows(band_rows, scale);
+  Band band;
+  Image result;
+  for (int oy = 0; oy < new_height; oy += out_band) {
+    const int rows = std::min(out_band, new_height - oy);
+    // 输出行 i 使用输入行 floor(i / scale) 和下一行（与 bilinear_zoom 相同）
+    const int first = std::min(
+        height - 1, static_cast<int>(std::floor(oy / scale)));
+    const int last = std::min(
+        height - 1,
+        static_cast<int>(std::floor((oy + rows - 1) / scale)) + 1);
+    reader.read_band(first, last - first + 1, band);
+    const float offset = static_cast<float>(band.image_y());
+
+    result.create(new_width, rows, channels);
+    parallel_for(0, rows, [&](int r0, int r1) {
+      for (int r = r0; r < r1; r++) {
+        // 整数偏移的减法是精确的，插值权重与整幅计算时相同
+        const float orig_y = (oy + r) / scale - offset;
+        for (int j = 0; j < new_width; j++) {
+          const float orig_x = j / scale;
+          for (int c = 0; c < channels; c++) {
+            result.at<uint8_t>(r, j, c) =
+                bilinear_interp(band.image, orig_x, orig_y, c);
+          }
+        }
+      }
+    });
+    writer.write(result);
+  }
+  detail::close_output(writer, output);
+}
+
+void stream_nearest_neighbor_zoom(const std::string &input,
+                                  const std::string &output, float scale,
+                                  int band_rows) {
+  DIP_TRACE_SCOPE("stream_nearest_neighbor_zoom");
+  DIP_MEMORY_SCOPE("stream_nearest_neighbor_zoom");
+  if (scale <= 0.0f) {
+    throw std::invalid_argument("Scale must be positive");
+  }
+
+  StripReader reader;
+  StripWriter writer;
+  detail::open_input(input, band_rows, 0, reader);
+  const int width = reader.width();
+  const int height = reader.height();
+  const int channels = reader.channels();
+  const int new_height = static_cast<int>(height * scale);
+  const int new_width = static_cast<int>(width * scale);
+  detail::open_output(output, new_width, new_height, channels, writer);
+
+  // 与 nearest_neighbor_zoom 相同的坐标映射
+  auto source_row = [&](int y) {
+    const int orig_y = static_cast<int>(std::round(y / scale));
+    return std::max(0, std::min(height - 1, orig_y));
+  };
+
+  const int out_band = output_band_rows(band_rows, scale);
+  Band band;
+  Image result;
+  for (int oy = 0; oy < new_height; oy += out_band) {
+    const int rows = std::min(out_band, new_height - oy);
+    const int first = source_row(oy);
+    const int last = source_row(oy + rows - 1);
+    reader.read_band(first, last - first + 1, band);
+
+    result.create(new_width, rows, channels);
+    parallel_for(0, rows, [&](int r0, int r1) {
+      for (int r = r0; r < r1; r++) {
+        const int y = source_row(oy + r) - band.image_y();
+        for (int x = 0; x < new_width; x++) {
+          int orig_x = static_cast<int>(std::round(x / scale));
+          orig_x = std::max(0, std::min(width - 1, orig_x));
+          for (int c = 0; c < channels; c++) {
+            result.at<uint8_t>(r, x, c) = band.image.at<uint8_t>(y, orig_x, c);
+          }
+        }
+      }
+    });
+    writer.write(result);
+  }
+  detail::close_output(writer, output);
+}
+
+} // namespace algorithms
+} // namespace dip
@@ -0,0 +1,677 @@
+// dip_bench：算法与核心操作的基准测试
+//
+// 用法：
+//   dip_bench [--sizes vga,hd,fhd,4k,8k] [--channels 1,3] [--threads 1,8]
+//             [--reps 5] [--warmup 1] [--filter name] [--out file.json]
+//             [--compare baseline.json] [--threshold 0.10]
+//             [--results current.json] [--perf] [--quick] [--list]
+//
+// 每个用例先预热，再重复运行并统计中位数/P95耗时和吞吐量（读+写字节数）
+// --perf 额外运行一轮并用硬件性能计数器统计每像素周期数、IPC等，
+// 计数器不可用时对应字段为 -1
+// 以 DIP_ENABLE_MEMORY_TRACKING 构建时，每个结果附带单次运行的Matrix分配
+// 次数和峰值占用，结束时输出各标签的内存统计
+// 结果写入JSON文件（results 数组中每个结果占一行）
+// --compare 将本次（或 --results 指定文件中的）结果与基线比较，
+// 中位数变慢超过阈值的用例视为回归，此时进程返回1
+
+#include <algorithm>
+#include <algorithms/bilinear_zoom.hpp>
+#include <algorithms/connected_components.hpp>
+#include <algorithms/connectivity.hpp>
+#include <algorithms/downsample.hpp>
+#include <algorithms/least_squares.hpp>
+#include <algorithms/nearest_neighbor_zoom.hpp>
+#include <algorithms/quantize.hpp>
+#include <algorithms/region_props.hpp>
+#include <algorithms/rotate.hpp>
+#include <algorithms/set_logical_ops.hpp>
+#include <algorithms/spatial_ops.hpp>
+#include <chrono>
+#include <cmath>
+#include <core/core.hpp>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <random>
+#include <sstream>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+using namespace dip;
+
+namespace {
+
+struct BenchSize {
+  std::string name;
+  int width;
+  int height;
+};
+
+const std::vector<BenchSize> kSizes = {{"vga", 640, 480},
+                                       {"hd", 1280, 720},
+                                       {"fhd", 1920, 1080},
+                                       {"4k", 3840, 2160},
+                                       {"8k", 7680, 4320}};
+
+struct Options {
+  std::vector<BenchSize> sizes = kSizes;
+  std::vector<int> channels = {1, 3};
+  std::vector<int> threads;
+  int reps = 5;
+  int warmup = 1;
+  std::string filter;
+  std::string out = "dip_bench_results.json";
+  std::string compare;
+  std::string results;
+  double threshold = 0.10;
+  bool perf = false;
+  bool list = false;
+};
+
+// 同一尺寸和通道数下所有用例共享的输入数据
+struct Inputs {
+  Image image;        // 随机灰度/彩色图像
+  Image binary1;      // 随机二值图（0/1）
+  Image binary2;      // 随机二值图（0/1）
+  Image mask;         // 单通道块状二值图，用于连通分量标记
+  LabelResult labels; // mask 的8-连通标记结果
+  Matrix floats;      // image 转换得到的FLOAT32矩阵
+
+  Inputs(int width, int height, int channels) {
+    std::mt19937 rng(12345);
+    image.create(width, height, channels);
+    binary1.create(width, height, channels);
+    binary2.create(width, height, channels);
+    const int row_elems = width * channels;
+    for (int y = 0; y < height; ++y) {
+      uint8_t *p = image.ptr<uint8_t>(y);
+      uint8_t *b1 = binary1.ptr<uint8_t>(y);
+      uint8_t *b2 = binary2.ptr<uint8_t>(y);
+      for (int i = 0; i < row_elems; ++i) {
+        uint32_t r = rng();
+        p[i] = static_cast<uint8_t>(r);
+        b1[i] = (r >> 8) & 1;
+        b2[i] = (r >> 9) & 1;
+      }
+    }
+
+    mask.create(width, height, 1);
+    for (int y = 0; y < height; ++y) {
+      uint8_t *row = mask.ptr<uint8_t>(y);
+      for (int x = 0; x < width; ++x) {
+        double v = std::sin(x * 0.013) + std::cos(y * 0.011) +
+                   std::sin((x + y) * 0.002);
+        row[x] = v > 0.3 ? 1 : 0;
+      }
+    }
+    labels = label_components(mask, NeighborhoodType::N8, 1);
+    floats = image.matrix().convertTo(DataType::FLOAT32);
+  }
+};
+
+size_t bytes_of(const Matrix &m) { return m.total() * m.elemSize(); }
+size_t bytes_of(const Image &img) { return bytes_of(img.matrix()); }
+
+// 基准用例：run 执行一次操作并返回读写的字节数
+struct BenchCase {
+  std::string name;
+  bool single_channel; // 只对单通道输入运行
+  std::function<size_t(const Inputs &)> run;
+};
+
+std::vector<BenchCase> make_cases() {
+  std::vector<BenchCase> cases;
+
+  // 核心操作
+  cases.push_back({"core.clone", false, [](const Inputs &in) {
+                     Image out = in.image.clone();
+                     return bytes_of(in.image) + bytes_of(out);
+                   }});
+  cases.push_back({"core.rotate90", false, [](const Inputs &in) {
+                     Image out = image_ops::rotate90(in.image);
+                     return bytes_of(in.image) + bytes_of(out);
+                   }});
+  cases.push_back({"core.flip_horizontal", false, [](const Inputs &in) {
+                     Image out = image_ops::flipHorizontal(in.image);
+                     return bytes_of(in.image) + bytes_of(out);
+                   }});
+  cases.push_back({"core.convert_u8_f32", false, [](const Inputs &in) {
+                     const Matrix &src = in.image.matrix();
+                     Matrix out = src.convertTo(DataType::FLOAT32);
+                     return bytes_of(src) + bytes_of(out);
+                   }});
+  cases.push_back({"core.convert_f32_u8", false, [](const Inputs &in) {
+                     Matrix out = in.floats.convertTo(DataType::UINT8);
+                     return bytes_of(in.floats) + bytes_of(out);
+                   }});
+  cases.push_back({"core.convert_f32_f16", false, [](const Inputs &in) {
+                     Matrix out = in.floats.convertTo(DataType::FLOAT16);
+                     return bytes_of(in.floats) + bytes_of(out);
+                   }});
+  cases.push_back({"core.add_f32", false, [](const Inputs &in) {
+                     Matrix out = matrix_ops::add(in.floats, in.floats);
+                     return 2 * bytes_of(in.floats) + bytes_of(out);
+                   }});
+
+  // 算法
+  cases.push_back({"quantize", false, [](const Inputs &in) {
+                     Image out = algorithms::quantize(in.image, 8);
+                     return bytes_of(in.image) + bytes_of(out);
+                   }});
+  cases.push_back({"downsample", false, [](const Inputs &in) {
+                     Image out = algorithms::downsample(in.image, 2);
+                     return bytes_of(in.image) + bytes_of(out);
+                   }});
+  cases.push_back({"rotate", false, [](const Inputs &in) {
+                     Image out = algorithms::rotate(in.image, M_PI / 6);
+                     return bytes_of(in.image) + bytes_of(out);
+                   }});
+  cases.push_back({"bilinear_zoom", false, [](const Inputs &in) {
+                     Image out = algorithms::bilinear_zoom(in.image, 1.5f);
+                     return bytes_of(in.image) + bytes_of(out);
+                   }});
+  cases.push_back({"nearest_neighbor_zoom", false, [](const Inputs &in) {
+                     Image out =
+                         algorithms::nearest_neighbor_zoom(in.image, 1.5f);
+                     return bytes_of(in.image) + bytes_of(out);
+                   }});
+  cases.push_back({"invert_image", false, [](const Inputs &in) {
+                     Image out = invert_image(in.image);
+                     return bytes_of(in.image) + bytes_of(out);
+                   }});
+  cases.push_back({"set_complement", false, [](const Inputs &in) {
+                     Image out = set_complement(in.image);
+                     return bytes_of(in.image) + bytes_of(out);
+                   }});
+  cases.push_back({"logical_and", false, [](const Inputs &in) {
+                     Image out = logical_and(in.binary1, in.binary2);
+                     return 2 * bytes_of(in.binary1) + bytes_of(out);
+                   }});
+  cases.push_back({"logical_xor", false, [](const Inputs &in) {
+                     Image out = logical_xor(in.binary1, in.binary2);
+                     return 2 * bytes_of(in.binary1) + bytes_of(out);
+                   }});
+  cases.push_back({"label_components", true, [](const Inputs &in) {
+                     LabelResult out =
+                         label_components(in.mask, NeighborhoodType::N8, 1);
+                     return bytes_of(in.mask) + bytes_of(out.labels);
+                   }});
+  cases.push_back({"label_components_parallel", true, [](const Inputs &in) {
+                     LabelResult out = label_components_parallel(
+                         in.mask, NeighborhoodType::N8, 1);
+                     return bytes_of(in.mask) + bytes_of(out.labels);
+                   }});
+  cases.push_back({"region_props", true, [](const Inputs &in) {
+                     RegionProps out = region_props(in.labels, in.image);
+                     return bytes_of(in.labels.labels) + bytes_of(in.image);
+                   }});
+
+  // 逐像素的邻域查询（调用开销为主）
+  cases.push_back({"get_neighbors", true, [](const Inputs &in) {
+                     NeighborBuffer neighbors;
+                     for (int y = 0; y < in.mask.height(); ++y) {
+                       for (int x = 0; x < in.mask.width(); ++x)
+                         get_neighbors(in.mask, x, y, NeighborhoodType::N8,
+                                       neighbors);
+                     }
+                     return bytes_of(in.mask);
+                   }});
+  cases.push_back({"is_connected", true, [](const Inputs &in) {
+                     for (int y = 0; y < in.mask.height(); ++y) {
+                       for (int x = 0; x < in.mask.width(); ++x)
+                         is_connected(in.mask, x, y, x + 1, y + 1,
+                                      NeighborhoodType::N8, 1);
+                     }
+                     return bytes_of(in.mask);
+                   }});
+
+  // 逐行三次多项式拟合（行内灰度趋势）
+  cases.push_back({"polynomial_fit", true, [](const Inputs &in) {
+                     const int width = in.image.width();
+                     std::vector<double> xs(width), ys(width);
+                     for (int x = 0; x < width; ++x)
+                       xs[x] = static_cast<double>(x) / width;
+                     for (int y = 0; y < in.image.height(); ++y) {
+                       const uint8_t *row = in.image.ptr<uint8_t>(y);
+                       for (int x = 0; x < width; ++x)
+                         ys[x] = row[x];
+                       algorithms::polynomial_fit(xs, ys, 3);
+                     }
+                     return bytes_of(in.image);
+                   }});
+
+  return cases;
+}
+
+struct BenchResult {
+  std::string name;
+  std::string size;
+  int width = 0;
+  int height = 0;
+  int channels = 0;
+  int threads = 0;
+  int reps = 0;
+  double median_ms = 0;
+  double p95_ms = 0;
+  double min_ms = 0;
+  double mean_ms = 0;
+  size_t bytes = 0;
+  bool has_perf = false;
+  PerfSample perf; // 每次运行的平均计数
+  bool has_memory = false;
+  size_t peak_alloc_bytes = 0; // 计时运行期间超出运行前占用的峰值
+  size_t allocs_per_run = 0;
+
+  double gbps() const {
+    return median_ms > 0 ? bytes / (median_ms * 1e-3) / 1e9 : 0;
+  }
+  double mpix_per_s() const {
+    return median_ms > 0 ? width * static_cast<double>(height) /
+                               (median_ms * 1e-3) / 1e6
+                         : 0;
+  }
+
+  // 用于与基线匹配的键
+  std::string key() const {
+    return name + "/" + std::to_string(width) + "x" + std::to_string(height) +
+           "x" + std::to_string(channels) + "/t" + std::to_string(threads);
+  }
+};
+
+// 最近秩法百分位数（times 已排序）
+double percentile(const std::vector<double> &times, double p) {
+  size_t rank = static_cast<size_t>(std::ceil(p * times.size()));
+  return times[std::min(times.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+BenchResult run_case(const BenchCase &bench, const Inputs &in,
+                     const BenchSize &size, int channels, int threads,
+                     const Options &opt) {
+  BenchResult r;
+  r.name = bench.name;
+  r.size = size.name;
+  r.width = size.width;
+  r.height = size.height;
+  r.channels = channels;
+  r.threads = threads;
+  r.reps = opt.reps;
+
+  for (int i = 0; i < opt.warmup; ++i) {
+    bench.run(in);
+  }
+
+  std::vector<double> times;
+  times.reserve(opt.reps);
+  memory::reset_peak();
+  const memory::MemoryStats mem_before = memory::stats();
+  for (int i = 0; i < opt.reps; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    r.bytes = bench.run(in);
+    auto end = std::chrono::steady_clock::now();
+    times.push_back(std::chrono::duration<double, std::milli>(end - start)
+                        .count());
+  }
+  if (memory::compiled_in()) {
+    const memory::MemoryStats mem_after = memory::stats();
+    r.has_memory = true;
+    r.peak_alloc_bytes = mem_after.peak_bytes - mem_before.current_bytes;
+    r.allocs_per_run =
+        (mem_after.allocations - mem_before.allocations) / opt.reps;
+  }
+
+  std::sort(times.begin(), times.end());
+  r.median_ms = times.size() % 2
+                    ? times[times.size() / 2]
+                    : (times[times.size() / 2 - 1] + times[times.size() / 2]) /
+                          2;
+  r.p95_ms = percentile(times, 0.95);
+  r.min_ms = times.front();
+  double total = 0;
+  for (double t : times)
+    total += t;
+  r.mean_ms = total / times.size();
+
+  if (opt.perf) {
+    // 计时之外单独运行一轮，避免计数器的开销影响耗时统计
+    PerfCounters counters;
+    counters.start();
+    for (int i = 0; i < opt.reps; ++i) {
+      bench.run(in);
+    }
+    r.perf = counters.stop();
+    r.has_perf = true;
+    for (int64_t *v : {&r.perf.task_clock_ns, &r.perf.cycles,
+                       &r.perf.instructions, &r.perf.llc_misses,
+                       &r.perf.branch_misses}) {
+      if (*v > 0)
+        *v /= opt.reps;
+    }
+    r.perf.seconds /= opt.reps;
+  }
+  return r;
+}
+
+std::string to_json(const BenchResult &r) {
+  std::ostringstream os;
+  os << "{\"name\":\"" << r.name << "\",\"size\":\"" << r.size
+     << "\",\"width\":" << r.width << ",\"height\":" << r.height
+     << ",\"channels\":" << r.channels << ",\"threads\":" << r.threads
+     << ",\"reps\":" << r.reps << ",\"median_ms\":" << r.median_ms
+     << ",\"p95_ms\":" << r.p95_ms << ",\"min_ms\":" << r.min_ms
+     << ",\"mean_ms\":" << r.mean_ms << ",\"bytes\":" << r.bytes
+     << ",\"gb_per_s\":" << r.gbps() << ",\"mpix_per_s\":" << r.mpix_per_s();
+  if (r.has_perf) {
+    const double pixels = r.width * static_cast<double>(r.height);
+    os << ",\"cpu_ms\":"
+       << (r.perf.task_clock_ns >= 0 ? r.perf.task_clock_ns / 1e6 : -1.0)
+       << ",\"cycles\":" << r.perf.cycles
+       << ",\"instructions\":" << r.perf.instructions
+       << ",\"llc_misses\":" << r.perf.llc_misses
+       << ",\"branch_misses\":" << r.perf.branch_misses
+       << ",\"cycles_per_pixel\":" << r.perf.cycles_per_pixel(pixels)
+       << ",\"ipc\":" << r.perf.ipc()
+       << ",\"llc_misses_per_pixel\":"
+       << r.perf.llc_misses_per_pixel(pixels);
+  }
+  if (r.has_memory) {
+    os << ",\"peak_alloc_bytes\":" << r.peak_alloc_bytes
+       << ",\"allocs_per_run\":" << r.allocs_per_run;
+  }
+  os << "}";
+  return os.str();
+}
+
+bool write_json(const std::string &path, const std::vector<BenchResult> &all) {
+  std::ofstream file(path);
+  if (!file.is_open())
+    return false;
+  file << "{\"cpu_level\":\"" << cpu_level_name(cpu_level())
+       << "\",\"hardware_threads\":" << ThreadPool::default_thread_count()
+       << ",\"results\":[\n";
+  for (size_t i = 0; i < all.size(); ++i) {
+    file << to_json(all[i]) << (i + 1 < all.size() ? ",\n" : "\n");
+  }
+  file << "]}\n";
+  return true;
+}
+
+// 输出各标签的Matrix内存统计（未开启内存统计时不输出）
+void log_memory_stats() {
+  if (!memory::compiled_in())
+    return;
+  const memory::MemoryStats total = memory::stats();
+  spdlog::info("=== Matrix 内存统计 ===");
+  spdlog::info("{:<28} {:>10} {:>10} {:>12} {:>10}", "tag", "current MB",
+               "peak MB", "allocations", "largest MB");
+  auto row = [](const std::string &tag, const memory::MemoryStats &s) {
+    spdlog::info("{:<28} {:>10.2f} {:>10.2f} {:>12} {:>10.2f}", tag,
+                 s.current_bytes / 1e6, s.peak_bytes / 1e6, s.allocations,
+                 s.largest_allocation / 1e6);
+  };
+  for (const auto &t : memory::tag_stats())
+    row(t.tag, t.stats);
+  row("total", total);
+}
+
+// 解析 write_json 写出的单行结果对象（只包含字符串和数字字段）
+bool parse_result_line(const std::string &line, BenchResult &r) {
+  std::map<std::string, std::string> fields;
+  size_t pos = 0;
+  while ((pos = line.find('"', pos)) != std::string::npos) {
+    size_t key_end = line.find('"', pos + 1);
+    if (key_end == std::string::npos || key_end + 1 >= line.size() ||
+        line[key_end + 1] != ':')
+      break;
+    std::string key = line.substr(pos + 1, key_end - pos - 1);
+    size_t v = key_end + 2;
+    std::string value;
+    if (v < line.size() && line[v] == '"') {
+      size_t v_end = line.find('"', v + 1);
+      value = line.substr(v + 1, v_end - v - 1);
+      pos = v_end + 1;
+    } else {
+      size_t v_end = line.find_first_of(",}", v);
+      value = line.substr(v, v_end - v);
+      pos = v_end;
+    }
+    fields[key] = value;
+  }
+  if (!fields.count("name") || !fields.count("median_ms"))
+    return false;
+
+  r.name = fields["name"];
+  r.size = fields["size"];
+  r.width = std::stoi(fields["width"]);
+  r.height = std::stoi(fields["height"]);
+  r.channels = std::stoi(fields["channels"]);
+  r.threads = std::stoi(fields["threads"]);
+  r.median_ms = std::stod(fields["median_ms"]);
+  r.p95_ms = std::stod(fields["p95_ms"]);
+  return true;
+}
+
+bool read_json(const std::string &path, std::vector<BenchResult> &all) {
+  std::ifstream file(path);
+  if (!file.is_open())
+    return false;
+  std::string line;
+  while (std::getline(file, line)) {
+    BenchResult r;
+    if (line.find("\"name\"") != std::string::npos &&
+        parse_result_line(line, r))
+      all.push_back(r);
+  }
+  return true;
+}
+
+// 返回回归用例数
+int compare_results(const std::vector<BenchResult> &baseline,
+                    const std::vector<BenchResult> &current,
+                    double threshold) {
+  std::map<std::string, BenchResult> base;
+  for (const auto &r : baseline)
+    base[r.key()] = r;
+
+  int regressions = 0, improvements = 0, matched = 0;
+  for (const auto &r : current) {
+    auto it = base.find(r.key());
+    if (it == base.end())
+      continue;
+    ++matched;
+    double ratio = r.median_ms / it->second.median_ms;
+    if (ratio > 1.0 + threshold) {
+      ++regressions;
+      spdlog::warn("回归 {:<48} {:>9.3f} ms -> {:>9.3f} ms ({:+.1f}%)",
+                   r.key(), it->second.median_ms, r.median_ms,
+                   (ratio - 1.0) * 100);
+    } else if (ratio < 1.0 - threshold) {
+      ++improvements;
+      spdlog::info("提升 {:<48} {:>9.3f} ms -> {:>9.3f} ms ({:+.1f}%)",
+                   r.key(), it->second.median_ms, r.median_ms,
+                   (ratio - 1.0) * 100);
+    }
+  }
+  spdlog::info("对比 {} 个用例（阈值 {:.0f}%）：回归 {}，提升 {}", matched,
+               threshold * 100, regressions, improvements);
+  return regressions;
+}
+
+std::vector<std::string> split(const std::string &s) {
+  std::vector<std::string> parts;
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty())
+      parts.push_back(item);
+  }
+  return parts;
+}
+
+bool parse_args(int argc, char *argv[], Options &opt) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto value = [&]() -> std::string {
+      if (i + 1 >= argc)
+        throw std::invalid_argument("Missing value for " + arg);
+      return argv[++i];
+    };
+
+    if (arg == "--sizes") {
+      opt.sizes.clear();
+      for (const auto &name : split(value())) {
+        auto it =
+            std::find_if(kSizes.begin(), kSizes.end(),
+                         [&](const BenchSize &s) { return s.name == name; });
+        if (it == kSizes.end())
+          throw std::invalid_argument("Unknown size: " + name);
+        opt.sizes.push_back(*it);
+      }
+    } else if (arg == "--channels") {
+      opt.channels.clear();
+      for (const auto &c : split(value()))
+        opt.channels.push_back(std::stoi(c));
+    } else if (arg == "--threads") {
+      opt.threads.clear();
+      for (const auto &t : split(value()))
+        opt.threads.push_back(std::stoi(t));
+    } else if (arg == "--reps") {
+      opt.reps = std::max(1, std::stoi(value()));
+    } else if (arg == "--warmup") {
+      opt.warmup = std::max(0, std::stoi(value()));
+    } else if (arg == "--filter") {
+      opt.filter = value();
+    } else if (arg == "--out") {
+      opt.out = value();
+    } else if (arg == "--compare") {
+      opt.compare = value();
+    } else if (arg == "--results") {
+      opt.results = value();
+    } else if (arg == "--threshold") {
+      opt.threshold = std::stod(value());
+    } else if (arg == "--quick") {
+      opt.sizes = {kSizes[0], kSizes[2]};
+      opt.reps = 3;
+    } else if (arg == "--perf") {
+      opt.perf = true;
+    } else if (arg == "--list") {
+      opt.list = true;
+    } else {
+      throw std::invalid_argument("Unknown option: " + arg);
+    }
+  }
+
+  if (opt.threads.empty()) {
+    opt.threads.push_back(1);
+    if (get_num_threads() > 1)
+      opt.threads.push_back(get_num_threads());
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  spdlog::set_level(spdlog::level::info);
+
+  Options opt;
+  try {
+    parse_args(argc, argv, opt);
+  } catch (const std::exception &e) {
+    spdlog::error("{}", e.what());
+    return 2;
+  }
+
+  const std::vector<BenchCase> cases = make_cases();
+  if (opt.list) {
+    for (const auto &c : cases)
+      spdlog::info("{}{}", c.name, c.single_channel ? "（仅单通道）" : "");
+    return 0;
+  }
+
+  std::vector<BenchResult> all;
+  if (!opt.results.empty()) {
+    // 只比较已有结果文件，不运行基准测试
+    if (!read_json(opt.results, all)) {
+      spdlog::error("Failed to read results: {}", opt.results);
+      return 2;
+    }
+  } else {
+    cpu_level(); // 先输出SIMD级别，之后只保留警告以免算法日志干扰计时
+    if (opt.perf) {
+      PerfCounters probe;
+      probe.start();
+      probe.stop();
+      if (!PerfCounters::hardware_available())
+        spdlog::warn("硬件性能计数器不可用，只记录CPU时间: {}", probe.error());
+    }
+    const int default_threads = get_num_threads();
+
+    for (const auto &size : opt.sizes) {
+      for (int channels : opt.channels) {
+        spdlog::info("=== {} {}x{}x{} ===", size.name, size.width,
+                     size.height, channels);
+        spdlog::set_level(spdlog::level::warn);
+        Inputs in(size.width, size.height, channels);
+
+        for (const auto &bench : cases) {
+          if (bench.single_channel && channels != 1)
+            continue;
+          if (!opt.filter.empty() &&
+              bench.name.find(opt.filter) == std::string::npos)
+            continue;
+
+          for (int threads : opt.threads) {
+            set_num_threads(threads);
+            BenchResult r = run_case(bench, in, size, channels, threads, opt);
+            all.push_back(r);
+
+            spdlog::set_level(spdlog::level::info);
+            spdlog::info("{:<28} t={:<2} median {:>9.3f} ms  p95 {:>9.3f} ms "
+                         " {:>7.2f} GB/s  {:>8.1f} MP/s",
+                         r.name, threads, r.median_ms, r.p95_ms, r.gbps(),
+                         r.mpix_per_s());
+            if (r.has_perf && r.perf.has_hardware()) {
+              const double pixels =
+                  size.width * static_cast<double>(size.height);
+              spdlog::info("{:<28} cpu {:>9.3f} ms  {:>7.2f} cycles/px  IPC "
+                           "{:>5.2f}  LLC miss/px {:>6.4f}",
+                           "", r.perf.task_clock_ns / 1e6,
+                           r.perf.cycles_per_pixel(pixels), r.perf.ipc(),
+                           r.perf.llc_misses_per_pixel(pixels));
+            } else if (r.has_perf) {
+              spdlog::info("{:<28} cpu {:>9.3f} ms", "",
+                           r.perf.task_clock_ns / 1e6);
+            }
+            if (r.has_memory) {
+              spdlog::info("{:<28} peak {:>9.2f} MB  {} allocs/run", "",
+                           r.peak_alloc_bytes / 1e6, r.allocs_per_run);
+            }
+            spdlog::set_level(spdlog::level::warn);
+          }
+        }
+        spdlog::set_level(spdlog::level::info);
+      }
+    }
+    set_num_threads(default_threads);
+    log_memory_stats();
+
+    if (!write_json(opt.out, all)) {
+      spdlog::error("Failed to write results: {}", opt.out);
+      return 2;
+    }
+    spdlog::info("{} 个结果已写入 {}", all.size(), opt.out);
+  }
+
+  if (!opt.compare.empty()) {
+    std::vector<BenchResult> baseline;
+    if (!read_json(opt.compare, baseline)) {
+      spdlog::error("Failed to read baseline: {}", opt.compare);
+      return 2;
+    }
+    if (compare_results(baseline, all, opt.threshold) > 0)
+      return 1;
+  }
+  return 0;
+}
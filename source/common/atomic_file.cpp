@@ -0,0 +1,74 @@
+#include <core/atomic_file.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define DIP_HAVE_GETPID 1
+#endif
+
+namespace dip {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// 同一进程内各次写入使用不同的临时文件名
+std::string temp_suffix() {
+  static std::atomic<unsigned> counter{0};
+  std::string suffix = ".tmp";
+#if defined(DIP_HAVE_GETPID)
+  suffix += std::to_string(static_cast<long>(getpid()));
+  suffix += '_';
+#endif
+  suffix += std::to_string(counter.fetch_add(1));
+  return suffix;
+}
+
+} // namespace
+
+void AtomicFile::reset(const std::string &target) {
+  discard();
+  std::error_code ec;
+  std::string resolved = target;
+  if (fs::is_symlink(target, ec)) {
+    const fs::path canonical = fs::canonical(target, ec);
+    if (!ec)
+      resolved = canonical.string();
+  }
+  target_ = resolved;
+  const fs::file_status status = fs::status(resolved, ec);
+  if (fs::exists(status) && !fs::is_regular_file(status))
+    path_ = resolved; // 设备、管道等：rename 会替换掉它们，直接写入
+  else
+    path_ = resolved + temp_suffix();
+}
+
+bool AtomicFile::commit(std::string *error) {
+  if (path_.empty() || path_ == target_) {
+    path_.clear();
+    return true;
+  }
+  std::error_code ec;
+  fs::rename(path_, target_, ec);
+  if (ec) {
+    if (error)
+      *error = "cannot replace '" + target_ + "': " + ec.message();
+    discard();
+    return false;
+  }
+  path_.clear();
+  return true;
+}
+
+void AtomicFile::discard() {
+  if (!path_.empty() && path_ != target_) {
+    std::error_code ec;
+    fs::remove(path_, ec);
+  }
+  path_.clear();
+}
+
+} // namespace dip
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <core/cpu_features.hpp>
+#include <cstdlib>
+#include <spdlog/spdlog.h>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define DIP_CPU_X86 1
+#endif
+
+namespace dip {
+
+namespace {
+
+#if defined(DIP_CPU_X86)
+// 读取XCR0，确认操作系统会保存对应的向量寄存器状态
+unsigned long long read_xcr0() {
+  unsigned int eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<unsigned long long>(edx) << 32) | eax;
+}
+#endif
+
+bool parse_level(std::string name, CpuLevel &level) {
+  std::transform(name.begin(), name.end(), name.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  for (CpuLevel l : {CpuLevel::SCALAR, CpuLevel::SSE2, CpuLevel::AVX2,
+                     CpuLevel::AVX512}) {
+    if (name == cpu_level_name(l)) {
+      level = l;
+      return true;
+    }
+  }
+  return false;
+}
+
+CpuLevel initial_level() {
+  const CpuLevel detected = detect_cpu_level();
+  CpuLevel level = detected;
+
+  if (const char *env = std::getenv("DIP_CPU_LEVEL")) {
+    CpuLevel requested;
+    if (!parse_level(env, requested)) {
+      spdlog::warn("Unknown DIP_CPU_LEVEL '{}', using {}", env,
+                   cpu_level_name(detected));
+    } else if (requested > detected) {
+      spdlog::warn("DIP_CPU_LEVEL={} is not supported by this CPU, using {}",
+                   env, cpu_level_name(detected));
+    } else {
+      level = requested;
+    }
+  }
+
+  spdlog::info("SIMD kernels: {} (CPU supports {})", cpu_level_name(level),
+               cpu_level_name(detected));
+  return level;
+}
+
+std::atomic<CpuLevel> &active_level() {
+  static std::atomic<CpuLevel> level{initial_level()};
+  return level;
+}
+
+} // namespace
+
+const char *cpu_level_name(CpuLevel level) {
+  switch (level) {
+  case CpuLevel::SCALAR:
+    return "scalar";
+  case CpuLevel::SSE2:
+    return "sse2";
+  case CpuLevel::AVX2:
+    return "avx2";
+  case CpuLevel::AVX512:
+    return "avx512";
+  }
+  return "unknown";
+}
+
+CpuLevel detect_cpu_level() {
+#if defined(DIP_CPU_X86)
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    return CpuLevel::SCALAR;
+
+  const bool sse2 = edx & (1u << 26);
+  const bool osxsave = ecx & (1u << 27);
+  const bool avx = ecx & (1u << 28);
+  const bool f16c = ecx & (1u << 29);
+  if (!sse2)
+    return CpuLevel::SCALAR;
+  if (!osxsave || !avx)
+    return CpuLevel::SSE2;
+
+  // XMM/YMM状态（位1、2），AVX-512另需opmask/ZMM状态（位5-7）
+  const unsigned long long xcr0 = read_xcr0();
+  const bool ymm_state = (xcr0 & 0x6) == 0x6;
+  const bool zmm_state = (xcr0 & 0xe6) == 0xe6;
+
+  unsigned int ebx7 = 0;
+  if (__get_cpuid_count(7, 0, &eax, &ebx7, &ecx, &edx) == 0)
+    return CpuLevel::SSE2;
+  const bool avx2 = ebx7 & (1u << 5);
+  const bool avx512f = ebx7 & (1u << 16);
+  const bool avx512bw = ebx7 & (1u << 30);
+
+  if (!ymm_state || !avx2 || !f16c)
+    return CpuLevel::SSE2;
+  if (zmm_state && avx512f && avx512bw)
+    return CpuLevel::AVX512;
+  return CpuLevel::AVX2;
+#else
+  return CpuLevel::SCALAR;
+#endif
+}
+
+CpuLevel cpu_level() { return active_level().load(std::memory_order_relaxed); }
+
+CpuLevel set_cpu_level(CpuLevel level) {
+  level = std::min(level, detect_cpu_level());
+  active_level().store(level, std::memory_order_relaxed);
+  return level;
+}
+
+} // namespace dip
@@ -0,0 +1,313 @@
+#include <core/dipm.hpp>
+#include <core/atomic_file.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define DIP_HAVE_MMAP 1
+#endif
+
+namespace dip {
+
+namespace {
+
+// 文件头布局（本机字节序）：
+//   0  "DIPM"  4  版本(u16)  6  字节序标记(u16)
+//   8  rows  12 cols  16 channels  20 DataType（u32）
+//   24 step(u64)  32 alignment(u32)  40 data_offset(u64)  48..63 保留
+constexpr char kMagic[4] = {'D', 'I', 'P', 'M'};
+constexpr uint16_t kVersion = 1;
+constexpr uint16_t kByteOrderMark = 0x0102;
+constexpr size_t kHeaderBytes = 64;
+constexpr uint32_t kAlignment = 64; // 映射地址按页对齐，数据按64字节对齐
+
+template <typename T> void put(uint8_t *header, size_t offset, T value) {
+  std::memcpy(header + offset, &value, sizeof(T));
+}
+
+template <typename T> T get(const uint8_t *header, size_t offset) {
+  T value;
+  std::memcpy(&value, header + offset, sizeof(T));
+  return value;
+}
+
+bool fail(std::string *error, const std::string &message) {
+  if (error)
+    *error = message;
+  return false;
+}
+
+bool parse_header(const uint8_t *data, size_t size, DipmHeader &header,
+                  std::string *error) {
+  if (size < kHeaderBytes || std::memcmp(data, kMagic, sizeof(kMagic)) != 0)
+    return fail(error, "not a .dipm file");
+  if (get<uint16_t>(data, 4) != kVersion)
+    return fail(error, "unsupported .dipm version");
+  if (get<uint16_t>(data, 6) != kByteOrderMark)
+    return fail(error, ".dipm file was written with another byte order");
+
+  DipmHeader h;
+  const uint32_t rows = get<uint32_t>(data, 8);
+  const uint32_t cols = get<uint32_t>(data, 12);
+  const uint32_t channels = get<uint32_t>(data, 16);
+  const uint32_t type = get<uint32_t>(data, 20);
+  h.step = get<uint64_t>(data, 24);
+  h.alignment = get<uint32_t>(data, 32);
+  h.data_offset = get<uint64_t>(data, 40);
+
+  const int elem = type <= static_cast<uint32_t>(DataType::FLOAT64)
+                       ? dataTypeSize(static_cast<DataType>(type))
+                       : 0;
+  if (rows == 0 || cols == 0 || channels == 0 || elem == 0 ||
+      rows > INT32_MAX || cols > INT32_MAX || cols % channels != 0 ||
+      h.step < static_cast<uint64_t>(cols) * elem ||
+      h.step > UINT64_MAX / rows || h.data_offset < kHeaderBytes)
+    return fail(error, "invalid .dipm header");
+
+  h.rows = static_cast<int>(rows);
+  h.cols = static_cast<int>(cols);
+  h.channels = static_cast<int>(channels);
+  h.type = static_cast<DataType>(type);
+  header = h;
+  return true;
+}
+
+// 像素数据是否完整位于大小为 size 的文件内（避免 data_offset + 数据量溢出）
+bool payload_fits(const DipmHeader &header, uint64_t size) {
+  return header.data_offset <= size &&
+         header.step <= (size - header.data_offset) /
+                            static_cast<uint64_t>(header.rows);
+}
+
+// 映射的文件；不支持 mmap 的平台上整体读入内存
+struct Mapping {
+  uint8_t *data = nullptr;
+  size_t size = 0;
+  bool mapped = false;
+  std::vector<uint8_t> buffer;
+
+  ~Mapping() {
+#if defined(DIP_HAVE_MMAP)
+    if (mapped)
+      munmap(data, size);
+#endif
+  }
+};
+
+#if defined(DIP_HAVE_MMAP)
+// 写出全部 iovec，处理部分写入和 IOV_MAX 限制
+bool write_all(int fd, std::vector<iovec> &iov) {
+  size_t first = 0;
+  while (first < iov.size()) {
+    const int count = static_cast<int>(
+        std::min(iov.size() - first, static_cast<size_t>(IOV_MAX)));
+    ssize_t written = writev(fd, iov.data() + first, count);
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    while (first < iov.size() &&
+           static_cast<size_t>(written) >= iov[first].iov_len) {
+      written -= static_cast<ssize_t>(iov[first].iov_len);
+      ++first;
+    }
+    if (first < iov.size()) {
+      iov[first].iov_base = static_cast<uint8_t *>(iov[first].iov_base) +
+                            written;
+      iov[first].iov_len -= static_cast<size_t>(written);
+    }
+  }
+  return true;
+}
+#endif
+
+} // namespace
+
+bool write_dipm(const Matrix &mat, int channels, const std::string &path,
+                std::string *error) {
+  if (mat.empty() || channels <= 0 || mat.cols() % channels != 0)
+    return fail(error, "cannot save an empty matrix or invalid channel count");
+
+  const size_t row_bytes = static_cast<size_t>(mat.cols()) * mat.elemSize();
+  uint8_t header[kHeaderBytes] = {};
+  std::memcpy(header, kMagic, sizeof(kMagic));
+  put<uint16_t>(header, 4, kVersion);
+  put<uint16_t>(header, 6, kByteOrderMark);
+  put<uint32_t>(header, 8, static_cast<uint32_t>(mat.rows()));
+  put<uint32_t>(header, 12, static_cast<uint32_t>(mat.cols()));
+  put<uint32_t>(header, 16, static_cast<uint32_t>(channels));
+  put<uint32_t>(header, 20, static_cast<uint32_t>(mat.type()));
+  put<uint64_t>(header, 24, row_bytes);
+  put<uint32_t>(header, 32, kAlignment);
+  put<uint64_t>(header, 40, kHeaderBytes);
+
+  const bool packed = mat.step() == row_bytes;
+  const auto *pixels = static_cast<const uint8_t *>(mat.data());
+
+#if defined(DIP_HAVE_MMAP)
+  // 文件头与像素数据一次写出；ROI 矩阵每行一个 iovec
+  std::vector<iovec> iov;
+  iov.reserve(packed ? 2 : 1 + mat.rows());
+  iov.push_back({header, kHeaderBytes});
+  if (packed) {
+    iov.push_back({const_cast<uint8_t *>(pixels), row_bytes * mat.rows()});
+  } else {
+    for (int y = 0; y < mat.rows(); ++y)
+      iov.push_back({const_cast<uint8_t *>(pixels + y * mat.step()),
+                     row_bytes});
+  }
+
+  // 写入临时文件后替换目标：失败时不破坏原文件，映射原文件的图像不受影响
+  AtomicFile out(path);
+  int fd = ::open(out.path().c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  0644);
+  if (fd < 0)
+    return fail(error, "cannot open '" + path + "' for writing: " +
+                           std::strerror(errno));
+  bool written = write_all(fd, iov);
+  int write_errno = errno;
+  if (::close(fd) != 0 && written) {
+    written = false;
+    write_errno = errno;
+  }
+  if (!written)
+    return fail(error, "failed to write '" + path +
+                           "': " + std::strerror(write_errno));
+#else
+  AtomicFile out(path);
+  std::ofstream file(out.path(), std::ios::binary);
+  if (!file.is_open())
+    return fail(error, "cannot open '" + path + "' for writing");
+  file.write(reinterpret_cast<const char *>(header), kHeaderBytes);
+  if (packed) {
+    file.write(reinterpret_cast<const char *>(pixels),
+               row_bytes * mat.rows());
+  } else {
+    for (int y = 0; y < mat.rows(); ++y)
+      file.write(reinterpret_cast<const char *>(pixels + y * mat.step()),
+                 row_bytes);
+  }
+  file.close();
+  if (!file)
+    return fail(error, "failed to write '" + path + "'");
+#endif
+  return out.commit(error);
+}
+
+bool read_dipm_header(const std::string &path, DipmHeader &header,
+                      std::string *error) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open())
+    return fail(error, "cannot open '" + path + "'");
+  uint8_t data[kHeaderBytes];
+  file.read(reinterpret_cast<char *>(data), kHeaderBytes);
+  const size_t size = static_cast<size_t>(file.gcount());
+  if (!parse_header(data, size, header, error)) {
+    if (error)
+      *error = "'" + path + "': " + *error;
+    return false;
+  }
+  return true;
+}
+
+std::shared_ptr<const Image> map_dipm(const std::string &path,
+                                      std::string *error) {
+  auto mapping = std::make_shared<Mapping>();
+
+#if defined(DIP_HAVE_MMAP)
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    fail(error, "cannot open '" + path + "': " + std::strerror(errno));
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    fail(error, "cannot stat '" + path + "' or file is empty");
+    ::close(fd);
+    return nullptr;
+  }
+  mapping->size = static_cast<size_t>(st.st_size);
+  // 只读映射：返回的图像为 const，需要修改时拷贝
+  void *p = mmap(nullptr, mapping->size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED) {
+    fail(error, "mmap failed for '" + path + "': " + std::strerror(errno));
+    return nullptr;
+  }
+  mapping->data = static_cast<uint8_t *>(p);
+  mapping->mapped = true;
+#else
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    fail(error, "cannot open '" + path + "'");
+    return nullptr;
+  }
+  mapping->buffer.resize(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(reinterpret_cast<char *>(mapping->buffer.data()),
+            mapping->buffer.size());
+  mapping->data = mapping->buffer.data();
+  mapping->size = mapping->buffer.size();
+#endif
+
+  DipmHeader header;
+  std::string reason;
+  if (!parse_header(mapping->data, mapping->size, header, &reason)) {
+    fail(error, "'" + path + "': " + reason);
+    return nullptr;
+  }
+  if (!payload_fits(header, mapping->size)) {
+    fail(error, "'" + path + "': .dipm file is truncated");
+    return nullptr;
+  }
+
+  Matrix mat = Matrix::fromExternal(header.rows, header.cols, header.type,
+                                    mapping->data + header.data_offset,
+                                    mapping, header.step);
+  return std::make_shared<const Image>(std::move(mat), header.channels);
+}
+
+bool read_dipm(const std::string &path, Image &dst, std::string *error) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open())
+    return fail(error, "cannot open '" + path + "'");
+  const auto size = static_cast<uint64_t>(file.tellg());
+  file.seekg(0);
+  uint8_t data[kHeaderBytes];
+  file.read(reinterpret_cast<char *>(data), kHeaderBytes);
+  DipmHeader header;
+  std::string reason;
+  if (!parse_header(data, static_cast<size_t>(file.gcount()), header,
+                    &reason))
+    return fail(error, "'" + path + "': " + reason);
+  if (!payload_fits(header, size))
+    return fail(error, "'" + path + "': .dipm file is truncated");
+
+  dst.create(header.cols / header.channels, header.rows, header.channels,
+             header.type);
+  const size_t row_bytes = static_cast<size_t>(header.cols) *
+                           dataTypeSize(header.type);
+  for (int y = 0; y < header.rows && file; ++y) {
+    if (header.step != row_bytes || y == 0)
+      file.seekg(static_cast<std::streamoff>(header.data_offset +
+                                             y * header.step));
+    file.read(reinterpret_cast<char *>(dst.ptr<uint8_t>(y)),
+              static_cast<std::streamsize>(row_bytes));
+  }
+  if (!file)
+    return fail(error, "failed to read '" + path + "'");
+  return true;
+}
+
+} // namespace dip
@@ -0,0 +1,626 @@
+#include <core/dipz.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <core/parallel.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace dip {
+
+namespace {
+
+// 文件头布局（本机字节序）：
+//   0  "DIPZ"  4  版本(u16)  6  字节序标记(u16)
+//   8  height  12 width  16 channels  20 DataType  24 block_rows
+//   28 block_count（u32）  32..63 保留
+// 之后是 block_count 个 u64 的块长度，然后依次是各块数据
+constexpr char kMagic[4] = {'D', 'I', 'P', 'Z'};
+constexpr uint16_t kVersion = 1;
+constexpr uint16_t kByteOrderMark = 0x0102;
+constexpr size_t kHeaderBytes = 64;
+constexpr size_t kAutoBlockBytes = size_t(256) << 10;
+
+// 块的第一个字节：编码数据或原样存储
+constexpr uint8_t kBlockCoded = 0;
+constexpr uint8_t kBlockStored = 1;
+
+// 行预测方式（每行2位）
+constexpr uint32_t kLeft = 0;
+constexpr uint32_t kUp = 1;
+constexpr uint32_t kPaeth = 2;
+
+constexpr int kChunk = 64;          // 每段样本数，每段选择一次 Rice 参数
+constexpr uint32_t kZeroChunk = 63; // 全零段的参数编码（6位）
+constexpr uint32_t kEscape = 24;    // 商达到此值时直接存储样本
+
+template <typename T> void put(uint8_t *header, size_t offset, T value) {
+  std::memcpy(header + offset, &value, sizeof(T));
+}
+
+template <typename T> T get(const uint8_t *header, size_t offset) {
+  T value;
+  std::memcpy(&value, header + offset, sizeof(T));
+  return value;
+}
+
+bool fail(std::string *error, const std::string &message) {
+  if (error)
+    *error = message;
+  return false;
+}
+
+inline uint64_t load_be64(const uint8_t *p) {
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+#if defined(__GNUC__) || defined(__clang__)
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  v = __builtin_bswap64(v);
+#endif
+#else
+  v = 0;
+  for (int i = 0; i < 8; ++i)
+    v = v << 8 | p[i];
+#endif
+  return v;
+}
+
+inline int leading_zeros(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_clzll(v);
+#else
+  int n = 0;
+  while (!(v & (uint64_t(1) << 63))) {
+    v <<= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+template <typename T> constexpr int sample_bits() {
+  return static_cast<int>(sizeof(T) * 8);
+}
+
+// ---------------------------------------------------------------------------
+// 位读写（高位在前）
+
+class BitWriter {
+public:
+  explicit BitWriter(uint8_t *begin) : p_(begin), begin_(begin) {}
+
+  // value 必须小于 2^bits，bits <= 32；每凑满32位写出4字节
+  void put(uint32_t value, int bits) {
+    acc_ = acc_ << bits | value;
+    count_ += bits;
+    if (count_ >= 32) {
+      count_ -= 32;
+      const uint32_t word = static_cast<uint32_t>(acc_ >> count_);
+      p_[0] = static_cast<uint8_t>(word >> 24);
+      p_[1] = static_cast<uint8_t>(word >> 16);
+      p_[2] = static_cast<uint8_t>(word >> 8);
+      p_[3] = static_cast<uint8_t>(word);
+      p_ += 4;
+    }
+  }
+
+  void put64(uint64_t value, int bits) {
+    if (bits > 32) {
+      put(static_cast<uint32_t>(value >> 32), bits - 32);
+      bits = 32;
+    }
+    put(static_cast<uint32_t>(value), bits);
+  }
+
+  size_t size() const { return static_cast<size_t>(p_ - begin_); }
+
+  // 写出剩余的位并补齐最后一个字节，返回写入的字节数
+  size_t finish() {
+    for (; count_ >= 8; count_ -= 8)
+      *p_++ = static_cast<uint8_t>(acc_ >> (count_ - 8));
+    if (count_ > 0)
+      *p_++ = static_cast<uint8_t>(acc_ << (8 - count_));
+    count_ = 0;
+    return size();
+  }
+
+private:
+  uint8_t *p_;
+  uint8_t *begin_;
+  uint64_t acc_ = 0;
+  int count_ = 0;
+};
+
+class BitReader {
+public:
+  BitReader(const uint8_t *begin, const uint8_t *end) : p_(begin), end_(end) {}
+
+  // bits <= 32
+  uint32_t get(int bits) {
+    if (bits == 0)
+      return 0;
+    refill();
+    const uint32_t value = static_cast<uint32_t>(acc_ >> (64 - bits));
+    acc_ <<= bits;
+    count_ -= bits;
+    return value;
+  }
+
+  uint64_t get64(int bits) {
+    if (bits > 32) {
+      const uint64_t high = get(bits - 32);
+      return high << 32 | get(32);
+    }
+    return get(bits);
+  }
+
+  /**
+   * 读取一个参数为 k 的 Rice 编码值：q 个0、一个1、k 位余数；
+   * q 等于 kEscape 时其后是样本的全部位。超过 kEscape 个0时返回 false
+   */
+  template <typename T> bool rice(uint32_t k, T &value) {
+    // 缓冲的位不少于32时不装入，8/16位样本的大多数值可以直接读完
+    if (count_ < 32)
+      refill();
+    uint32_t q = static_cast<uint32_t>(
+        leading_zeros(acc_ | uint64_t(1) << (63 - kEscape)));
+    if (q + 1 + k > static_cast<uint32_t>(count_)) {
+      refill();
+      q = static_cast<uint32_t>(
+          leading_zeros(acc_ | uint64_t(1) << (63 - kEscape)));
+    }
+    if (q == kEscape && ((acc_ >> (63 - q)) & 1) == 0)
+      return false;
+    if (q < kEscape && q + 1 + k <= static_cast<uint32_t>(count_)) {
+      const uint64_t rest = acc_ << (q + 1);
+      value = static_cast<T>(uint64_t(q) << k | (rest >> 1) >> (63 - k));
+      acc_ = rest << k;
+      count_ -= static_cast<int>(q + 1 + k);
+      return true;
+    }
+    acc_ <<= q + 1;
+    count_ -= static_cast<int>(q + 1);
+    value = q < kEscape
+                ? static_cast<T>(uint64_t(q) << k |
+                                 get64(static_cast<int>(k)))
+                : static_cast<T>(get64(sample_bits<T>()));
+    return true;
+  }
+
+  // 是否读到了数据末尾之后
+  bool overrun() const { return padding_ * 8 > count_; }
+
+private:
+  void refill() {
+    if (count_ > 56)
+      return;
+    if (end_ - p_ >= 8) {
+      // 一次装入整字节；不完整字节的高位与下次装入的内容相同
+      acc_ |= load_be64(p_) >> count_;
+      const int bytes = (63 - count_) >> 3;
+      p_ += bytes;
+      count_ += bytes * 8;
+      return;
+    }
+    while (count_ <= 56) {
+      uint64_t byte = 0;
+      if (p_ < end_)
+        byte = *p_++;
+      else
+        ++padding_;
+      acc_ |= byte << (56 - count_);
+      count_ += 8;
+    }
+  }
+
+  const uint8_t *p_;
+  const uint8_t *end_;
+  uint64_t acc_ = 0;
+  int count_ = 0;
+  int padding_ = 0;
+};
+
+// ---------------------------------------------------------------------------
+// 预测与残差（样本按无符号整数处理，残差模 2^n）
+
+// 残差的绝对值：d 与 -d 中较小者
+template <typename T> inline uint64_t magnitude(T d) {
+  return std::min(d, static_cast<T>(T(0) - d));
+}
+
+template <typename T> inline T zigzag(T d) {
+  using S = std::make_signed_t<T>;
+  const S s = static_cast<S>(d);
+  return static_cast<T>(static_cast<T>(d << 1) ^
+                        static_cast<T>(s >> (sample_bits<T>() - 1)));
+}
+
+template <typename T> inline T unzigzag(T z) {
+  return static_cast<T>((z >> 1) ^ static_cast<T>(T(0) - (z & 1)));
+}
+
+// 与PNG相同的 Paeth 预测，写成无分支形式（噪声数据上分支难以预测）
+// 64位样本需要更宽的整数，不使用
+template <typename T> inline T paeth(T a, T b, T c) {
+  using W = std::conditional_t<(sizeof(T) < 4), int32_t, int64_t>;
+  const W pa = std::abs(W(b) - W(c));
+  const W pb = std::abs(W(a) - W(c));
+  const W pc = std::abs(W(a) + W(b) - 2 * W(c));
+  // 用掩码选择，避免编译器生成分支
+  const W use_b = -static_cast<W>(pb < pa);
+  const W best = W(a) ^ ((W(a) ^ W(b)) & use_b);
+  const W best_p = pa ^ ((pa ^ pb) & use_b);
+  const W use_c = -static_cast<W>(pc < best_p);
+  return static_cast<T>(best ^ ((best ^ W(c)) & use_c));
+}
+
+template <typename T> constexpr uint32_t max_rice_k() {
+  return std::min(sample_bits<T>() - 1, 62);
+}
+
+template <typename T> void put_chunk(const T *v, int n, BitWriter &writer) {
+  // 在局部副本上写入，编译器不必担心字节写入与写入器状态重叠
+  BitWriter out = writer;
+  uint64_t sum = 0;
+  if constexpr (sizeof(T) < 8) {
+    for (int i = 0; i < n; ++i)
+      sum += v[i];
+  } else {
+    for (int i = 0; i < n; ++i) {
+      const uint64_t next = sum + v[i];
+      sum = next < sum ? UINT64_MAX : next;
+    }
+  }
+  if (sum == 0) {
+    out.put(kZeroChunk, 6);
+    writer = out;
+    return;
+  }
+  // 参数取残差均值的位数
+  uint32_t k = 0;
+  while (k < max_rice_k<T>() && (sum >> (k + 1)) >= static_cast<uint64_t>(n))
+    ++k;
+  out.put(k, 6);
+  const uint64_t mask = (uint64_t(1) << k) - 1;
+  for (int i = 0; i < n; ++i) {
+    const uint64_t q = static_cast<uint64_t>(v[i]) >> k;
+    const int length = static_cast<int>(q + 1 + k);
+    if (q < kEscape && length <= 32) {
+      out.put(static_cast<uint32_t>(uint64_t(1) << k | (v[i] & mask)),
+              length);
+    } else if (q < kEscape) {
+      out.put(1, static_cast<int>(q + 1));
+      out.put64(v[i] & mask, static_cast<int>(k));
+    } else {
+      out.put(1, kEscape + 1);
+      out.put64(v[i], sample_bits<T>());
+    }
+  }
+  writer = out;
+}
+
+template <typename T> bool get_chunk(T *v, int n, BitReader &reader) {
+  // 在局部副本上读取，写入 v 时编译器不必重新载入读取器状态
+  BitReader in = reader;
+  const uint32_t k = in.get(6);
+  if (k == kZeroChunk) {
+    std::fill(v, v + n, T(0));
+  } else if (k > max_rice_k<T>()) {
+    return false;
+  } else {
+    for (int i = 0; i < n; ++i) {
+      if (!in.rice(k, v[i]))
+        return false;
+    }
+  }
+  reader = in;
+  return true;
+}
+
+// 一行：选择残差绝对值之和最小的预测方式（块的第一行只用 left）
+// 每行的前 channels 个样本没有左邻，按0预测（同PNG）
+template <typename T>
+void encode_row(const T *cur, const T *up, int samples, int channels,
+                T *resid, BitWriter &out) {
+  const int head = std::min(channels, samples);
+  uint32_t mode = kLeft;
+  if (up) {
+    uint64_t left = 0, vertical = 0, diagonal = 0;
+    for (int i = 0; i < head; ++i) {
+      left += magnitude<T>(cur[i]);
+      vertical += magnitude<T>(static_cast<T>(cur[i] - up[i]));
+      if constexpr (sizeof(T) < 8)
+        diagonal += magnitude<T>(
+            static_cast<T>(cur[i] - paeth(T(0), up[i], T(0))));
+    }
+    for (int i = head; i < samples; ++i) {
+      const T a = cur[i - channels];
+      left += magnitude<T>(static_cast<T>(cur[i] - a));
+      vertical += magnitude<T>(static_cast<T>(cur[i] - up[i]));
+      if constexpr (sizeof(T) < 8)
+        diagonal += magnitude<T>(
+            static_cast<T>(cur[i] - paeth(a, up[i], up[i - channels])));
+    }
+    if constexpr (sizeof(T) == 8)
+      diagonal = UINT64_MAX;
+    mode = vertical < left ? kUp : kLeft;
+    if (diagonal < std::min(left, vertical))
+      mode = kPaeth;
+  }
+
+  if (mode == kUp) {
+    for (int i = 0; i < samples; ++i)
+      resid[i] = zigzag<T>(static_cast<T>(cur[i] - up[i]));
+  } else if (mode == kLeft) {
+    for (int i = 0; i < head; ++i)
+      resid[i] = zigzag<T>(cur[i]);
+    for (int i = head; i < samples; ++i)
+      resid[i] = zigzag<T>(static_cast<T>(cur[i] - cur[i - channels]));
+  } else {
+    for (int i = 0; i < head; ++i)
+      resid[i] = zigzag<T>(static_cast<T>(cur[i] - paeth(T(0), up[i], T(0))));
+    for (int i = head; i < samples; ++i)
+      resid[i] = zigzag<T>(static_cast<T>(
+          cur[i] - paeth(cur[i - channels], up[i], up[i - channels])));
+  }
+
+  out.put(mode, 2);
+  for (int i = 0; i < samples; i += kChunk)
+    put_chunk(resid + i, std::min(kChunk, samples - i), out);
+}
+
+template <typename T>
+bool decode_row(T *cur, const T *up, int samples, int channels, T *resid,
+                BitReader &in) {
+  const uint32_t mode = in.get(2);
+  if (mode > kPaeth || (!up && mode != kLeft) ||
+      (sizeof(T) == 8 && mode == kPaeth))
+    return false;
+  for (int i = 0; i < samples; i += kChunk) {
+    if (!get_chunk(resid + i, std::min(kChunk, samples - i), in))
+      return false;
+  }
+
+  const int head = std::min(channels, samples);
+  if (mode == kUp) {
+    for (int i = 0; i < samples; ++i)
+      cur[i] = static_cast<T>(up[i] + unzigzag(resid[i]));
+  } else if (mode == kLeft) {
+    for (int i = 0; i < head; ++i)
+      cur[i] = unzigzag(resid[i]);
+    for (int i = head; i < samples; ++i)
+      cur[i] = static_cast<T>(cur[i - channels] + unzigzag(resid[i]));
+  } else {
+    for (int i = 0; i < head; ++i)
+      cur[i] = static_cast<T>(paeth(T(0), up[i], T(0)) + unzigzag(resid[i]));
+    for (int i = head; i < samples; ++i)
+      cur[i] = static_cast<T>(
+          paeth(cur[i - channels], up[i], up[i - channels]) +
+          unzigzag(resid[i]));
+  }
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// 块
+
+template <typename T>
+void encode_block(const Image &image, int y0, int y1,
+                  std::vector<uint8_t> &out) {
+  const int channels = image.channels();
+  const int samples = image.width() * channels;
+  const size_t row_bytes = static_cast<size_t>(samples) * sizeof(T);
+  const size_t raw = row_bytes * (y1 - y0);
+  // 一行编码结果的上限：模式、每段参数、每个样本最长的转义编码
+  const size_t row_limit =
+      (2 + static_cast<size_t>((samples + kChunk - 1) / kChunk) * 6 +
+       static_cast<size_t>(samples) * (kEscape + 1 + sample_bits<T>())) /
+          8 +
+      8;
+
+  out.resize(1 + raw + row_limit);
+  out[0] = kBlockCoded;
+  BitWriter writer(out.data() + 1);
+  std::vector<T> resid(samples);
+  bool smaller = true;
+  for (int y = y0; y < y1 && smaller; ++y) {
+    encode_row(image.ptr<T>(y), y > y0 ? image.ptr<T>(y - 1) : nullptr,
+               samples, channels, resid.data(), writer);
+    smaller = writer.size() < raw;
+  }
+  const size_t coded = writer.finish();
+  if (smaller && coded < raw) {
+    out.resize(1 + coded);
+    return;
+  }
+
+  // 不可压缩的数据原样存储
+  out[0] = kBlockStored;
+  for (int y = y0; y < y1; ++y)
+    std::memcpy(out.data() + 1 + (y - y0) * row_bytes, image.ptr<uint8_t>(y),
+                row_bytes);
+  out.resize(1 + raw);
+}
+
+template <typename T>
+bool decode_block(const uint8_t *data, size_t size, Image &dst, int y0,
+                  int y1) {
+  const int channels = dst.channels();
+  const int samples = dst.width() * channels;
+  const size_t row_bytes = static_cast<size_t>(samples) * sizeof(T);
+  if (size < 1)
+    return false;
+
+  if (data[0] == kBlockStored) {
+    if (size - 1 != row_bytes * (y1 - y0))
+      return false;
+    for (int y = y0; y < y1; ++y)
+      std::memcpy(dst.ptr<uint8_t>(y), data + 1 + (y - y0) * row_bytes,
+                  row_bytes);
+    return true;
+  }
+  if (data[0] != kBlockCoded)
+    return false;
+
+  BitReader reader(data + 1, data + size);
+  std::vector<T> resid(samples);
+  for (int y = y0; y < y1; ++y) {
+    if (!decode_row(dst.ptr<T>(y), y > y0 ? dst.ptr<T>(y - 1) : nullptr,
+                    samples, channels, resid.data(), reader))
+      return false;
+  }
+  return !reader.overrun();
+}
+
+void encode_block_any(const Image &image, int y0, int y1,
+                      std::vector<uint8_t> &out) {
+  switch (dataTypeSize(image.type())) {
+  case 1:
+    encode_block<uint8_t>(image, y0, y1, out);
+    break;
+  case 2:
+    encode_block<uint16_t>(image, y0, y1, out);
+    break;
+  case 4:
+    encode_block<uint32_t>(image, y0, y1, out);
+    break;
+  default:
+    encode_block<uint64_t>(image, y0, y1, out);
+    break;
+  }
+}
+
+bool decode_block_any(const uint8_t *data, size_t size, Image &dst, int y0,
+                      int y1) {
+  switch (dataTypeSize(dst.type())) {
+  case 1:
+    return decode_block<uint8_t>(data, size, dst, y0, y1);
+  case 2:
+    return decode_block<uint16_t>(data, size, dst, y0, y1);
+  case 4:
+    return decode_block<uint32_t>(data, size, dst, y0, y1);
+  default:
+    return decode_block<uint64_t>(data, size, dst, y0, y1);
+  }
+}
+
+} // namespace
+
+void encode_dipz(const Image &image, std::vector<uint8_t> &out,
+                 const DipzOptions &options) {
+  if (image.empty())
+    throw std::invalid_argument("Cannot encode an empty image");
+
+  const int height = image.height();
+  const size_t row_bytes = static_cast<size_t>(image.width()) *
+                           image.channels() * dataTypeSize(image.type());
+  int block_rows = options.block_rows;
+  if (block_rows <= 0)
+    block_rows = static_cast<int>(
+        std::max<size_t>(1, std::min<size_t>(height,
+                                             kAutoBlockBytes / row_bytes)));
+  block_rows = std::min(block_rows, height);
+  const int block_count = (height + block_rows - 1) / block_rows;
+
+  // 各块独立编码
+  std::vector<std::vector<uint8_t>> blocks(block_count);
+  parallel_for(
+      0, block_count,
+      [&](int b0, int b1) {
+        for (int b = b0; b < b1; ++b)
+          encode_block_any(image, b * block_rows,
+                           std::min(height, (b + 1) * block_rows), blocks[b]);
+      },
+      1);
+
+  size_t total = kHeaderBytes + sizeof(uint64_t) * block_count;
+  for (const auto &block : blocks)
+    total += block.size();
+  out.assign(total, 0);
+
+  uint8_t *header = out.data();
+  std::memcpy(header, kMagic, sizeof(kMagic));
+  put<uint16_t>(header, 4, kVersion);
+  put<uint16_t>(header, 6, kByteOrderMark);
+  put<uint32_t>(header, 8, static_cast<uint32_t>(height));
+  put<uint32_t>(header, 12, static_cast<uint32_t>(image.width()));
+  put<uint32_t>(header, 16, static_cast<uint32_t>(image.channels()));
+  put<uint32_t>(header, 20, static_cast<uint32_t>(image.type()));
+  put<uint32_t>(header, 24, static_cast<uint32_t>(block_rows));
+  put<uint32_t>(header, 28, static_cast<uint32_t>(block_count));
+
+  size_t pos = kHeaderBytes + sizeof(uint64_t) * block_count;
+  for (int b = 0; b < block_count; ++b) {
+    put<uint64_t>(out.data(), kHeaderBytes + sizeof(uint64_t) * b,
+                  blocks[b].size());
+    std::memcpy(out.data() + pos, blocks[b].data(), blocks[b].size());
+    pos += blocks[b].size();
+  }
+}
+
+bool decode_dipz(const uint8_t *data, size_t size, Image &dst,
+                 std::string *error) {
+  if (size < kHeaderBytes || std::memcmp(data, kMagic, sizeof(kMagic)) != 0)
+    return fail(error, "not a .dipz file");
+  if (get<uint16_t>(data, 4) != kVersion)
+    return fail(error, "unsupported .dipz version");
+  if (get<uint16_t>(data, 6) != kByteOrderMark)
+    return fail(error, ".dipz file was written with another byte order");
+
+  const uint32_t height = get<uint32_t>(data, 8);
+  const uint32_t width = get<uint32_t>(data, 12);
+  const uint32_t channels = get<uint32_t>(data, 16);
+  const uint32_t type = get<uint32_t>(data, 20);
+  const uint32_t block_rows = get<uint32_t>(data, 24);
+  const uint32_t block_count = get<uint32_t>(data, 28);
+  const int elem = type <= static_cast<uint32_t>(DataType::FLOAT64)
+                       ? dataTypeSize(static_cast<DataType>(type))
+                       : 0;
+  // 块数按 64 位计算，避免 height + block_rows 在 32 位下回绕
+  if (height == 0 || width == 0 || channels == 0 || elem == 0 ||
+      block_rows == 0 || block_rows > height || height > INT32_MAX ||
+      static_cast<uint64_t>(width) * channels > INT32_MAX ||
+      block_count == 0 ||
+      block_count != (static_cast<uint64_t>(height) + block_rows - 1) /
+                         block_rows)
+    return fail(error, "invalid .dipz header");
+
+  // 块长度表
+  const size_t table_end = kHeaderBytes + sizeof(uint64_t) * block_count;
+  if (table_end > size)
+    return fail(error, ".dipz file is truncated");
+  std::vector<size_t> offsets(block_count + 1, table_end);
+  for (uint32_t b = 0; b < block_count; ++b) {
+    const uint64_t length =
+        get<uint64_t>(data, kHeaderBytes + sizeof(uint64_t) * b);
+    if (length > size - offsets[b])
+      return fail(error, ".dipz file is truncated");
+    offsets[b + 1] = offsets[b] + static_cast<size_t>(length);
+  }
+
+  dst.create(static_cast<int>(width), static_cast<int>(height),
+             static_cast<int>(channels), static_cast<DataType>(type));
+
+  // 各块独立解码
+  std::atomic<bool> ok{true};
+  parallel_for(
+      0, static_cast<int>(block_count),
+      [&](int b0, int b1) {
+        for (int b = b0; b < b1 && ok.load(std::memory_order_relaxed); ++b) {
+          const int y0 = b * static_cast<int>(block_rows);
+          const int y1 = static_cast<int>(std::min<int64_t>(
+              height, static_cast<int64_t>(y0) + block_rows));
+          if (!decode_block_any(data + offsets[b], offsets[b + 1] - offsets[b],
+                                dst, y0, y1))
+            ok = false;
+        }
+      },
+      1);
+  if (!ok)
+    return fail(error, "corrupt .dipz data");
+  return true;
+}
+
+} // namespace dip
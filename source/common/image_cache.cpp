@@ -0,0 +1,190 @@
+#include <core/image_cache.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <system_error>
+
+namespace dip {
+
+namespace {
+
+// 文件的大小和修改时间；文件不存在时返回 false
+bool file_stamp(const std::string &path, uint64_t &size, int64_t &mtime) {
+  std::error_code ec;
+  size = std::filesystem::file_size(path, ec);
+  if (ec)
+    return false;
+  const auto time = std::filesystem::last_write_time(path, ec);
+  if (ec)
+    return false;
+  mtime = static_cast<int64_t>(time.time_since_epoch().count());
+  return true;
+}
+
+std::string cache_key(const std::string &path, int desired_channels) {
+  std::string key = path;
+  key.push_back('\0');
+  key += std::to_string(desired_channels);
+  return key;
+}
+
+size_t image_bytes(const Image &image) {
+  return image.matrix().step() * static_cast<size_t>(image.matrix().rows());
+}
+
+} // namespace
+
+std::shared_ptr<const Image> ImageCache::get(const std::string &path,
+                                             int desired_channels,
+                                             const Loader &loader) {
+  uint64_t file_size = 0;
+  int64_t mtime = 0;
+  if (!file_stamp(path, file_size, mtime))
+    return loader(); // 文件不存在：不缓存，由加载函数报告错误
+
+  const std::string key = cache_key(path, desired_channels);
+  std::promise<std::shared_ptr<const Image>> promise;
+  uint64_t id = 0;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = cache_.find(key);
+    if (it != cache_.end()) {
+      Entry &entry = it->second;
+      if (entry.file_size == file_size && entry.mtime == mtime) {
+        if (entry.image) {
+          lru_.splice(lru_.begin(), lru_, entry.lru);
+          ++stats_.hits;
+          return entry.image;
+        }
+        // 其他线程正在加载同一文件，在锁外等待其结果
+        Result pending = entry.pending;
+        ++stats_.coalesced;
+        lock.unlock();
+        return pending.get();
+      }
+      if (!entry.image) {
+        // 文件在加载旧版本期间被修改：本次单独加载，不进入缓存
+        ++stats_.misses;
+        lock.unlock();
+        return loader();
+      }
+      erase_locked(it);
+      ++stats_.invalidations;
+    }
+
+    id = ++next_id_;
+    Entry entry;
+    entry.id = id;
+    entry.file_size = file_size;
+    entry.mtime = mtime;
+    entry.pending = promise.get_future().share();
+    cache_.emplace(key, std::move(entry));
+    ++stats_.misses;
+  }
+
+  // 在锁外加载，其他线程可以同时命中缓存或加载其他文件
+  std::shared_ptr<const Image> image;
+  try {
+    image = loader();
+  } catch (...) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = cache_.find(key);
+      if (it != cache_.end() && it->second.id == id)
+        cache_.erase(it);
+    }
+    promise.set_exception(std::current_exception());
+    throw;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(key);
+    // 加载期间条目可能已被 invalidate/clear 移除
+    if (it != cache_.end() && it->second.id == id) {
+      const size_t bytes = image ? image_bytes(*image) : 0;
+      if (!image || bytes > budget_) {
+        cache_.erase(it);
+      } else {
+        Entry &entry = it->second;
+        entry.image = image;
+        entry.pending = Result();
+        entry.bytes = bytes;
+        lru_.push_front(key);
+        entry.lru = lru_.begin();
+        stats_.bytes += bytes;
+        stats_.peak_bytes = std::max(stats_.peak_bytes, stats_.bytes);
+        ++stats_.entries;
+        evict_locked();
+      }
+    }
+  }
+  promise.set_value(image);
+  return image;
+}
+
+void ImageCache::erase_locked(
+    std::unordered_map<std::string, Entry>::iterator it) {
+  if (it->second.image) {
+    lru_.erase(it->second.lru);
+    stats_.bytes -= it->second.bytes;
+    --stats_.entries;
+  }
+  cache_.erase(it);
+}
+
+void ImageCache::evict_locked() {
+  while (stats_.bytes > budget_ && !lru_.empty()) {
+    erase_locked(cache_.find(lru_.back()));
+    ++stats_.evictions;
+  }
+}
+
+void ImageCache::invalidate(const std::string &path) {
+  std::string prefix = path;
+  prefix.push_back('\0');
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = cache_.begin(); it != cache_.end();) {
+    auto next = std::next(it);
+    if (it->first.compare(0, prefix.size(), prefix) == 0)
+      erase_locked(it);
+    it = next;
+  }
+}
+
+void ImageCache::set_budget(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  budget_ = bytes;
+  evict_locked();
+}
+
+size_t ImageCache::budget() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return budget_;
+}
+
+ImageCacheStats ImageCache::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void ImageCache::reset_stats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const size_t entries = stats_.entries;
+  const size_t bytes = stats_.bytes;
+  stats_ = ImageCacheStats();
+  stats_.entries = entries;
+  stats_.bytes = bytes;
+  stats_.peak_bytes = bytes;
+}
+
+void ImageCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // 正在加载的条目也移除，其结果只返回给等待者，不进入缓存
+  while (!lru_.empty())
+    erase_locked(cache_.find(lru_.back()));
+  cache_.clear();
+}
+
+} // namespace dip
@@ -0,0 +1,128 @@
+#include <core/memory_stats.hpp>
+
+#if defined(DIP_ENABLE_MEMORY_TRACKING)
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace dip {
+namespace memory {
+
+namespace {
+
+// 缓冲区头部，记录分配时的标签；大小保持 max_align_t 对齐
+struct alignas(alignof(std::max_align_t)) Header {
+  int tag;
+};
+
+struct Counters {
+  std::atomic<size_t> current{0};
+  std::atomic<size_t> peak{0};
+  std::atomic<size_t> allocations{0};
+  std::atomic<size_t> largest{0};
+
+  static void update_max(std::atomic<size_t> &value, size_t candidate) {
+    size_t old = value.load(std::memory_order_relaxed);
+    while (old < candidate &&
+           !value.compare_exchange_weak(old, candidate,
+                                        std::memory_order_relaxed)) {
+    }
+  }
+
+  void add(size_t bytes) {
+    const size_t now =
+        current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    update_max(peak, now);
+    update_max(largest, bytes);
+  }
+
+  void remove(size_t bytes) {
+    current.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+
+  MemoryStats snapshot() const {
+    MemoryStats s;
+    s.current_bytes = current.load(std::memory_order_relaxed);
+    s.peak_bytes = peak.load(std::memory_order_relaxed);
+    s.allocations = allocations.load(std::memory_order_relaxed);
+    s.largest_allocation = largest.load(std::memory_order_relaxed);
+    return s;
+  }
+
+  void reset_peak() {
+    peak.store(current.load(std::memory_order_relaxed),
+               std::memory_order_relaxed);
+  }
+};
+
+Counters g_total;
+Counters g_tags[kMaxTags];
+
+// 标签名只在注册时加锁写入；读取时 g_tag_count 之前的名称已发布
+std::mutex g_tag_mutex;
+const char *g_tag_names[kMaxTags] = {"untagged"};
+std::atomic<int> g_tag_count{1};
+
+} // namespace
+
+namespace detail {
+
+int register_tag(const char *name) {
+  std::lock_guard<std::mutex> lock(g_tag_mutex);
+  const int count = g_tag_count.load(std::memory_order_relaxed);
+  for (int i = 0; i < count; ++i) {
+    if (std::strcmp(g_tag_names[i], name) == 0)
+      return i;
+  }
+  if (count >= kMaxTags)
+    return 0;
+  g_tag_names[count] = name;
+  g_tag_count.store(count + 1, std::memory_order_release);
+  return count;
+}
+
+void *allocate(size_t bytes) {
+  void *raw = std::malloc(sizeof(Header) + bytes);
+  if (!raw)
+    throw std::bad_alloc();
+  const int tag = current_tag;
+  static_cast<Header *>(raw)->tag = tag;
+  g_total.add(bytes);
+  g_tags[tag].add(bytes);
+  return static_cast<char *>(raw) + sizeof(Header);
+}
+
+void deallocate(void *p, size_t bytes) {
+  if (!p)
+    return;
+  void *raw = static_cast<char *>(p) - sizeof(Header);
+  g_total.remove(bytes);
+  g_tags[static_cast<Header *>(raw)->tag].remove(bytes);
+  std::free(raw);
+}
+
+} // namespace detail
+
+MemoryStats stats() { return g_total.snapshot(); }
+
+std::vector<TagStats> tag_stats() {
+  std::vector<TagStats> result;
+  const int count = g_tag_count.load(std::memory_order_acquire);
+  for (int i = 0; i < count; ++i) {
+    MemoryStats s = g_tags[i].snapshot();
+    if (s.allocations > 0)
+      result.push_back({g_tag_names[i], s});
+  }
+  return result;
+}
+
+void reset_peak() { g_total.reset_peak(); }
+
+} // namespace memory
+} // namespace dip
+
+#endif // DIP_ENABLE_MEMORY_TRACKING
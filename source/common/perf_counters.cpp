@@ -0,0 +1,177 @@
+#include <core/perf_counters.hpp>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace dip {
+
+namespace {
+
+enum Event { TASK_CLOCK, CYCLES, INSTRUCTIONS, LLC_MISSES, BRANCH_MISSES };
+constexpr int kNumEvents = 5;
+
+#if defined(__linux__)
+
+struct EventConfig {
+  uint32_t type;
+  uint64_t config;
+  const char *name;
+};
+
+const EventConfig kEvents[kNumEvents] = {
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, "task-clock"},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles"},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions"},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, "llc-misses"},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "branch-misses"},
+};
+
+int open_event(const EventConfig &event, pid_t tid) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.disabled = 1;
+  // 只统计用户态，perf_event_paranoid=2 时仍可使用
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // 该线程之后创建的线程（如首次使用时才启动的线程池）继承计数器，
+  // read() 的结果包含这些线程
+  attr.inherit = 1;
+  attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, &attr, tid, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+// 当前进程的所有线程ID
+std::vector<pid_t> list_threads() {
+  std::vector<pid_t> tids;
+  if (DIR *dir = opendir("/proc/self/task")) {
+    while (dirent *entry = readdir(dir)) {
+      if (entry->d_name[0] != '.')
+        tids.push_back(static_cast<pid_t>(std::atoi(entry->d_name)));
+    }
+    closedir(dir);
+  }
+  if (tids.empty())
+    tids.push_back(0); // 只统计调用线程
+  return tids;
+}
+
+#endif
+
+} // namespace
+
+PerfCounters::~PerfCounters() { close_all(); }
+
+void PerfCounters::close_all() {
+#if defined(__linux__)
+  for (int fd : fds_)
+    close(fd);
+#endif
+  fds_.clear();
+  events_.clear();
+  running_ = false;
+}
+
+bool PerfCounters::start() {
+  close_all();
+  error_.clear();
+
+#if defined(__linux__)
+  for (pid_t tid : list_threads()) {
+    for (int e = 0; e < kNumEvents; ++e) {
+      int fd = open_event(kEvents[e], tid);
+      if (fd < 0) {
+        // 线程可能在枚举后退出（ESRCH），不视为计数器不可用
+        const std::string name = kEvents[e].name;
+        if (errno != ESRCH && error_.find(name) == std::string::npos) {
+          if (!error_.empty())
+            error_ += "; ";
+          error_ += name + ": " + std::strerror(errno);
+        }
+        continue;
+      }
+      fds_.push_back(fd);
+      events_.push_back(e);
+    }
+  }
+  for (int fd : fds_) {
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+#else
+  error_ = "perf_event_open is only available on Linux";
+#endif
+
+  running_ = true;
+  start_time_ = std::chrono::steady_clock::now();
+  return !fds_.empty();
+}
+
+PerfSample PerfCounters::stop() {
+  PerfSample sample;
+  if (!running_)
+    return sample;
+  auto end_time = std::chrono::steady_clock::now();
+  sample.seconds =
+      std::chrono::duration<double>(end_time - start_time_).count();
+
+#if defined(__linux__)
+  for (int fd : fds_)
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+  int64_t totals[kNumEvents];
+  bool seen[kNumEvents] = {};
+  for (size_t i = 0; i < fds_.size(); ++i) {
+    uint64_t values[3]; // value, time_enabled, time_running
+    if (read(fds_[i], values, sizeof(values)) != sizeof(values))
+      continue;
+    double value = static_cast<double>(values[0]);
+    // 计数器被复用时按运行时间比例估算
+    if (values[2] > 0 && values[2] < values[1])
+      value *= static_cast<double>(values[1]) / values[2];
+    const int e = events_[i];
+    totals[e] = (seen[e] ? totals[e] : 0) + static_cast<int64_t>(value);
+    seen[e] = true;
+  }
+
+  int64_t *fields[kNumEvents] = {&sample.task_clock_ns, &sample.cycles,
+                                 &sample.instructions, &sample.llc_misses,
+                                 &sample.branch_misses};
+  for (int e = 0; e < kNumEvents; ++e) {
+    if (seen[e])
+      *fields[e] = totals[e];
+  }
+#endif
+
+  close_all();
+  return sample;
+}
+
+bool PerfCounters::hardware_available() {
+  static const bool available = [] {
+#if defined(__linux__)
+    int fd = open_event(kEvents[CYCLES], 0);
+    if (fd < 0)
+      return false;
+    close(fd);
+    return true;
+#else
+    return false;
+#endif
+  }();
+  return available;
+}
+
+} // namespace dip
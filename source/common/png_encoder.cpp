@@ -0,0 +1,526 @@
+#include <core/png_encoder.hpp>
+
+#include <algorithm>
+#include <core/parallel.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace dip {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// 校验和
+
+struct CrcTable {
+  uint32_t value[256];
+  CrcTable() {
+    for (uint32_t n = 0; n < 256; ++n) {
+      uint32_t c = n;
+      for (int k = 0; k < 8; ++k)
+        c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      value[n] = c;
+    }
+  }
+};
+
+uint32_t crc32(const uint8_t *data, size_t size, uint32_t crc = 0) {
+  static const CrcTable table;
+  crc = ~crc;
+  for (size_t i = 0; i < size; ++i)
+    crc = table.value[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+constexpr uint32_t kAdlerBase = 65521;
+
+uint32_t adler32(const uint8_t *data, size_t size) {
+  uint32_t a = 1, b = 0;
+  while (size > 0) {
+    // 5552 是保证 b 不溢出的最大块长度
+    size_t n = std::min<size_t>(size, 5552);
+    size -= n;
+    while (n--) {
+      a += *data++;
+      b += a;
+    }
+    a %= kAdlerBase;
+    b %= kAdlerBase;
+  }
+  return b << 16 | a;
+}
+
+// 合并两段数据的 Adler-32（second_size 为第二段长度）
+uint32_t adler32_combine(uint32_t first, uint32_t second, size_t second_size) {
+  const uint32_t rem = static_cast<uint32_t>(second_size % kAdlerBase);
+  uint32_t sum1 = first & 0xFFFF;
+  uint32_t sum2 = rem * sum1 % kAdlerBase;
+  sum1 += (second & 0xFFFF) + kAdlerBase - 1;
+  sum2 += (first >> 16) + (second >> 16) + kAdlerBase - rem;
+  if (sum1 >= kAdlerBase)
+    sum1 -= kAdlerBase;
+  if (sum1 >= kAdlerBase)
+    sum1 -= kAdlerBase;
+  if (sum2 >= kAdlerBase * 2)
+    sum2 -= kAdlerBase * 2;
+  if (sum2 >= kAdlerBase)
+    sum2 -= kAdlerBase;
+  return sum2 << 16 | sum1;
+}
+
+void put_be32(std::vector<uint8_t> &out, uint32_t v) {
+  out.push_back(static_cast<uint8_t>(v >> 24));
+  out.push_back(static_cast<uint8_t>(v >> 16));
+  out.push_back(static_cast<uint8_t>(v >> 8));
+  out.push_back(static_cast<uint8_t>(v));
+}
+
+// ---------------------------------------------------------------------------
+// deflate（固定Huffman编码 + 哈希链LZ77）
+
+// 按位低位在前写出
+class BitWriter {
+public:
+  explicit BitWriter(std::vector<uint8_t> &out) : out_(out) {}
+
+  void put(uint32_t bits, int count) {
+    acc_ |= static_cast<uint64_t>(bits) << count_;
+    count_ += count;
+    while (count_ >= 8) {
+      out_.push_back(static_cast<uint8_t>(acc_));
+      acc_ >>= 8;
+      count_ -= 8;
+    }
+  }
+
+  void align() {
+    if (count_ > 0)
+      put(0, 8 - count_);
+  }
+
+private:
+  std::vector<uint8_t> &out_;
+  uint64_t acc_ = 0;
+  int count_ = 0;
+};
+
+uint32_t reverse_bits(uint32_t code, int length) {
+  uint32_t r = 0;
+  for (int i = 0; i < length; ++i) {
+    r = r << 1 | (code & 1);
+    code >>= 1;
+  }
+  return r;
+}
+
+const int kLengthBase[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,
+                             15, 17, 19, 23, 27, 31, 35, 43, 51,  59,
+                             67, 83, 99, 115, 131, 163, 195, 227, 258};
+const int kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                              2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const int kDistBase[30] = {1,    2,    3,    4,     5,     7,    9,    13,
+                           17,   25,   33,   49,    65,    97,   129,  193,
+                           257,  385,  513,  769,   1025,  1537, 2049, 3073,
+                           4097, 6145, 8193, 12289, 16385, 24577};
+const int kDistExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                            6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+// 固定Huffman码表（已按写出顺序反转）
+struct FixedCodes {
+  uint16_t literal[288];
+  uint8_t literal_length[288];
+  uint8_t length_code[259]; // 匹配长度 -> 长度码序号（0..28）
+  uint16_t distance[30];
+
+  FixedCodes() {
+    for (int s = 0; s < 288; ++s) {
+      uint32_t code;
+      int length;
+      if (s < 144) {
+        code = 0x30 + s, length = 8;
+      } else if (s < 256) {
+        code = 0x190 + s - 144, length = 9;
+      } else if (s < 280) {
+        code = s - 256, length = 7;
+      } else {
+        code = 0xC0 + s - 280, length = 8;
+      }
+      literal[s] = static_cast<uint16_t>(reverse_bits(code, length));
+      literal_length[s] = static_cast<uint8_t>(length);
+    }
+    for (int len = 3, i = 0; len <= 258; ++len) {
+      while (i < 28 && kLengthBase[i + 1] <= len)
+        ++i;
+      length_code[len] = static_cast<uint8_t>(i);
+    }
+    for (int i = 0; i < 30; ++i)
+      distance[i] = static_cast<uint16_t>(reverse_bits(i, 5));
+  }
+};
+
+const FixedCodes &fixed_codes() {
+  static const FixedCodes codes;
+  return codes;
+}
+
+class FixedEncoder {
+public:
+  explicit FixedEncoder(BitWriter &bits)
+      : bits_(bits), codes_(fixed_codes()) {}
+
+  void literal(int symbol) {
+    bits_.put(codes_.literal[symbol], codes_.literal_length[symbol]);
+  }
+
+  void match(int length, int distance) {
+    const int li = codes_.length_code[length];
+    literal(257 + li);
+    if (kLengthExtra[li] > 0)
+      bits_.put(length - kLengthBase[li], kLengthExtra[li]);
+
+    const int di =
+        static_cast<int>(std::upper_bound(kDistBase, kDistBase + 30, distance) -
+                         kDistBase) -
+        1;
+    bits_.put(codes_.distance[di], 5);
+    if (kDistExtra[di] > 0)
+      bits_.put(distance - kDistBase[di], kDistExtra[di]);
+  }
+
+private:
+  BitWriter &bits_;
+  const FixedCodes &codes_;
+};
+
+constexpr int kWindowSize = 32768;
+constexpr int kHashBits = 15;
+constexpr int kMinMatch = 3;
+constexpr int kMaxMatch = 258;
+
+inline uint32_t hash3(const uint8_t *p) {
+  const uint32_t v = static_cast<uint32_t>(p[0]) << 16 |
+                     static_cast<uint32_t>(p[1]) << 8 | p[2];
+  return (v * 2654435761u) >> (32 - kHashBits);
+}
+
+// 不压缩：stored 块，每块最多 65535 字节
+void deflate_stored(const uint8_t *data, size_t size, bool last,
+                    std::vector<uint8_t> &out) {
+  BitWriter bits(out);
+  size_t pos = 0;
+  do {
+    const size_t n = std::min<size_t>(size - pos, 65535);
+    const bool final = last && pos + n == size;
+    bits.put(final ? 1 : 0, 1);
+    bits.put(0, 2);
+    bits.align();
+    out.push_back(static_cast<uint8_t>(n));
+    out.push_back(static_cast<uint8_t>(n >> 8));
+    out.push_back(static_cast<uint8_t>(~n));
+    out.push_back(static_cast<uint8_t>(~n >> 8));
+    out.insert(out.end(), data + pos, data + pos + n);
+    pos += n;
+  } while (pos < size);
+}
+
+/**
+ * 将一段数据压缩为一个固定Huffman块
+ * last 为 false 时在块后追加空的 stored 块（同步刷新），使输出按字节对齐，
+ * 可以直接与下一段的压缩结果拼接
+ */
+void deflate_segment(const uint8_t *data, size_t size, int level, bool last,
+                     std::vector<uint8_t> &out) {
+  if (level <= 0) {
+    deflate_stored(data, size, last, out);
+    return;
+  }
+
+  // 各级别的搜索参数：哈希链最大长度、足够长（停止搜索）的匹配长度、
+  // 延迟匹配的长度上限（取值参照zlib）
+  struct Config {
+    int max_chain, nice_length, lazy_length;
+  };
+  static const Config kConfigs[10] = {
+      {0, 0, 0},       {4, 8, 0},       {8, 16, 0},     {16, 32, 0},
+      {16, 32, 16},    {32, 64, 32},    {128, 128, 16}, {256, 128, 32},
+      {1024, 258, 128}, {4096, 258, 258}};
+  const Config &config = kConfigs[std::min(level, 9)];
+
+  std::vector<int32_t> head(size_t(1) << kHashBits, -1);
+  std::vector<int32_t> prev(size);
+  auto insert = [&](size_t p) {
+    if (p + kMinMatch <= size) {
+      const uint32_t h = hash3(data + p);
+      prev[p] = head[h];
+      head[h] = static_cast<int32_t>(p);
+    }
+  };
+  // 在已插入的位置中查找 p 处的最长匹配
+  auto find_match = [&](size_t p, int &distance) {
+    if (p + kMinMatch > size)
+      return 0;
+    const int limit = static_cast<int>(std::min<size_t>(kMaxMatch, size - p));
+    int best = 0;
+    int chain = config.max_chain;
+    for (int32_t cand = head[hash3(data + p)]; cand >= 0 && chain-- > 0;
+         cand = prev[cand]) {
+      if (p - cand > kWindowSize)
+        break;
+      if (data[cand + best] != data[p + best])
+        continue;
+      int length = 0;
+      while (length < limit && data[cand + length] == data[p + length])
+        ++length;
+      if (length > best) {
+        best = length;
+        distance = static_cast<int>(p - cand);
+        if (length == limit || length >= config.nice_length)
+          break;
+      }
+    }
+    return best >= kMinMatch ? best : 0;
+  };
+
+  BitWriter bits(out);
+  bits.put(last ? 1 : 0, 1);
+  bits.put(1, 2); // 固定Huffman
+  FixedEncoder encoder(bits);
+
+  size_t i = 0;
+  while (i < size) {
+    int distance = 0;
+    const int length = find_match(i, distance);
+    if (length == 0) {
+      encoder.literal(data[i]);
+      insert(i);
+      ++i;
+      continue;
+    }
+
+    insert(i);
+    if (length < config.lazy_length && i + 1 < size) {
+      // 下一位置的匹配更长时，当前位置输出字面量
+      int next_distance = 0;
+      if (find_match(i + 1, next_distance) > length) {
+        encoder.literal(data[i]);
+        ++i;
+        continue;
+      }
+    }
+    encoder.match(length, distance);
+    for (size_t p = i + 1; p < i + length; ++p)
+      insert(p);
+    i += length;
+  }
+  encoder.literal(256); // 块结束
+
+  if (!last) {
+    bits.put(0, 3); // 空 stored 块
+    bits.align();
+    const uint8_t flush[4] = {0x00, 0x00, 0xFF, 0xFF};
+    out.insert(out.end(), flush, flush + 4);
+  } else {
+    bits.align();
+  }
+}
+
+// ---------------------------------------------------------------------------
+// 行滤波
+
+inline int paeth(int a, int b, int c) {
+  const int p = a + b - c;
+  const int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+  if (pa <= pb && pa <= pc)
+    return a;
+  return pb <= pc ? b : c;
+}
+
+// 对一行应用指定滤波器，prev 为上一行（第一行为 nullptr）
+void filter_row(int type, const uint8_t *row, const uint8_t *prev,
+                size_t row_bytes, int bpp, uint8_t *out) {
+  const size_t n = static_cast<size_t>(bpp);
+  if (!prev) {
+    // 第一行：上一行视为全0，Up 等价于 None，Paeth 等价于 Sub
+    type = type == 2 ? 0 : type == 4 ? 1 : type;
+  }
+  switch (type) {
+  case 1:
+    std::memcpy(out, row, std::min(n, row_bytes));
+    for (size_t i = n; i < row_bytes; ++i)
+      out[i] = static_cast<uint8_t>(row[i] - row[i - n]);
+    break;
+  case 2:
+    for (size_t i = 0; i < row_bytes; ++i)
+      out[i] = static_cast<uint8_t>(row[i] - prev[i]);
+    break;
+  case 3:
+    for (size_t i = 0; i < row_bytes; ++i) {
+      const int a = i >= n ? row[i - n] : 0;
+      const int b = prev ? prev[i] : 0;
+      out[i] = static_cast<uint8_t>(row[i] - ((a + b) >> 1));
+    }
+    break;
+  case 4:
+    for (size_t i = 0; i < n && i < row_bytes; ++i)
+      out[i] = static_cast<uint8_t>(row[i] - prev[i]);
+    for (size_t i = n; i < row_bytes; ++i)
+      out[i] = static_cast<uint8_t>(
+          row[i] - paeth(row[i - n], prev[i], prev[i - n]));
+    break;
+  default:
+    std::memcpy(out, row, row_bytes);
+    break;
+  }
+}
+
+// 滤波后字节按有符号值的绝对值之和（常用的滤波器选择启发式）
+size_t filter_cost(const uint8_t *data, size_t size) {
+  size_t cost = 0;
+  for (size_t i = 0; i < size; ++i)
+    cost += std::abs(static_cast<int>(static_cast<int8_t>(data[i])));
+  return cost;
+}
+
+// 图像第 y 行的PNG字节（16位样本转换为大端）
+const uint8_t *png_row(const Image &image, int y, size_t row_bytes,
+                       std::vector<uint8_t> &scratch) {
+  if (image.type() == DataType::UINT8)
+    return image.ptr<uint8_t>(y);
+  scratch.resize(row_bytes);
+  const uint16_t *src = image.ptr<uint16_t>(y);
+  for (size_t i = 0; i < row_bytes / 2; ++i) {
+    scratch[2 * i] = static_cast<uint8_t>(src[i] >> 8);
+    scratch[2 * i + 1] = static_cast<uint8_t>(src[i]);
+  }
+  return scratch.data();
+}
+
+void put_chunk(std::vector<uint8_t> &out, const char type[4],
+               const uint8_t *data, size_t size) {
+  put_be32(out, static_cast<uint32_t>(size));
+  const size_t start = out.size();
+  out.insert(out.end(), type, type + 4);
+  out.insert(out.end(), data, data + size);
+  put_be32(out, crc32(out.data() + start, size + 4));
+}
+
+} // namespace
+
+void encode_png(const Image &image, std::vector<uint8_t> &out,
+                const PngOptions &options) {
+  if (image.empty())
+    throw std::invalid_argument("Cannot encode an empty image as PNG");
+  if (image.type() != DataType::UINT8 && image.type() != DataType::UINT16)
+    throw std::invalid_argument("PNG encoding requires UINT8 or UINT16");
+  if (image.channels() < 1 || image.channels() > 4)
+    throw std::invalid_argument("PNG encoding requires 1-4 channels");
+
+  const int width = image.width();
+  const int height = image.height();
+  const int sample_bytes = image.type() == DataType::UINT16 ? 2 : 1;
+  const int bpp = image.channels() * sample_bytes;
+  const size_t row_bytes = static_cast<size_t>(width) * bpp;
+  const int level = std::clamp(options.compression_level, 0, 9);
+  const int strip_rows =
+      options.strip_rows > 0
+          ? options.strip_rows
+          : static_cast<int>(
+                std::max<size_t>(1, (size_t(1) << 20) / (row_bytes + 1)));
+  const int strips = (height + strip_rows - 1) / strip_rows;
+
+  // 每个条带独立滤波、压缩，并编码为一个完整的 IDAT 块
+  std::vector<std::vector<uint8_t>> chunks(strips);
+  std::vector<uint32_t> adlers(strips);
+  std::vector<size_t> sizes(strips);
+  parallel_for(
+      0, strips,
+      [&](int s0, int s1) {
+        std::vector<uint8_t> filtered, candidate, scratch_row, scratch_prev;
+        for (int s = s0; s < s1; ++s) {
+          const int y0 = s * strip_rows;
+          const int y1 = std::min(height, y0 + strip_rows);
+          filtered.resize((row_bytes + 1) * (y1 - y0));
+          candidate.resize(row_bytes);
+
+          uint8_t *dst = filtered.data();
+          for (int y = y0; y < y1; ++y) {
+            const uint8_t *row = png_row(image, y, row_bytes, scratch_row);
+            const uint8_t *prev =
+                y > 0 ? png_row(image, y - 1, row_bytes, scratch_prev)
+                      : nullptr;
+            int best_type = 0;
+            if (level == 0) {
+              std::memcpy(dst + 1, row, row_bytes);
+            } else {
+              size_t best_cost = SIZE_MAX;
+              for (int type = 0; type < 5; ++type) {
+                filter_row(type, row, prev, row_bytes, bpp, candidate.data());
+                const size_t cost = filter_cost(candidate.data(), row_bytes);
+                if (cost < best_cost) {
+                  best_cost = cost;
+                  best_type = type;
+                  std::memcpy(dst + 1, candidate.data(), row_bytes);
+                }
+              }
+            }
+            dst[0] = static_cast<uint8_t>(best_type);
+            dst += row_bytes + 1;
+          }
+
+          sizes[s] = filtered.size();
+          adlers[s] = adler32(filtered.data(), filtered.size());
+
+          std::vector<uint8_t> &chunk = chunks[s];
+          chunk.assign(8, 0);
+          if (s == 0) {
+            // zlib 头：CM=8（deflate），32K窗口，FLEVEL 按压缩级别
+            chunk.push_back(0x78);
+            chunk.push_back(level <= 1 ? 0x01 : level <= 5 ? 0x5E
+                                                : level == 6 ? 0x9C
+                                                             : 0xDA);
+          }
+          deflate_segment(filtered.data(), filtered.size(), level,
+                          s == strips - 1, chunk);
+
+          const uint32_t length = static_cast<uint32_t>(chunk.size() - 8);
+          for (int k = 0; k < 4; ++k)
+            chunk[k] = static_cast<uint8_t>(length >> (24 - 8 * k));
+          std::memcpy(chunk.data() + 4, "IDAT", 4);
+          put_be32(chunk, crc32(chunk.data() + 4, length + 4));
+        }
+      },
+      1);
+
+  out.clear();
+  static const uint8_t kSignature[8] = {0x89, 'P',  'N',  'G',
+                                        '\r', '\n', 0x1A, '\n'};
+  out.insert(out.end(), kSignature, kSignature + 8);
+
+  std::vector<uint8_t> header;
+  put_be32(header, static_cast<uint32_t>(width));
+  put_be32(header, static_cast<uint32_t>(height));
+  static const uint8_t kColorType[5] = {0, 0, 4, 2, 6};
+  header.push_back(static_cast<uint8_t>(sample_bytes * 8));
+  header.push_back(kColorType[image.channels()]);
+  header.push_back(0); // deflate
+  header.push_back(0); // 自适应滤波
+  header.push_back(0); // 无隔行
+  put_chunk(out, "IHDR", header.data(), header.size());
+
+  uint32_t adler = adlers[0];
+  for (int s = 1; s < strips; ++s)
+    adler = adler32_combine(adler, adlers[s], sizes[s]);
+  for (auto &chunk : chunks) {
+    out.insert(out.end(), chunk.begin(), chunk.end());
+    std::vector<uint8_t>().swap(chunk);
+  }
+
+  // zlib 流末尾的 Adler-32 单独放在最后一个 IDAT 块中
+  std::vector<uint8_t> trailer;
+  put_be32(trailer, adler);
+  put_chunk(out, "IDAT", trailer.data(), trailer.size());
+  put_chunk(out, "IEND", nullptr, 0);
+}
+
+} // namespace dip
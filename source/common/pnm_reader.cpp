@@ -0,0 +1,312 @@
+#include <core/pnm_reader.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DIP_HAVE_MMAP 1
+#endif
+
+namespace dip {
+
+// 映射的文件；不支持 mmap 的平台上整体读入内存
+struct PnmReader::Mapping {
+  uint8_t *data = nullptr;
+  size_t size = 0;
+  bool mapped = false;
+  std::vector<uint8_t> buffer;
+
+  ~Mapping() {
+#if defined(DIP_HAVE_MMAP)
+    if (mapped)
+      munmap(data, size);
+#endif
+  }
+};
+
+namespace {
+
+// 跳过空白和注释（'#' 到行尾）
+size_t skip_space(const uint8_t *data, size_t size, size_t pos) {
+  while (pos < size) {
+    if (data[pos] == '#') {
+      while (pos < size && data[pos] != '\n' && data[pos] != '\r')
+        ++pos;
+    } else if (std::isspace(data[pos])) {
+      ++pos;
+    } else {
+      break;
+    }
+  }
+  return pos;
+}
+
+bool read_int(const uint8_t *data, size_t size, size_t &pos, int &value) {
+  pos = skip_space(data, size, pos);
+  if (pos >= size || !std::isdigit(data[pos]))
+    return false;
+  long v = 0;
+  while (pos < size && std::isdigit(data[pos])) {
+    v = v * 10 + (data[pos] - '0');
+    if (v > 1 << 30)
+      return false;
+    ++pos;
+  }
+  value = static_cast<int>(v);
+  return true;
+}
+
+bool fail(std::string *error, const std::string &message) {
+  if (error)
+    *error = message;
+  return false;
+}
+
+inline bool host_is_little_endian() {
+  const uint16_t probe = 1;
+  uint8_t first;
+  std::memcpy(&first, &probe, 1);
+  return first == 1;
+}
+
+// 大端16位样本转换为本机字节序（src 与 dst 可以是同一缓冲区）
+void convert_be16(const uint8_t *src, uint16_t *dst, size_t count) {
+  if (!host_is_little_endian()) {
+    if (static_cast<const void *>(dst) != src)
+      std::memcpy(dst, src, count * 2);
+    return;
+  }
+  for (size_t i = 0; i < count; ++i)
+    dst[i] = static_cast<uint16_t>(src[2 * i] << 8 | src[2 * i + 1]);
+}
+
+// 解析 data 中的文件头，并按文件总大小 file_size 检查像素数据是否完整
+bool parse_header(const uint8_t *data, size_t size, size_t file_size,
+                  PnmHeader &header, std::string *error) {
+  if (size < 2 || data[0] != 'P' || (data[1] != '5' && data[1] != '6'))
+    return fail(error, "not a binary PNM file (P5/P6)");
+
+  PnmHeader h;
+  h.channels = data[1] == '5' ? 1 : 3;
+  size_t pos = 2;
+  if (!read_int(data, size, pos, h.width) ||
+      !read_int(data, size, pos, h.height) ||
+      !read_int(data, size, pos, h.maxval))
+    return fail(error, "malformed PNM header");
+  if (h.width <= 0 || h.height <= 0 || h.maxval <= 0 || h.maxval > 65535)
+    return fail(error, "invalid PNM dimensions or maxval");
+  // maxval 之后恰好一个空白字符
+  if (pos >= size || !std::isspace(data[pos]))
+    return fail(error, "malformed PNM header");
+  h.data_offset = pos + 1;
+
+  if (h.data_offset + h.row_bytes() * h.height > file_size)
+    return fail(error, "PNM file is truncated");
+  header = h;
+  return true;
+}
+
+// 读取文件开头（足以容纳文件头）并解析
+constexpr size_t kHeaderProbe = 4096;
+
+bool read_header(std::ifstream &file, const std::string &path,
+                 PnmHeader &header, std::string *error) {
+  if (!file.is_open())
+    return fail(error, "cannot open '" + path + "'");
+  file.seekg(0, std::ios::end);
+  const auto file_size = static_cast<size_t>(file.tellg());
+  file.seekg(0);
+  uint8_t probe[kHeaderProbe];
+  file.read(reinterpret_cast<char *>(probe),
+            static_cast<std::streamsize>(std::min(file_size, kHeaderProbe)));
+  const auto size = static_cast<size_t>(file.gcount());
+  std::string reason;
+  if (!parse_header(probe, size, file_size, header, &reason))
+    return fail(error, "'" + path + "': " + reason);
+  return true;
+}
+
+} // namespace
+
+bool parse_pnm_header(const uint8_t *data, size_t size, PnmHeader &header,
+                      std::string *error) {
+  return parse_header(data, size, size, header, error);
+}
+
+bool read_pnm_header(const std::string &path, PnmHeader &header,
+                     std::string *error) {
+  std::ifstream file(path, std::ios::binary);
+  return read_header(file, path, header, error);
+}
+
+bool read_pnm(const std::string &path, Image &dst, std::string *error) {
+  std::ifstream file(path, std::ios::binary);
+  PnmHeader h;
+  if (!read_header(file, path, h, error))
+    return false;
+
+  // 直接读入 dst 的缓冲区；16位样本原地转换为本机字节序
+  dst.create(h.width, h.height, h.channels, h.type());
+  file.clear();
+  file.seekg(static_cast<std::streamoff>(h.data_offset));
+  const size_t row_bytes = h.row_bytes();
+  for (int y = 0; y < h.height && file; ++y) {
+    uint8_t *row = dst.ptr<uint8_t>(y);
+    file.read(reinterpret_cast<char *>(row),
+              static_cast<std::streamsize>(row_bytes));
+    if (h.sample_bytes() == 2)
+      convert_be16(row, reinterpret_cast<uint16_t *>(row), row_bytes / 2);
+  }
+  if (!file)
+    return fail(error, "failed to read '" + path + "'");
+  return true;
+}
+
+bool PnmReader::open(const std::string &path) {
+  close();
+  auto mapping = std::make_shared<Mapping>();
+
+#if defined(DIP_HAVE_MMAP)
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    error_ = "cannot open '" + path + "': " + std::strerror(errno);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    error_ = "cannot stat '" + path + "' or file is empty";
+    ::close(fd);
+    return false;
+  }
+  mapping->size = static_cast<size_t>(st.st_size);
+  // 私有可写映射：返回的图像可以修改（写时复制），不会写回文件
+  void *p = mmap(nullptr, mapping->size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                 fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED) {
+    error_ = "mmap failed for '" + path + "': " + std::strerror(errno);
+    return false;
+  }
+  mapping->data = static_cast<uint8_t *>(p);
+  mapping->mapped = true;
+#else
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    error_ = "cannot open '" + path + "'";
+    return false;
+  }
+  mapping->buffer.resize(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(reinterpret_cast<char *>(mapping->buffer.data()),
+            mapping->buffer.size());
+  mapping->data = mapping->buffer.data();
+  mapping->size = mapping->buffer.size();
+#endif
+
+  if (!parse_pnm_header(mapping->data, mapping->size, header_, &error_)) {
+    error_ = "'" + path + "': " + error_;
+    return false;
+  }
+  mapping_ = std::move(mapping);
+  error_.clear();
+  return true;
+}
+
+void PnmReader::close() {
+  mapping_.reset();
+  header_ = PnmHeader();
+}
+
+const uint8_t *PnmReader::row_data(int y) const {
+  if (!mapping_)
+    throw std::logic_error("PnmReader is not open");
+  if (y < 0 || y >= header_.height)
+    throw std::out_of_range("Row index out of range");
+  return mapping_->data + header_.data_offset +
+         static_cast<size_t>(y) * header_.row_bytes();
+}
+
+void PnmReader::read_rows(int y0, int count, Image &dst) const {
+  if (!mapping_)
+    throw std::logic_error("PnmReader is not open");
+  if (y0 < 0 || count < 0 || y0 + count > header_.height)
+    throw std::out_of_range("Row range out of range");
+
+  dst.create(header_.width, count, header_.channels, header_.type());
+  const size_t samples = static_cast<size_t>(header_.width) * header_.channels;
+  for (int i = 0; i < count; ++i) {
+    const uint8_t *src = row_data(y0 + i);
+    if (header_.sample_bytes() == 1)
+      std::memcpy(dst.ptr<uint8_t>(i), src, samples);
+    else
+      convert_be16(src, dst.ptr<uint16_t>(i), samples);
+  }
+}
+
+Image PnmReader::image() const {
+  if (!mapping_)
+    throw std::logic_error("PnmReader is not open");
+  return view_rows(0, header_.height);
+}
+
+Image PnmReader::view_rows(int y0, int count) const {
+  if (!mapping_)
+    throw std::logic_error("PnmReader is not open");
+  if (y0 < 0 || count < 0 || y0 + count > header_.height)
+    throw std::out_of_range("Row range out of range");
+
+  if (header_.sample_bytes() == 1 && count > 0) {
+    // 像素数据按行连续存放，直接引用映射内存
+    Matrix mat = Matrix::fromExternal(
+        count, header_.width * header_.channels, DataType::UINT8,
+        mapping_->data + header_.data_offset +
+            static_cast<size_t>(y0) * header_.row_bytes(),
+        mapping_);
+    return Image(std::move(mat), header_.channels);
+  }
+
+  Image result;
+  read_rows(y0, count, result);
+  return result;
+}
+
+void PnmReader::release_rows(int y0, int count) const {
+#if defined(DIP_HAVE_MMAP)
+  if (!mapping_ || !mapping_->mapped || count <= 0)
+    return;
+  // 只释放完全落在行区间内的页
+  const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t begin = header_.data_offset +
+                       static_cast<size_t>(std::max(0, y0)) *
+                           header_.row_bytes();
+  const size_t end =
+      std::min(mapping_->size,
+               header_.data_offset +
+                   static_cast<size_t>(std::min(y0 + count, header_.height)) *
+                       header_.row_bytes());
+  const size_t first = (begin + page - 1) / page * page;
+  const size_t last = end / page * page;
+  if (first < last)
+    madvise(mapping_->data + first, last - first, MADV_DONTNEED);
+#else
+  (void)y0;
+  (void)count;
+#endif
+}
+
+void PnmReader::advise_sequential() const {
+#if defined(DIP_HAVE_MMAP)
+  if (mapping_ && mapping_->mapped)
+    madvise(mapping_->data, mapping_->size, MADV_SEQUENTIAL);
+#endif
+}
+
+} // namespace dip
@@ -0,0 +1,537 @@
+#include <core/float16.hpp>
+#include <core/simd.hpp>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DIP_SIMD_X86 1
+#endif
+
+// 各级别内核使用 target 属性单独编译，库本身仍按基线指令集构建，
+// 不支持高级指令集的CPU不会执行到对应代码
+
+namespace dip {
+namespace simd {
+
+namespace {
+
+struct KernelTable {
+  void (*subtract_from)(const uint8_t *, uint8_t *, size_t, int);
+  void (*quantize)(const uint8_t *, uint8_t *, size_t, int);
+  void (*binary_and)(const uint8_t *, const uint8_t *, uint8_t *, size_t);
+  void (*binary_xor)(const uint8_t *, const uint8_t *, uint8_t *, size_t);
+  void (*accumulate)(const uint8_t *, uint32_t *, size_t);
+  void (*convert_u8_f32)(const uint8_t *, float *, size_t);
+  void (*convert_f32_u8)(const float *, uint8_t *, size_t);
+  void (*convert_f16_f32)(const uint16_t *, float *, size_t);
+  void (*convert_f32_f16)(const float *, uint16_t *, size_t);
+};
+
+// ---------------------------------------------------------------------------
+// 标量实现（同时用于处理向量版本的尾部元素）
+namespace scalar {
+
+void subtract_from(const uint8_t *src, uint8_t *dst, size_t n, int k) {
+  for (size_t i = 0; i < n; ++i)
+    dst[i] = static_cast<uint8_t>(k - src[i]);
+}
+
+void quantize(const uint8_t *src, uint8_t *dst, size_t n, int step) {
+  for (size_t i = 0; i < n; ++i)
+    dst[i] = static_cast<uint8_t>((src[i] / step) * step + step / 2);
+}
+
+// 8位值除以 step（2..256）的定点倒数：对 0..255 的被除数，
+// (x * m) >> 16 与 x / step 相等（误差 x * (m * step - 65536) < 65536）
+inline int reciprocal(int step) { return 65536 / step + 1; }
+
+void binary_and(const uint8_t *a, const uint8_t *b, uint8_t *dst, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    dst[i] = (a[i] == 1 && b[i] == 1) ? 1 : 0;
+}
+
+void binary_xor(const uint8_t *a, const uint8_t *b, uint8_t *dst, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    dst[i] = (a[i] != b[i]) ? 1 : 0;
+}
+
+void accumulate(const uint8_t *src, uint32_t *acc, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    acc[i] += src[i];
+}
+
+void convert_u8_f32(const uint8_t *src, float *dst, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    dst[i] = static_cast<float>(src[i]);
+}
+
+void convert_f32_u8(const float *src, uint8_t *dst, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    dst[i] = static_cast<uint8_t>(src[i]);
+}
+
+void convert_f16_f32(const uint16_t *src, float *dst, size_t n) {
+  halfToFloat(src, dst, n);
+}
+
+void convert_f32_f16(const float *src, uint16_t *dst, size_t n) {
+  floatToHalf(src, dst, n);
+}
+
+} // namespace scalar
+
+#if defined(DIP_SIMD_X86)
+
+// ---------------------------------------------------------------------------
+// SSE2（128位）
+namespace sse2 {
+
+#define DIP_TARGET __attribute__((target("sse2")))
+
+DIP_TARGET void subtract_from(const uint8_t *src, uint8_t *dst, size_t n,
+                              int k) {
+  const __m128i vk = _mm_set1_epi8(static_cast<char>(k));
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                     _mm_sub_epi8(vk, s));
+  }
+  scalar::subtract_from(src + i, dst + i, n - i, k);
+}
+
+// 按16位通道计算商和结果，取低8位后打包
+DIP_TARGET void quantize(const uint8_t *src, uint8_t *dst, size_t n,
+                         int step) {
+  if (step == 1) // 结果等于输入，且倒数超出16位
+    return scalar::quantize(src, dst, n, step);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i m =
+      _mm_set1_epi16(static_cast<short>(scalar::reciprocal(step)));
+  const __m128i vstep = _mm_set1_epi16(static_cast<short>(step));
+  const __m128i half = _mm_set1_epi16(static_cast<short>(step / 2));
+  const __m128i low = _mm_set1_epi16(0xff);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i w[2] = {_mm_unpacklo_epi8(s, zero), _mm_unpackhi_epi8(s, zero)};
+    for (int j = 0; j < 2; ++j) {
+      __m128i q = _mm_mulhi_epu16(w[j], m);
+      w[j] = _mm_and_si128(_mm_add_epi16(_mm_mullo_epi16(q, vstep), half), low);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                     _mm_packus_epi16(w[0], w[1]));
+  }
+  scalar::quantize(src + i, dst + i, n - i, step);
+}
+
+DIP_TARGET void binary_and(const uint8_t *a, const uint8_t *b, uint8_t *dst,
+                           size_t n) {
+  const __m128i one = _mm_set1_epi8(1);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+    __m128i eq =
+        _mm_and_si128(_mm_cmpeq_epi8(va, one), _mm_cmpeq_epi8(vb, one));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                     _mm_and_si128(eq, one));
+  }
+  scalar::binary_and(a + i, b + i, dst + i, n - i);
+}
+
+DIP_TARGET void binary_xor(const uint8_t *a, const uint8_t *b, uint8_t *dst,
+                           size_t n) {
+  const __m128i one = _mm_set1_epi8(1);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                     _mm_andnot_si128(_mm_cmpeq_epi8(va, vb), one));
+  }
+  scalar::binary_xor(a + i, b + i, dst + i, n - i);
+}
+
+DIP_TARGET void accumulate(const uint8_t *src, uint32_t *acc, size_t n) {
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i lo = _mm_unpacklo_epi8(s, zero);
+    __m128i hi = _mm_unpackhi_epi8(s, zero);
+    __m128i w[4] = {
+        _mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero),
+        _mm_unpacklo_epi16(hi, zero), _mm_unpackhi_epi16(hi, zero)};
+    for (int j = 0; j < 4; ++j) {
+      __m128i *p = reinterpret_cast<__m128i *>(acc + i + j * 4);
+      _mm_storeu_si128(p, _mm_add_epi32(_mm_loadu_si128(p), w[j]));
+    }
+  }
+  scalar::accumulate(src + i, acc + i, n - i);
+}
+
+DIP_TARGET void convert_u8_f32(const uint8_t *src, float *dst, size_t n) {
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i lo = _mm_unpacklo_epi8(s, zero);
+    __m128i hi = _mm_unpackhi_epi8(s, zero);
+    __m128i w[4] = {
+        _mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero),
+        _mm_unpacklo_epi16(hi, zero), _mm_unpackhi_epi16(hi, zero)};
+    for (int j = 0; j < 4; ++j) {
+      _mm_storeu_ps(dst + i + j * 4, _mm_cvtepi32_ps(w[j]));
+    }
+  }
+  scalar::convert_u8_f32(src + i, dst + i, n - i);
+}
+
+DIP_TARGET void convert_f32_u8(const float *src, uint8_t *dst, size_t n) {
+  // 截断为int32后只保留低8位，再打包（值已在0-255内，饱和打包不改变结果）
+  const __m128i mask = _mm_set1_epi32(0xff);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i v0 = _mm_and_si128(_mm_cvttps_epi32(_mm_loadu_ps(src + i)), mask);
+    __m128i v1 =
+        _mm_and_si128(_mm_cvttps_epi32(_mm_loadu_ps(src + i + 4)), mask);
+    __m128i v2 =
+        _mm_and_si128(_mm_cvttps_epi32(_mm_loadu_ps(src + i + 8)), mask);
+    __m128i v3 =
+        _mm_and_si128(_mm_cvttps_epi32(_mm_loadu_ps(src + i + 12)), mask);
+    __m128i w = _mm_packus_epi16(_mm_packs_epi32(v0, v1),
+                                 _mm_packs_epi32(v2, v3));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), w);
+  }
+  scalar::convert_f32_u8(src + i, dst + i, n - i);
+}
+
+#undef DIP_TARGET
+
+} // namespace sse2
+
+// ---------------------------------------------------------------------------
+// AVX2（256位，含F16C）
+namespace avx2 {
+
+#define DIP_TARGET __attribute__((target("avx2,f16c")))
+
+DIP_TARGET void subtract_from(const uint8_t *src, uint8_t *dst, size_t n,
+                              int k) {
+  const __m256i vk = _mm256_set1_epi8(static_cast<char>(k));
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                        _mm256_sub_epi8(vk, s));
+  }
+  scalar::subtract_from(src + i, dst + i, n - i, k);
+}
+
+// 解包与打包都在128位通道内进行，顺序互逆，无需重排
+DIP_TARGET void quantize(const uint8_t *src, uint8_t *dst, size_t n,
+                         int step) {
+  if (step == 1)
+    return scalar::quantize(src, dst, n, step);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i m =
+      _mm256_set1_epi16(static_cast<short>(scalar::reciprocal(step)));
+  const __m256i vstep = _mm256_set1_epi16(static_cast<short>(step));
+  const __m256i half = _mm256_set1_epi16(static_cast<short>(step / 2));
+  const __m256i low = _mm256_set1_epi16(0xff);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    __m256i w[2] = {_mm256_unpacklo_epi8(s, zero),
+                    _mm256_unpackhi_epi8(s, zero)};
+    for (int j = 0; j < 2; ++j) {
+      __m256i q = _mm256_mulhi_epu16(w[j], m);
+      w[j] = _mm256_and_si256(
+          _mm256_add_epi16(_mm256_mullo_epi16(q, vstep), half), low);
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                        _mm256_packus_epi16(w[0], w[1]));
+  }
+  scalar::quantize(src + i, dst + i, n - i, step);
+}
+
+DIP_TARGET void binary_and(const uint8_t *a, const uint8_t *b, uint8_t *dst,
+                           size_t n) {
+  const __m256i one = _mm256_set1_epi8(1);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+    __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(va, one),
+                                  _mm256_cmpeq_epi8(vb, one));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                        _mm256_and_si256(eq, one));
+  }
+  scalar::binary_and(a + i, b + i, dst + i, n - i);
+}
+
+DIP_TARGET void binary_xor(const uint8_t *a, const uint8_t *b, uint8_t *dst,
+                           size_t n) {
+  const __m256i one = _mm256_set1_epi8(1);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                        _mm256_andnot_si256(_mm256_cmpeq_epi8(va, vb), one));
+  }
+  scalar::binary_xor(a + i, b + i, dst + i, n - i);
+}
+
+DIP_TARGET void accumulate(const uint8_t *src, uint32_t *acc, size_t n) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i s = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + i));
+    __m256i *p = reinterpret_cast<__m256i *>(acc + i);
+    _mm256_storeu_si256(
+        p, _mm256_add_epi32(_mm256_loadu_si256(p), _mm256_cvtepu8_epi32(s)));
+  }
+  scalar::accumulate(src + i, acc + i, n - i);
+}
+
+DIP_TARGET void convert_u8_f32(const uint8_t *src, float *dst, size_t n) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i s = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(s)));
+  }
+  scalar::convert_u8_f32(src + i, dst + i, n - i);
+}
+
+DIP_TARGET void convert_f32_u8(const float *src, uint8_t *dst, size_t n) {
+  const __m256i mask = _mm256_set1_epi32(0xff);
+  // 256位打包指令按128位通道交错，最后按双字重排恢复顺序
+  const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i v0 =
+        _mm256_and_si256(_mm256_cvttps_epi32(_mm256_loadu_ps(src + i)), mask);
+    __m256i v1 = _mm256_and_si256(
+        _mm256_cvttps_epi32(_mm256_loadu_ps(src + i + 8)), mask);
+    __m256i v2 = _mm256_and_si256(
+        _mm256_cvttps_epi32(_mm256_loadu_ps(src + i + 16)), mask);
+    __m256i v3 = _mm256_and_si256(
+        _mm256_cvttps_epi32(_mm256_loadu_ps(src + i + 24)), mask);
+    __m256i w = _mm256_packus_epi16(_mm256_packus_epi32(v0, v1),
+                                    _mm256_packus_epi32(v2, v3));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                        _mm256_permutevar8x32_epi32(w, order));
+  }
+  scalar::convert_f32_u8(src + i, dst + i, n - i);
+}
+
+DIP_TARGET void convert_f16_f32(const uint16_t *src, float *dst, size_t n) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+  }
+  for (; i < n; ++i)
+    dst[i] = _cvtsh_ss(src[i]);
+}
+
+DIP_TARGET void convert_f32_f16(const float *src, uint16_t *dst, size_t n) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i h =
+        _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), h);
+  }
+  for (; i < n; ++i)
+    dst[i] = _cvtss_sh(src[i], _MM_FROUND_TO_NEAREST_INT);
+}
+
+#undef DIP_TARGET
+
+} // namespace avx2
+
+// ---------------------------------------------------------------------------
+// AVX-512（512位，需要AVX-512BW的字节运算）
+namespace avx512 {
+
+#define DIP_TARGET __attribute__((target("avx512f,avx512bw,avx2,f16c")))
+
+DIP_TARGET void subtract_from(const uint8_t *src, uint8_t *dst, size_t n,
+                              int k) {
+  const __m512i vk = _mm512_set1_epi8(static_cast<char>(k));
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    __m512i s = _mm512_loadu_si512(src + i);
+    _mm512_storeu_si512(dst + i, _mm512_sub_epi8(vk, s));
+  }
+  avx2::subtract_from(src + i, dst + i, n - i, k);
+}
+
+DIP_TARGET void quantize(const uint8_t *src, uint8_t *dst, size_t n,
+                         int step) {
+  if (step == 1)
+    return scalar::quantize(src, dst, n, step);
+  const __m512i zero = _mm512_setzero_si512();
+  const __m512i m =
+      _mm512_set1_epi16(static_cast<short>(scalar::reciprocal(step)));
+  const __m512i vstep = _mm512_set1_epi16(static_cast<short>(step));
+  const __m512i half = _mm512_set1_epi16(static_cast<short>(step / 2));
+  const __m512i low = _mm512_set1_epi16(0xff);
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    __m512i s = _mm512_loadu_si512(src + i);
+    __m512i w[2] = {_mm512_unpacklo_epi8(s, zero),
+                    _mm512_unpackhi_epi8(s, zero)};
+    for (int j = 0; j < 2; ++j) {
+      __m512i q = _mm512_mulhi_epu16(w[j], m);
+      w[j] = _mm512_and_si512(
+          _mm512_add_epi16(_mm512_mullo_epi16(q, vstep), half), low);
+    }
+    _mm512_storeu_si512(dst + i, _mm512_packus_epi16(w[0], w[1]));
+  }
+  avx2::quantize(src + i, dst + i, n - i, step);
+}
+
+DIP_TARGET void binary_and(const uint8_t *a, const uint8_t *b, uint8_t *dst,
+                           size_t n) {
+  const __m512i one = _mm512_set1_epi8(1);
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    __mmask64 m = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(a + i), one) &
+                  _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(b + i), one);
+    _mm512_storeu_si512(dst + i, _mm512_maskz_mov_epi8(m, one));
+  }
+  avx2::binary_and(a + i, b + i, dst + i, n - i);
+}
+
+DIP_TARGET void binary_xor(const uint8_t *a, const uint8_t *b, uint8_t *dst,
+                           size_t n) {
+  const __m512i one = _mm512_set1_epi8(1);
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    __mmask64 m = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(a + i),
+                                          _mm512_loadu_si512(b + i));
+    _mm512_storeu_si512(dst + i, _mm512_maskz_mov_epi8(m, one));
+  }
+  avx2::binary_xor(a + i, b + i, dst + i, n - i);
+}
+
+DIP_TARGET void accumulate(const uint8_t *src, uint32_t *acc, size_t n) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m512i sum =
+        _mm512_add_epi32(_mm512_loadu_si512(acc + i), _mm512_cvtepu8_epi32(s));
+    _mm512_storeu_si512(acc + i, sum);
+  }
+  avx2::accumulate(src + i, acc + i, n - i);
+}
+
+DIP_TARGET void convert_u8_f32(const uint8_t *src, float *dst, size_t n) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm512_storeu_ps(dst + i, _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(s)));
+  }
+  avx2::convert_u8_f32(src + i, dst + i, n - i);
+}
+
+DIP_TARGET void convert_f32_u8(const float *src, uint8_t *dst, size_t n) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    // vpmovdb 直接截断取低8位
+    __m512i v = _mm512_cvttps_epi32(_mm512_loadu_ps(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                     _mm512_cvtepi32_epi8(v));
+  }
+  avx2::convert_f32_u8(src + i, dst + i, n - i);
+}
+
+DIP_TARGET void convert_f16_f32(const uint16_t *src, float *dst, size_t n) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    _mm512_storeu_ps(dst + i, _mm512_cvtph_ps(h));
+  }
+  avx2::convert_f16_f32(src + i, dst + i, n - i);
+}
+
+DIP_TARGET void convert_f32_f16(const float *src, uint16_t *dst, size_t n) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256i h =
+        _mm512_cvtps_ph(_mm512_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), h);
+  }
+  avx2::convert_f32_f16(src + i, dst + i, n - i);
+}
+
+#undef DIP_TARGET
+
+} // namespace avx512
+
+#endif // DIP_SIMD_X86
+
+// 按 CpuLevel 顺序排列；SSE2 没有半精度指令，使用标量实现
+const KernelTable kTables[] = {
+    {scalar::subtract_from, scalar::quantize, scalar::binary_and,
+     scalar::binary_xor, scalar::accumulate, scalar::convert_u8_f32,
+     scalar::convert_f32_u8, scalar::convert_f16_f32, scalar::convert_f32_f16},
+#if defined(DIP_SIMD_X86)
+    {sse2::subtract_from, sse2::quantize, sse2::binary_and, sse2::binary_xor,
+     sse2::accumulate, sse2::convert_u8_f32, sse2::convert_f32_u8,
+     scalar::convert_f16_f32, scalar::convert_f32_f16},
+    {avx2::subtract_from, avx2::quantize, avx2::binary_and, avx2::binary_xor,
+     avx2::accumulate, avx2::convert_u8_f32, avx2::convert_f32_u8,
+     avx2::convert_f16_f32, avx2::convert_f32_f16},
+    {avx512::subtract_from, avx512::quantize, avx512::binary_and,
+     avx512::binary_xor, avx512::accumulate, avx512::convert_u8_f32,
+     avx512::convert_f32_u8, avx512::convert_f16_f32, avx512::convert_f32_f16},
+#endif
+};
+
+const KernelTable &kernels() {
+  // 非x86平台 detect_cpu_level() 只会返回 SCALAR
+  return kTables[static_cast<int>(cpu_level())];
+}
+
+} // namespace
+
+void subtract_from(const uint8_t *src, uint8_t *dst, size_t n, int k) {
+  kernels().subtract_from(src, dst, n, k);
+}
+
+void quantize(const uint8_t *src, uint8_t *dst, size_t n, int step) {
+  kernels().quantize(src, dst, n, step);
+}
+
+void binary_and(const uint8_t *a, const uint8_t *b, uint8_t *dst, size_t n) {
+  kernels().binary_and(a, b, dst, n);
+}
+
+void binary_xor(const uint8_t *a, const uint8_t *b, uint8_t *dst, size_t n) {
+  kernels().binary_xor(a, b, dst, n);
+}
+
+void accumulate(const uint8_t *src, uint32_t *acc, size_t n) {
+  kernels().accumulate(src, acc, n);
+}
+
+void convert_u8_f32(const uint8_t *src, float *dst, size_t n) {
+  kernels().convert_u8_f32(src, dst, n);
+}
+
+void convert_f32_u8(const float *src, uint8_t *dst, size_t n) {
+  kernels().convert_f32_u8(src, dst, n);
+}
+
+void convert_f16_f32(const uint16_t *src, float *dst, size_t n) {
+  kernels().convert_f16_f32(src, dst, n);
+}
+
+void convert_f32_f16(const float *src, uint16_t *dst, size_t n) {
+  kernels().convert_f32_f16(src, dst, n);
+}
+
+} // namespace simd
+} // namespace dip
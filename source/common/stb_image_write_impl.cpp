@@ -0,0 +1,4 @@
+// STB_IMAGE_WRITE_IMPLEMENTATION
+// 这个宏定义必须在包含 stb_image_write.h 之前定义一次且仅一次
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb/stb_image_write.h>
@@ -0,0 +1,151 @@
+#include <core/strip_io.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace dip {
+
+bool StripReader::open(const std::string &path, int band_rows, int halo) {
+  close();
+  if (band_rows < 1 || halo < 0) {
+    error_ = "band_rows must be at least 1 and halo non-negative";
+    return false;
+  }
+  if (!reader_.open(path)) {
+    error_ = reader_.error();
+    return false;
+  }
+  band_rows_ = band_rows;
+  halo_ = halo;
+  reader_.advise_sequential();
+  error_.clear();
+  return true;
+}
+
+void StripReader::close() {
+  reader_.close();
+  next_y_ = 0;
+  released_y_ = 0;
+}
+
+bool StripReader::next(Band &band) {
+  if (!is_open() || next_y_ >= height())
+    return false;
+  read_band(next_y_, band_rows_, band);
+  next_y_ += band.rows;
+  return true;
+}
+
+void StripReader::read_band(int y, int rows, Band &band) {
+  if (!is_open())
+    throw std::logic_error("StripReader is not open");
+  y = std::max(0, y);
+  rows = std::min(rows, height() - y);
+  if (rows <= 0)
+    throw std::out_of_range("Band is outside the image");
+
+  const int first = std::max(0, y - halo_);
+  const int last = std::min(height(), y + rows + halo_);
+  band.y = y;
+  band.rows = rows;
+  band.halo_top = y - first;
+  band.halo_bottom = last - (y + rows);
+  reader_.read_rows(first, last - first, band.image);
+
+  // 向前读取时释放之前行带占用的页
+  if (first > released_y_) {
+    reader_.release_rows(released_y_, first - released_y_);
+    released_y_ = first;
+  }
+}
+
+bool StripWriter::open(const std::string &path, int width, int height,
+                       int channels, DataType type) {
+  close();
+  if (width <= 0 || height <= 0 || (channels != 1 && channels != 3) ||
+      (type != DataType::UINT8 && type != DataType::UINT16)) {
+    error_ = "Only non-empty 1 or 3 channel UINT8/UINT16 images supported";
+    return false;
+  }
+  target_.reset(path);
+  file_.open(target_.path(), std::ios::binary);
+  if (!file_.is_open()) {
+    target_.discard();
+    error_ = "Cannot open file for writing: " + path;
+    return false;
+  }
+
+  width_ = width;
+  height_ = height;
+  channels_ = channels;
+  type_ = type;
+  rows_written_ = 0;
+  error_.clear();
+  file_ << (channels == 1 ? "P5\n" : "P6\n");
+  file_ << width << " " << height << "\n";
+  file_ << (type == DataType::UINT16 ? "65535\n" : "255\n");
+  return true;
+}
+
+void StripWriter::write(const Image &rows, int y0, int count) {
+  if (!file_.is_open())
+    throw std::runtime_error("StripWriter is not open");
+  if (rows.width() != width_ || rows.channels() != channels_ ||
+      rows.type() != type_)
+    throw std::invalid_argument("Rows do not match the output image");
+  // 先检查 y0，避免默认的 count 为负；用减法比较避免 y0 + count 溢出
+  if (y0 < 0 || y0 > rows.height())
+    throw std::invalid_argument("Row range out of range");
+  if (count < 0)
+    count = rows.height() - y0;
+  if (count > rows.height() - y0)
+    throw std::invalid_argument("Row range out of range");
+  if (count > height_ - rows_written_)
+    throw std::invalid_argument("More rows than the output image height");
+
+  const size_t samples = static_cast<size_t>(width_) * channels_;
+  if (type_ == DataType::UINT8 && rows.matrix().step() == samples) {
+    // 行紧密排列时一次写出
+    file_.write(reinterpret_cast<const char *>(rows.ptr<uint8_t>(y0)),
+                samples * count);
+  } else if (type_ == DataType::UINT8) {
+    // ROI 图像的行跨度大于行宽，逐行写出
+    for (int y = y0; y < y0 + count; ++y)
+      file_.write(reinterpret_cast<const char *>(rows.ptr<uint8_t>(y)),
+                  samples);
+  } else {
+    buffer_.resize(samples * 2);
+    for (int y = y0; y < y0 + count; ++y) {
+      const uint16_t *src = rows.ptr<uint16_t>(y);
+      for (size_t i = 0; i < samples; ++i) {
+        buffer_[2 * i] = static_cast<uint8_t>(src[i] >> 8);
+        buffer_[2 * i + 1] = static_cast<uint8_t>(src[i] & 0xFF);
+      }
+      file_.write(reinterpret_cast<const char *>(buffer_.data()),
+                  buffer_.size());
+    }
+  }
+  if (!file_)
+    throw std::runtime_error("Failed to write image rows");
+  rows_written_ += count;
+}
+
+bool StripWriter::close() {
+  if (!file_.is_open())
+    return error_.empty();
+  file_.close();
+  if (!file_) {
+    target_.discard();
+    error_ = "Failed to write image file";
+    return false;
+  }
+  if (rows_written_ != height_) {
+    target_.discard();
+    error_ = "Wrote " + std::to_string(rows_written_) + " of " +
+             std::to_string(height_) + " rows";
+    return false;
+  }
+  return target_.commit(&error_);
+}
+
+} // namespace dip
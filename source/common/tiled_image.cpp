@@ -0,0 +1,383 @@
+#include <core/tiled_image.hpp>
+#include <core/atomic_file.hpp>
+#include <core/strip_io.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DIP_HAVE_PREAD 1
+#endif
+
+namespace dip {
+
+// 打开的分块文件；支持 pread 时各线程可以并发读取，否则串行读取
+struct TiledImage::File {
+#if defined(DIP_HAVE_PREAD)
+  int fd = -1;
+
+  ~File() {
+    if (fd >= 0)
+      ::close(fd);
+  }
+
+  bool open(const std::string &path) {
+    fd = ::open(path.c_str(), O_RDONLY);
+    return fd >= 0;
+  }
+
+  uint64_t size() const {
+    struct stat st;
+    return fstat(fd, &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+  }
+
+  bool read(void *dst, size_t bytes, uint64_t offset) {
+    auto *out = static_cast<uint8_t *>(dst);
+    while (bytes > 0) {
+      const ssize_t n = pread(fd, out, bytes, static_cast<off_t>(offset));
+      if (n <= 0)
+        return false;
+      out += n;
+      bytes -= static_cast<size_t>(n);
+      offset += static_cast<uint64_t>(n);
+    }
+    return true;
+  }
+#else
+  std::ifstream stream;
+  std::mutex mutex;
+
+  bool open(const std::string &path) {
+    stream.open(path, std::ios::binary);
+    return stream.is_open();
+  }
+
+  uint64_t size() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stream.seekg(0, std::ios::end);
+    return static_cast<uint64_t>(stream.tellg());
+  }
+
+  bool read(void *dst, size_t bytes, uint64_t offset) {
+    std::lock_guard<std::mutex> lock(mutex);
+    stream.clear();
+    stream.seekg(static_cast<std::streamoff>(offset));
+    stream.read(static_cast<char *>(dst),
+                static_cast<std::streamsize>(bytes));
+    return static_cast<bool>(stream);
+  }
+#endif
+};
+
+namespace {
+
+// 分块文件头（主机字节序），像素数据从 kDataOffset 开始
+constexpr char kMagic[8] = {'D', 'I', 'P', 'T', 'I', 'L', 'E', '1'};
+constexpr size_t kHeaderFields = 6;
+constexpr uint64_t kDataOffset = 64;
+
+bool fail(std::string *error, const std::string &message) {
+  if (error)
+    *error = message;
+  return false;
+}
+
+bool write_header(std::ofstream &out, int width, int height, int channels,
+                  DataType type, int tile_size) {
+  uint8_t header[kDataOffset] = {};
+  const uint32_t fields[kHeaderFields] = {
+      static_cast<uint32_t>(width),     static_cast<uint32_t>(height),
+      static_cast<uint32_t>(channels),  static_cast<uint32_t>(type),
+      static_cast<uint32_t>(tile_size), static_cast<uint32_t>(tile_size)};
+  std::memcpy(header, kMagic, sizeof(kMagic));
+  std::memcpy(header + sizeof(kMagic), fields, sizeof(fields));
+  out.write(reinterpret_cast<const char *>(header), sizeof(header));
+  return static_cast<bool>(out);
+}
+
+// 将 rows 的第 [y0, y0 + count) 行切分为一行分块写出，不足部分补零
+bool write_tile_row(std::ofstream &out, const Image &rows, int y0, int count,
+                    int tile_size, std::vector<uint8_t> &buffer) {
+  const size_t elem = dataTypeSize(rows.type());
+  const size_t tile_row_bytes =
+      static_cast<size_t>(tile_size) * rows.channels() * elem;
+  buffer.resize(tile_row_bytes * tile_size);
+
+  for (int x0 = 0; x0 < rows.width(); x0 += tile_size) {
+    const size_t bytes =
+        static_cast<size_t>(std::min(tile_size, rows.width() - x0)) *
+        rows.channels() * elem;
+    const size_t offset = static_cast<size_t>(x0) * rows.channels() * elem;
+    std::fill(buffer.begin(), buffer.end(), 0);
+    for (int y = 0; y < count; ++y)
+      std::memcpy(buffer.data() + y * tile_row_bytes,
+                  rows.ptr<uint8_t>(y0 + y) + offset, bytes);
+    out.write(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+  }
+  return static_cast<bool>(out);
+}
+
+} // namespace
+
+bool TiledImage::build(const Image &image, const std::string &store_path,
+                       int tile_size, std::string *error) {
+  if (image.empty())
+    return fail(error, "Cannot build tiles from an empty image");
+  if (tile_size < 1)
+    return fail(error, "tile_size must be at least 1");
+
+  AtomicFile target(store_path);
+  std::ofstream out(target.path(), std::ios::binary);
+  if (!out.is_open())
+    return fail(error, "Cannot open file for writing: " + store_path);
+  if (!write_header(out, image.width(), image.height(), image.channels(),
+                    image.type(), tile_size))
+    return fail(error, "Failed to write tile store: " + store_path);
+
+  std::vector<uint8_t> buffer;
+  for (int y = 0; y < image.height(); y += tile_size) {
+    const int count = std::min(tile_size, image.height() - y);
+    if (!write_tile_row(out, image, y, count, tile_size, buffer))
+      return fail(error, "Failed to write tile store: " + store_path);
+  }
+  out.close();
+  if (!out)
+    return fail(error, "Failed to write tile store: " + store_path);
+  return target.commit(error);
+}
+
+bool TiledImage::build_from_pnm(const std::string &pnm_path,
+                                const std::string &store_path, int tile_size,
+                                std::string *error) {
+  if (tile_size < 1)
+    return fail(error, "tile_size must be at least 1");
+
+  // 每个行带正好是一行分块
+  StripReader reader;
+  if (!reader.open(pnm_path, tile_size))
+    return fail(error, reader.error());
+
+  AtomicFile target(store_path);
+  std::ofstream out(target.path(), std::ios::binary);
+  if (!out.is_open())
+    return fail(error, "Cannot open file for writing: " + store_path);
+  if (!write_header(out, reader.width(), reader.height(), reader.channels(),
+                    reader.type(), tile_size))
+    return fail(error, "Failed to write tile store: " + store_path);
+
+  Band band;
+  std::vector<uint8_t> buffer;
+  while (reader.next(band)) {
+    if (!write_tile_row(out, band.image, 0, band.rows, tile_size, buffer))
+      return fail(error, "Failed to write tile store: " + store_path);
+  }
+  out.close();
+  if (!out)
+    return fail(error, "Failed to write tile store: " + store_path);
+  return target.commit(error);
+}
+
+bool TiledImage::open(const std::string &store_path, size_t cache_bytes) {
+  close();
+  auto file = std::make_shared<File>();
+  if (!file->open(store_path)) {
+    error_ = "Cannot open file: " + store_path;
+    return false;
+  }
+
+  uint8_t header[kDataOffset];
+  uint32_t fields[kHeaderFields];
+  if (file->size() < kDataOffset || !file->read(header, kDataOffset, 0) ||
+      std::memcmp(header, kMagic, sizeof(kMagic)) != 0) {
+    error_ = "Not a tile store: " + store_path;
+    return false;
+  }
+  std::memcpy(fields, header + sizeof(kMagic), sizeof(fields));
+
+  const int elem = fields[3] <= static_cast<uint32_t>(DataType::FLOAT64)
+                       ? dataTypeSize(static_cast<DataType>(fields[3]))
+                       : 0;
+  if (fields[0] == 0 || fields[1] == 0 || fields[2] == 0 || elem == 0 ||
+      fields[4] == 0 || fields[5] == 0 || fields[0] > INT32_MAX ||
+      fields[1] > INT32_MAX || fields[4] > INT32_MAX ||
+      fields[5] > INT32_MAX || fields[2] > INT32_MAX) {
+    error_ = "Invalid tile store header: " + store_path;
+    return false;
+  }
+
+  // 分块的一行样本数必须能表示为 Matrix 的列数
+  const uint64_t tile_samples = static_cast<uint64_t>(fields[4]) * fields[2];
+  if (tile_samples > INT32_MAX) {
+    error_ = "Invalid tile store header: " + store_path;
+    return false;
+  }
+
+  // 逐项与文件中的可用字节数比较，避免分块大小或分块总数的乘积溢出
+  const uint64_t tiles_x = (static_cast<uint64_t>(fields[0]) + fields[4] - 1) /
+                           fields[4];
+  const uint64_t tiles_y = (static_cast<uint64_t>(fields[1]) + fields[5] - 1) /
+                           fields[5];
+  const uint64_t available = file->size() - kDataOffset;
+  const uint64_t tile_row_bytes = tile_samples * elem;
+  if (fields[5] > available / tile_row_bytes ||
+      tiles_x * tiles_y > available / (tile_row_bytes * fields[5])) {
+    error_ = "Truncated tile store: " + store_path;
+    return false;
+  }
+
+  width_ = static_cast<int>(fields[0]);
+  height_ = static_cast<int>(fields[1]);
+  channels_ = static_cast<int>(fields[2]);
+  type_ = static_cast<DataType>(fields[3]);
+  tile_width_ = static_cast<int>(fields[4]);
+  tile_height_ = static_cast<int>(fields[5]);
+  tiles_x_ = static_cast<int>(tiles_x);
+  tiles_y_ = static_cast<int>(tiles_y);
+  data_offset_ = kDataOffset;
+  tile_bytes_ = static_cast<size_t>(tile_row_bytes * fields[5]);
+
+  file_ = std::move(file);
+  budget_ = cache_bytes;
+  error_.clear();
+  return true;
+}
+
+void TiledImage::close() {
+  file_.reset();
+  width_ = height_ = channels_ = 0;
+  tile_width_ = tile_height_ = tiles_x_ = tiles_y_ = 0;
+  tile_bytes_ = 0;
+  std::lock_guard<std::mutex> lock(mutex_);
+  lru_.clear();
+  cache_.clear();
+  stats_ = TileCacheStats();
+}
+
+std::shared_ptr<const Image> TiledImage::load_tile(int tx, int ty) const {
+  auto tile = std::make_shared<Image>(tile_width_, tile_height_, channels_,
+                                      type_);
+  const uint64_t index = static_cast<uint64_t>(ty) * tiles_x_ + tx;
+  if (!file_->read(tile->data(), tile_bytes_,
+                   data_offset_ + index * tile_bytes_))
+    throw std::runtime_error("Failed to read tile");
+  return tile;
+}
+
+std::shared_ptr<const Image> TiledImage::tile(int tx, int ty) const {
+  if (!is_open())
+    throw std::logic_error("TiledImage is not open");
+  if (tx < 0 || tx >= tiles_x_ || ty < 0 || ty >= tiles_y_)
+    throw std::out_of_range("Tile index out of range");
+
+  const int64_t key = static_cast<int64_t>(ty) * tiles_x_ + tx;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(key);
+    if (it != cache_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second.lru);
+      ++stats_.hits;
+      return it->second.tile;
+    }
+  }
+
+  // 在锁外读取，其他线程可以同时命中缓存或读取其他分块
+  auto loaded = load_tile(tx, ty);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.misses;
+  auto it = cache_.find(key);
+  if (it != cache_.end()) {
+    // 其他线程已读入同一分块
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    return it->second.tile;
+  }
+  lru_.push_front(key);
+  cache_.emplace(key, CacheEntry{loaded, lru_.begin()});
+  stats_.bytes += tile_bytes_;
+  stats_.peak_bytes = std::max(stats_.peak_bytes, stats_.bytes);
+  evict_locked();
+  return loaded;
+}
+
+void TiledImage::evict_locked() const {
+  while (stats_.bytes > budget_ && !lru_.empty()) {
+    cache_.erase(lru_.back());
+    lru_.pop_back();
+    stats_.bytes -= tile_bytes_;
+    ++stats_.evictions;
+  }
+}
+
+Image TiledImage::roi(const Rect &region) const {
+  Image dst;
+  roi(region, dst);
+  return dst;
+}
+
+void TiledImage::roi(const Rect &region, Image &dst) const {
+  if (!is_open())
+    throw std::logic_error("TiledImage is not open");
+  if (region.x < 0 || region.y < 0 || region.width < 0 || region.height < 0 ||
+      region.x + region.width > width_ || region.y + region.height > height_)
+    throw std::invalid_argument("ROI region out of matrix bounds");
+
+  dst.create(region.width, region.height, channels_, type_);
+  if (dst.empty())
+    return;
+
+  const size_t pixel_bytes =
+      static_cast<size_t>(channels_) * dataTypeSize(type_);
+  const int tx0 = region.x / tile_width_;
+  const int tx1 = (region.x + region.width - 1) / tile_width_;
+  const int ty0 = region.y / tile_height_;
+  const int ty1 = (region.y + region.height - 1) / tile_height_;
+
+  for (int ty = ty0; ty <= ty1; ++ty) {
+    const int y0 = std::max(region.y, ty * tile_height_);
+    const int y1 = std::min(region.y + region.height, (ty + 1) * tile_height_);
+    for (int tx = tx0; tx <= tx1; ++tx) {
+      const int x0 = std::max(region.x, tx * tile_width_);
+      const int x1 = std::min(region.x + region.width, (tx + 1) * tile_width_);
+      const auto t = tile(tx, ty);
+      const size_t bytes = static_cast<size_t>(x1 - x0) * pixel_bytes;
+      for (int y = y0; y < y1; ++y) {
+        const uint8_t *src = t->ptr<uint8_t>(y - ty * tile_height_) +
+                             (x0 - tx * tile_width_) * pixel_bytes;
+        std::memcpy(dst.ptr<uint8_t>(y - region.y) +
+                        (x0 - region.x) * pixel_bytes,
+                    src, bytes);
+      }
+    }
+  }
+}
+
+void TiledImage::set_cache_budget(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  budget_ = bytes;
+  evict_locked();
+}
+
+size_t TiledImage::cache_budget() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return budget_;
+}
+
+TileCacheStats TiledImage::cache_stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void TiledImage::clear_cache() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  lru_.clear();
+  cache_.clear();
+  stats_.bytes = 0;
+}
+
+} // namespace dip
@@ -0,0 +1,158 @@
+#include <core/trace.hpp>
+
+#if defined(DIP_ENABLE_TRACING)
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace dip {
+namespace trace {
+
+namespace {
+
+struct ThreadRecord {
+  std::unique_ptr<TraceBuffer> buffer;
+  std::string name;
+};
+
+// 所有线程的缓冲区；线程退出后保留，以便导出其事件
+class Registry {
+public:
+  TraceBuffer *add() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint32_t tid = static_cast<uint32_t>(threads_.size()) + 1;
+    threads_.push_back(
+        {std::make_unique<TraceBuffer>(tid), "thread " + std::to_string(tid)});
+    return threads_.back().buffer.get();
+  }
+
+  void set_name(TraceBuffer *buffer, const std::string &name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &t : threads_) {
+      if (t.buffer.get() == buffer)
+        t.name = name;
+    }
+  }
+
+  template <typename F> void for_each(const F &f) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &t : threads_)
+      f(t);
+  }
+
+  std::string to_json();
+
+private:
+  std::mutex mutex_;
+  std::vector<ThreadRecord> threads_;
+};
+
+// 进程退出时按 DIP_TRACE_FILE 导出
+void write_on_exit() {
+  const char *path = std::getenv("DIP_TRACE_FILE");
+  if (path && *path)
+    write_chrome_trace(path);
+}
+
+// 注册表有意不析构：线程池等静态对象析构时工作线程可能仍在记录事件
+Registry &registry() {
+  static Registry *instance = [] {
+    std::atexit(write_on_exit);
+    return new Registry();
+  }();
+  return *instance;
+}
+
+void append_escaped(std::ostringstream &os, const std::string &s) {
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      os << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+      os << ' ';
+    else
+      os << c;
+  }
+}
+
+std::string Registry::to_json() {
+  std::ostringstream os;
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  auto separator = [&] {
+    os << (first ? "\n" : ",\n");
+    first = false;
+  };
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &t : threads_) {
+    const TraceBuffer &buffer = *t.buffer;
+    separator();
+    os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+       << buffer.tid() << ",\"args\":{\"name\":\"";
+    append_escaped(os, t.name);
+    os << "\"}}";
+
+    const uint64_t head = buffer.head();
+    const uint64_t begin =
+        head > TraceBuffer::kCapacity ? head - TraceBuffer::kCapacity : 0;
+    char number[64];
+    for (uint64_t i = begin; i < head; ++i) {
+      const TraceEvent &e = buffer.at(i);
+      separator();
+      os << "{\"name\":\"";
+      append_escaped(os, e.name);
+      // Chrome trace 的时间单位为微秒
+      std::snprintf(number, sizeof(number), "%.3f,\"dur\":%.3f",
+                    e.start_ns / 1e3, e.duration_ns / 1e3);
+      os << "\",\"cat\":\"dip\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+         << buffer.tid() << ",\"ts\":" << number << "}";
+    }
+  }
+  os << "\n]}\n";
+  return os.str();
+}
+
+} // namespace
+
+namespace detail {
+
+TraceBuffer *register_thread() { return registry().add(); }
+
+} // namespace detail
+
+void set_thread_name(const std::string &name) {
+  registry().set_name(detail::thread_buffer(), name);
+}
+
+void clear() {
+  registry().for_each([](ThreadRecord &t) { t.buffer->reset(); });
+}
+
+size_t event_count() {
+  size_t count = 0;
+  registry().for_each([&](ThreadRecord &t) {
+    count += static_cast<size_t>(
+        std::min<uint64_t>(t.buffer->head(), TraceBuffer::kCapacity));
+  });
+  return count;
+}
+
+std::string chrome_trace_json() { return registry().to_json(); }
+
+bool write_chrome_trace(const std::string &path) {
+  std::ofstream file(path);
+  if (!file.is_open())
+    return false;
+  file << chrome_trace_json();
+  return static_cast<bool>(file);
+}
+
+} // namespace trace
+} // namespace dip
+
+#endif // DIP_ENABLE_TRACING
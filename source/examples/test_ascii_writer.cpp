@@ -0,0 +1,91 @@
+#include <chrono>
+#include <core/core.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <spdlog/spdlog.h>
+
+#include "test_helpers.hpp"
+
+using namespace dip;
+using namespace dip::test;
+
+namespace {
+
+// 逐像素流式输出的参考实现（原 save_as_ppm 的格式）
+std::string reference_ascii(const Image &image) {
+  std::ostringstream out;
+  out << (image.channels() == 1 ? "P2\n" : "P3\n");
+  out << image.width() << " " << image.height() << "\n";
+  out << "255\n";
+  for (int y = 0; y < image.height(); ++y) {
+    for (int x = 0; x < image.width(); ++x) {
+      for (int c = 0; c < image.channels(); ++c) {
+        out << static_cast<int>(image.at<uint8_t>(y, x, c));
+        if (c < image.channels() - 1 || x < image.width() - 1)
+          out << " ";
+      }
+    }
+    out << "\n";
+  }
+  return out.str();
+}
+
+std::string read_file(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  std::ostringstream out;
+  out << file.rdbuf();
+  return out.str();
+}
+
+} // namespace
+
+int main() {
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("=== ASCII PNM写入测试（{} 线程）===", get_num_threads());
+
+  // 输出字节与参考实现一致（含跨多个行块的图像）
+  const struct {
+    const char *name;
+    int width, height, channels;
+  } cases[] = {{"gray_small", 7, 5, 1},
+               {"rgb_small", 9, 4, 3},
+               {"single_pixel", 1, 1, 3},
+               {"gray_multi_block", 3000, 700, 1},
+               {"rgb_multi_block", 1200, 500, 3}};
+  for (const auto &c : cases) {
+    const Image img =
+        random_image(c.width, c.height, c.channels, DataType::UINT8, c.width);
+    const std::string path =
+        std::string("ascii_writer.") + (c.channels == 1 ? "pgm" : "ppm");
+    bool same = ImageLoader::save_as_ppm(img, path) &&
+                read_file(path) == reference_ascii(img);
+    record(c.name, same);
+    std::remove(path.c_str());
+  }
+
+  // 非8位图像被拒绝，不产生文件
+  const Image wide(16, 8, 1, DataType::UINT16);
+  const bool wide_rejected =
+      !ImageLoader::save_as_ppm(wide, "ascii_writer_wide.pgm");
+  record("reject_uint16",
+         wide_rejected && !std::ifstream("ascii_writer_wide.pgm").is_open());
+
+  // 吞吐量
+  const Image large = random_image(4000, 2500, 3, DataType::UINT8, 11);
+  auto start = std::chrono::steady_clock::now();
+  ImageLoader::save_as_ppm(large, "ascii_writer_large.ppm");
+  auto end = std::chrono::steady_clock::now();
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  std::ifstream large_file("ascii_writer_large.ppm",
+                           std::ios::binary | std::ios::ate);
+  const double mb = static_cast<double>(large_file.tellg()) / (1 << 20);
+  large_file.close();
+  std::remove("ascii_writer_large.ppm");
+
+  const bool ok = report_checks();
+  spdlog::info("{}x{} P3：{:.1f} MB，{:.3f} s，{:.0f} MB/s", large.width(),
+               large.height(), mb, seconds, mb / seconds);
+  spdlog::info(ok ? "ASCII PNM写入测试完成！" : "ASCII PNM写入测试失败！");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+#include <algorithms/downsample.hpp>
+#include <algorithms/quantize.hpp>
+#include <atomic>
+#include <core/core.hpp>
+#include <cstdio>
+#include <spdlog/spdlog.h>
+
+#include "test_helpers.hpp"
+
+using namespace dip;
+using namespace dip::test;
+using namespace dip::algorithms;
+
+int main(int argc, char *argv[]) {
+  spdlog::set_level(spdlog::level::info);
+
+  std::string filename = argc > 1 ? argv[1] : "test.png";
+  auto loaded = ImageLoader::load_from_file(filename, 3);
+  if (!loaded || loaded->empty()) {
+    spdlog::error("Failed to load image: {}", filename);
+    return 1;
+  }
+
+  spdlog::info("=== 异步读写测试（I/O线程 {}）===", ThreadPool::io().size());
+  spdlog::set_level(spdlog::level::warn);
+  const Image base = downsample(*loaded, 2);
+  const int count = 12;
+  std::vector<Image> originals;
+  std::vector<std::string> paths;
+  for (int i = 0; i < count; ++i) {
+    originals.push_back(quantize(base, 2 + i * 16));
+    paths.push_back("async_io_" + std::to_string(i) + ".ppm");
+  }
+
+  // 异步写入：队列上限约为两张图像，写入全部完成后检查峰值
+  const size_t image_bytes = base.matrix().total();
+  size_t peak = 0, written = 0, failed = 0;
+  {
+    AsyncImageWriter writer(image_bytes * 2, 2);
+    for (int i = 0; i < count; ++i)
+      writer.write(originals[i], paths[i]);
+    writer.write(originals[0], "no_such_dir/async_io.ppm");
+    writer.flush();
+    peak = writer.peak_pending_bytes();
+    written = writer.written_count();
+    failed = writer.failed_count();
+  }
+  record("writer_bounded", peak <= image_bytes * 2);
+  record("writer_counts", written == static_cast<size_t>(count) && failed == 1);
+
+  // 批量加载（future）
+  auto futures = ImageLoader::load_batch(paths, 4);
+  bool futures_ok = futures.size() == paths.size();
+  for (size_t i = 0; i < futures.size() && futures_ok; ++i) {
+    auto img = futures[i].get();
+    futures_ok = img && same_pixels(*img, originals[i]);
+  }
+  record("load_batch_futures", futures_ok);
+
+  // 批量加载（回调）：回调中处理图像，与其余文件的解码重叠
+  std::vector<std::string> with_missing = paths;
+  with_missing.push_back("no_such_file.ppm");
+  std::vector<Image> processed(with_missing.size());
+  std::atomic<int> missing{0};
+  ImageLoader::load_batch(with_missing,
+                          [&](size_t i, std::shared_ptr<Image> img) {
+                            if (!img) {
+                              ++missing;
+                              return;
+                            }
+                            quantize(*img, 4, processed[i]);
+                          });
+  bool callback_ok = missing == 1;
+  for (int i = 0; i < count && callback_ok; ++i)
+    callback_ok = same_pixels(processed[i], quantize(originals[i], 4));
+  record("load_batch_callback", callback_ok);
+
+  // 顺序预取
+  ImagePrefetcher prefetcher(paths, 3);
+  std::shared_ptr<Image> img;
+  std::string path;
+  size_t index = 0;
+  bool prefetch_ok = true;
+  while (prefetcher.next(img, &path)) {
+    prefetch_ok = prefetch_ok && img && path == paths[index] &&
+                  same_pixels(*img, originals[index]);
+    ++index;
+  }
+  record("prefetcher_order", prefetch_ok && index == paths.size());
+  spdlog::set_level(spdlog::level::info);
+
+  for (const auto &p : paths)
+    std::remove(p.c_str());
+
+  const bool ok = report_checks();
+  spdlog::info(ok ? "异步读写测试完成！" : "异步读写测试失败！");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+#include <algorithms/batch.hpp>
+#include <algorithms/bilinear_zoom.hpp>
+#include <algorithms/downsample.hpp>
+#include <algorithms/quantize.hpp>
+#include <algorithms/set_logical_ops.hpp>
+#include <algorithms/spatial_ops.hpp>
+#include <chrono>
+#include <core/core.hpp>
+#include <random>
+#include <spdlog/spdlog.h>
+
+#include "test_helpers.hpp"
+
+using namespace dip;
+using namespace dip::algorithms;
+using namespace dip::test;
+
+namespace {
+
+// 生成 count 张尺寸不一的随机小图像
+std::vector<Image> make_images(int count, int channels, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::vector<Image> images;
+  images.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    const int width = 48 + static_cast<int>(rng() % 64);
+    const int height = 48 + static_cast<int>(rng() % 64);
+    Image img(width, height, channels);
+    for (int y = 0; y < height; ++y) {
+      uint8_t *row = img.ptr<uint8_t>(y);
+      for (int x = 0; x < width * channels; ++x)
+        row[x] = static_cast<uint8_t>(rng());
+    }
+    images.push_back(std::move(img));
+  }
+  return images;
+}
+
+bool same(const std::vector<Image> &a, const std::vector<Image> &b) {
+  if (a.size() != b.size())
+    return false;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (a[i].channels() != b[i].channels() ||
+        !(a[i].matrix() == b[i].matrix()))
+      return false;
+  }
+  return true;
+}
+
+template <typename F> double time_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace
+
+int main() {
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("=== 批量处理测试（{} 线程）===", get_num_threads());
+
+  const std::vector<Image> images = make_images(256, 3, 1);
+  std::vector<Image> binary1 = make_images(64, 1, 2);
+  std::vector<Image> binary2(binary1.size());
+  for (size_t i = 0; i < binary1.size(); ++i) {
+    binary2[i] = invert_image(binary1[i], 255);
+    quantize(binary1[i], 2, binary1[i]);
+    quantize(binary2[i], 2, binary2[i]);
+  }
+
+  spdlog::set_level(spdlog::level::warn);
+  // 批量结果与逐张调用一致，且按输入顺序排列
+  std::vector<Image> expected;
+  for (const auto &img : images)
+    expected.push_back(quantize(img, 8));
+  record("quantize_batch", same(quantize_batch(images, 8), expected));
+
+  expected.clear();
+  for (const auto &img : images)
+    expected.push_back(downsample(img, 2));
+  record("downsample_batch", same(downsample_batch(images, 2), expected));
+
+  expected.clear();
+  for (const auto &img : images)
+    expected.push_back(bilinear_zoom(img, 1.5f));
+  record("bilinear_zoom_batch",
+         same(bilinear_zoom_batch(images, 1.5f), expected));
+
+  expected.clear();
+  for (const auto &img : images)
+    expected.push_back(set_complement(img, 255));
+  record("set_complement_batch",
+         same(set_complement_batch(images, 255), expected));
+
+  expected.clear();
+  for (size_t i = 0; i < binary1.size(); ++i)
+    expected.push_back(logical_xor(binary1[i], binary2[i]));
+  record("logical_xor_batch",
+         same(logical_xor_batch(binary1, binary2), expected));
+
+  // 数量不一致时抛出异常
+  bool rejected = false;
+  try {
+    logical_and_batch(binary1, images);
+  } catch (const std::invalid_argument &) {
+    rejected = true;
+  }
+  record("size_mismatch_rejected", rejected);
+
+  // 自定义批处理：单张失败的异常在批处理结束后抛出
+  bool propagated = false;
+  try {
+    batch_apply(images, [](const Image &src, Image &dst) {
+      bilinear_zoom(src, -1.0f, dst);
+    });
+  } catch (const std::invalid_argument &) {
+    propagated = true;
+  }
+  record("exception_propagated", propagated);
+
+  // 复用上一批的输出缓冲区
+  std::vector<Image> outputs;
+  quantize_batch(images, 4, outputs);
+  const void *first = outputs.front().data();
+  quantize_batch(images, 4, outputs);
+  record("outputs_reused", outputs.front().data() == first);
+
+  // 逐张循环与批量处理的耗时对比
+  double loop_ms = time_ms([&] {
+    for (const auto &img : images)
+      downsample(img, 2);
+  });
+  double batch_ms = time_ms([&] { downsample_batch(images, 2, outputs); });
+  spdlog::set_level(spdlog::level::info);
+
+  const bool ok = report_checks();
+  spdlog::info("downsample {} 张：逐张 {:.2f} ms，批量 {:.2f} ms",
+               images.size(), loop_ms, batch_ms);
+  spdlog::info(ok ? "批量处理测试完成！" : "批量处理测试失败！");
+  return ok ? 0 : 1;
+}
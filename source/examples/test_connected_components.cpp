@@ -0,0 +1,154 @@
+#include <algorithms/connected_components.hpp>
+#include <chrono>
+#include <cmath>
+#include <core/core.hpp>
+#include <queue>
+#include <random>
+#include <spdlog/spdlog.h>
+
+using namespace dip;
+
+namespace {
+
+// 基于邻域遍历的洪水填充，作为标记结果的参考实现
+int flood_fill_count(const Image &img, NeighborhoodType type, uint8_t V) {
+  std::vector<uint8_t> visited(img.width() * img.height(), 0);
+  std::queue<Point2i> queue;
+  int count = 0;
+
+  for (int y = 0; y < img.height(); ++y) {
+    for (int x = 0; x < img.width(); ++x) {
+      if (img.get_pixel(x, y) != V || visited[y * img.width() + x])
+        continue;
+
+      ++count;
+      visited[y * img.width() + x] = 1;
+      queue.push(Point2i(x, y));
+      while (!queue.empty()) {
+        Point2i p = queue.front();
+        queue.pop();
+        for_each_neighbor(img, p.x, p.y, type, [&](const Point2i &q) {
+          size_t idx = static_cast<size_t>(q.y) * img.width() + q.x;
+          if (img.get_pixel(q.x, q.y) == V && !visited[idx]) {
+            visited[idx] = 1;
+            queue.push(q);
+          }
+        });
+      }
+    }
+  }
+
+  return count;
+}
+
+Image random_mask(int width, int height, double density, unsigned seed) {
+  Image img(width, height, 1);
+  std::mt19937 rng(seed);
+  std::bernoulli_distribution fg(density);
+  for (int y = 0; y < height; ++y) {
+    uint8_t *row = img.ptr<uint8_t>(y);
+    for (int x = 0; x < width; ++x) {
+      row[x] = fg(rng) ? 1 : 0;
+    }
+  }
+  return img;
+}
+
+// 平滑场阈值化得到的块状掩膜，更接近实际检测掩膜
+Image blob_mask(int width, int height) {
+  Image img(width, height, 1);
+  for (int y = 0; y < height; ++y) {
+    uint8_t *row = img.ptr<uint8_t>(y);
+    for (int x = 0; x < width; ++x) {
+      double v = std::sin(x * 0.013) + std::cos(y * 0.011) +
+                 std::sin((x + y) * 0.002);
+      row[x] = v > 0.3 ? 1 : 0;
+    }
+  }
+  return img;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("=== 连通分量标记测试 ===");
+
+  // 对角线图案：4-连通为5个分量，8-连通和m-连通为1个分量
+  Image diag(5, 5, 1);
+  diag.setTo(Scalar(0));
+  for (int i = 0; i < 5; ++i) {
+    diag.set_pixel(i, i, 0, 1);
+  }
+
+  auto r4 = label_components(diag, NeighborhoodType::N4, 1);
+  auto r8 = label_components(diag, NeighborhoodType::N8, 1);
+  auto rm = label_components(diag, NeighborhoodType::M_CONNECTED, 1);
+  spdlog::info("对角线图案: N4={} N8={} m={}", r4.num_components,
+               r8.num_components, rm.num_components);
+
+  bool passed = r4.num_components == 5 && r8.num_components == 1 &&
+                rm.num_components == 1;
+
+  // 随机图像与洪水填充参考实现对比
+  Image mask = random_mask(257, 193, 0.45, 42);
+  for (auto type : {NeighborhoodType::N4, NeighborhoodType::N8,
+                    NeighborhoodType::M_CONNECTED}) {
+    auto result = label_components(mask, type, 1);
+    int reference = flood_fill_count(mask, type, 1);
+    spdlog::info("随机图像 type={}: 标记={} 参考={}", static_cast<int>(type),
+                 result.num_components, reference);
+    passed = passed && result.num_components == reference;
+  }
+
+  // 并行标记与顺序标记结果必须逐像素一致
+  Image blobs = blob_mask(1031, 777);
+  for (const Image *src : {&mask, &blobs}) {
+    for (auto type : {NeighborhoodType::N4, NeighborhoodType::N8,
+                      NeighborhoodType::M_CONNECTED}) {
+      auto reference = label_components(*src, type, 1);
+      for (int threads : {2, 3, 7, 16}) {
+        auto result = label_components_parallel(*src, type, 1, threads);
+        bool same = result.num_components == reference.num_components &&
+                    result.labels == reference.labels;
+        if (!same) {
+          spdlog::error("并行标记结果不一致: type={} threads={}",
+                        static_cast<int>(type), threads);
+        }
+        passed = passed && same;
+      }
+    }
+  }
+  spdlog::info("并行标记一致性检查完成");
+
+  // 大图像性能测试（默认约50MP）
+  int width = argc > 1 ? std::atoi(argv[1]) : 8000;
+  int height = argc > 2 ? std::atoi(argv[2]) : 6250;
+  Image large = blob_mask(width, height);
+
+  for (auto type : {NeighborhoodType::N4, NeighborhoodType::N8,
+                    NeighborhoodType::M_CONNECTED}) {
+    auto start = std::chrono::high_resolution_clock::now();
+    auto result = label_components(large, type, 1);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    spdlog::info("{}x{} type={}: {} 个分量, 耗时 {} ms", width, height,
+                 static_cast<int>(type), result.num_components, ms.count());
+
+    start = std::chrono::high_resolution_clock::now();
+    auto parallel_result = label_components_parallel(large, type, 1);
+    end = std::chrono::high_resolution_clock::now();
+    ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    spdlog::info("{}x{} type={} (并行, {} 线程): {} 个分量, 耗时 {} ms", width,
+                 height, static_cast<int>(type), get_num_threads(),
+                 parallel_result.num_components, ms.count());
+  }
+
+  if (passed) {
+    spdlog::info("连通分量标记测试通过！");
+  } else {
+    spdlog::error("连通分量标记测试失败！");
+  }
+  return passed ? 0 : 1;
+}
@@ -59,6 +59,15 @@ int main(int argc, char *argv[]) {
   }
   spdlog::info(result_m);
 
+  // 测试零分配的邻域缓冲区接口
+  dip::NeighborBuffer buffer;
+  dip::get_neighbors(test_img, 2, 2, dip::NeighborhoodType::N8, buffer);
+  std::string result_buf = "8-邻域缓冲区 (中心点(2,2)): ";
+  for (const auto &p : buffer) {
+    result_buf += "(" + std::to_string(p.x) + "," + std::to_string(p.y) + ") ";
+  }
+  spdlog::info(result_buf);
+
   // 测试is_connected函数
   spdlog::info("=== 测试 is_connected (V=1) ===");
 
@@ -0,0 +1,88 @@
+#include <cmath>
+#include <core/core.hpp>
+#include <spdlog/spdlog.h>
+
+using namespace dip;
+
+int main(int argc, char *argv[]) {
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("=== 数据类型测试 ===");
+
+  bool passed = true;
+
+  // 各类型的字节大小
+  for (auto type : {DataType::UINT32, DataType::INT32, DataType::FLOAT16}) {
+    spdlog::info("{}: {} 字节", dataTypeName(type), dataTypeSize(type));
+  }
+
+  // 半精度：所有非NaN的位模式经 half->float->half 往返不变
+  int roundtrip_errors = 0;
+  for (uint32_t bits = 0; bits <= 0xffff; ++bits) {
+    uint16_t h = static_cast<uint16_t>(bits);
+    float f = halfToFloat(h);
+    if (std::isnan(f))
+      continue;
+    if (floatToHalf(f) != h)
+      ++roundtrip_errors;
+  }
+  spdlog::info("FLOAT16 往返误差数: {}", roundtrip_errors);
+  passed = passed && roundtrip_errors == 0;
+
+  // 半精度舍入：65504为最大有限值，65520舍入为Inf，2^-25舍入为0
+  passed = passed && halfToFloat(floatToHalf(65504.0f)) == 65504.0f &&
+           std::isinf(halfToFloat(floatToHalf(65520.0f))) &&
+           floatToHalf(std::ldexp(1.0f, -25)) == 0 &&
+           halfToFloat(floatToHalf(0.1f)) == 0.0999755859375f;
+
+  // 类型转换：UINT8 -> FLOAT16 -> FLOAT32 -> UINT32 -> INT32 -> UINT8
+  Matrix src(4, 64, DataType::UINT8);
+  for (int i = 0; i < src.rows(); ++i) {
+    for (int j = 0; j < src.cols(); ++j) {
+      src.at<uint8_t>(i, j) = static_cast<uint8_t>(i * 64 + j);
+    }
+  }
+  Matrix back = src.convertTo(DataType::FLOAT16)
+                    .convertTo(DataType::FLOAT32)
+                    .convertTo(DataType::UINT32)
+                    .convertTo(DataType::INT32)
+                    .convertTo(DataType::UINT8);
+  spdlog::info("UINT8 经 FLOAT16/FLOAT32/UINT32/INT32 往返: {}",
+               back == src ? "一致" : "不一致");
+  passed = passed && back == src;
+
+  // setTo 与算术运算
+  Matrix a(2, 3, DataType::INT32), b(2, 3, DataType::INT32);
+  a.setTo(Scalar(100000));
+  b.setTo(Scalar(-30000));
+  Matrix sum = matrix_ops::add(a, b);
+  passed = passed && sum.at<int32_t>(1, 2) == 70000;
+
+  Matrix ua(2, 3, DataType::UINT32), ub(2, 3, DataType::UINT32);
+  ua.setTo(Scalar(3));
+  ub.setTo(Scalar(5));
+  Matrix diff = matrix_ops::subtract(ua, ub);
+  passed = passed && diff.at<uint32_t>(0, 0) == 0xfffffffeu;
+
+  Matrix ha(2, 3, DataType::FLOAT16), hb(2, 3, DataType::FLOAT16);
+  ha.setTo(Scalar(1.5));
+  hb.setTo(Scalar(0.25));
+  Matrix hsum = matrix_ops::add(ha, hb);
+  spdlog::info("INT32: {}, UINT32: {}, FLOAT16: {}", sum.at<int32_t>(1, 2),
+               diff.at<uint32_t>(0, 0),
+               static_cast<float>(hsum.at<Float16>(0, 0)));
+  passed = passed && static_cast<float>(hsum.at<Float16>(0, 0)) == 1.75f;
+
+  // 内存占用对比：FLOAT16 为 FLOAT32 的一半
+  Image img16(1920, 1080, 3, DataType::FLOAT16);
+  Image img32(1920, 1080, 3, DataType::FLOAT32);
+  spdlog::info("1920x1080x3 FLOAT16: {} 字节, FLOAT32: {} 字节",
+               img16.matrix().total() * img16.matrix().elemSize(),
+               img32.matrix().total() * img32.matrix().elemSize());
+
+  if (passed) {
+    spdlog::info("数据类型测试通过！");
+  } else {
+    spdlog::error("数据类型测试失败！");
+  }
+  return passed ? 0 : 1;
+}
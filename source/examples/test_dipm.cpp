@@ -0,0 +1,136 @@
+#include <chrono>
+#include <core/core.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <spdlog/spdlog.h>
+
+#include "test_helpers.hpp"
+
+using namespace dip;
+using namespace dip::test;
+
+namespace {
+
+bool round_trip(const Image &img, const std::string &path) {
+  if (!ImageLoader::save_as_dipm(img, path))
+    return false;
+  auto loaded = ImageLoader::load_dipm(path);
+  return loaded && loaded->matrix().isExternal() && same_pixels(*loaded, img);
+}
+
+} // namespace
+
+int main() {
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("=== .dipm 容器格式测试 ===");
+
+  // 各种 DataType 与通道数零拷贝往返
+  const Image gray = random_image(641, 479, 1, DataType::UINT8, 1);
+  const Image rgb = random_image(320, 241, 3, DataType::UINT8, 2);
+  record("uint8_gray", round_trip(gray, "dipm_gray.dipm"));
+  record("uint8_rgb", round_trip(rgb, "dipm_rgb.dipm"));
+  record("uint16_rgba", round_trip(random_image(129, 67, 4, DataType::UINT16,
+                                                3),
+                                   "dipm_u16.dipm"));
+  record("float32", round_trip(random_image(200, 100, 2, DataType::FLOAT32, 4),
+                               "dipm_f32.dipm"));
+  record("float64", round_trip(random_image(31, 17, 1, DataType::FLOAT64, 5),
+                               "dipm_f64.dipm"));
+
+  // ROI 图像按行紧密排列写出
+  const Image roi = rgb.pixel_roi(Rect(17, 23, 100, 80));
+  record("roi_image", round_trip(roi, "dipm_roi.dipm"));
+
+  // 文件头记录类型、通道数、行跨度和对齐
+  DipmHeader header;
+  record("header", read_dipm_header("dipm_rgb.dipm", header) &&
+                       header.rows == 241 && header.cols == 960 &&
+                       header.channels == 3 &&
+                       header.type == DataType::UINT8 && header.step == 960 &&
+                       header.data_offset % header.alignment == 0);
+
+  // 映射只读；load_from_file 读入自有缓冲区，可以修改
+  auto owned = ImageLoader::load_from_file("dipm_gray.dipm");
+  if (owned)
+    owned->at<uint8_t>(0, 0) = static_cast<uint8_t>(~gray.at<uint8_t>(0, 0));
+  auto reloaded = ImageLoader::load_dipm("dipm_gray.dipm");
+  record("owned_copy", owned && !owned->matrix().isExternal() && reloaded &&
+                           same_pixels(*reloaded, gray) &&
+                           !same_pixels(*owned, gray));
+
+  // 保存回映射来源的路径：替换文件，映射中的图像保持原内容
+  const bool saved_over = reloaded &&
+                          ImageLoader::save_as_dipm(*reloaded,
+                                                    "dipm_gray.dipm") &&
+                          image_saver::save_binary(*owned, "dipm_gray.dipm");
+  auto replaced = ImageLoader::load_dipm("dipm_gray.dipm");
+  record("save_over_mapped", saved_over && same_pixels(*reloaded, gray) &&
+                                 replaced && same_pixels(*replaced, *owned));
+
+  // 通过 image_saver / load_from_file / load_auto 按扩展名选择
+  const Image deep = random_image(90, 60, 3, DataType::UINT16, 6);
+  auto by_ext = image_saver::save_binary(deep, "dipm_ext.dipm")
+                    ? ImageLoader::load_from_file("dipm_ext.dipm")
+                    : nullptr;
+  auto by_auto = ImageLoader::load_auto("dipm_ext.dipm");
+  record("extension", by_ext && same_pixels(*by_ext, deep) && by_auto &&
+                          same_pixels(*by_auto, deep));
+
+  // 非 .dipm 文件与截断的文件被拒绝
+  spdlog::set_level(spdlog::level::warn);
+  ImageLoader::save_as_ppm_binary(rgb, "dipm_bad.dipm");
+  std::string error;
+  const bool bad_rejected = !map_dipm("dipm_bad.dipm", &error) &&
+                            !error.empty();
+  {
+    std::ifstream in("dipm_gray.dipm", std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)),
+                      std::istreambuf_iterator<char>());
+    std::ofstream out("dipm_bad.dipm", std::ios::binary);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() / 2));
+  }
+  const bool truncated_rejected = !map_dipm("dipm_bad.dipm");
+  // 行跨度 * 行数溢出的文件头
+  bool overflow_rejected = false;
+  {
+    std::ifstream in("dipm_rgb.dipm", std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)),
+                      std::istreambuf_iterator<char>());
+    const uint32_t rows = 4;
+    const uint64_t step = uint64_t(1) << 62;
+    std::memcpy(&bytes[8], &rows, sizeof(rows));
+    std::memcpy(&bytes[24], &step, sizeof(step));
+    std::ofstream out("dipm_bad.dipm", std::ios::binary);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    out.close();
+    Image dst;
+    overflow_rejected = !map_dipm("dipm_bad.dipm") &&
+                        !read_dipm("dipm_bad.dipm", dst);
+  }
+  record("reject_invalid",
+         bad_rejected && truncated_rejected && overflow_rejected);
+  spdlog::set_level(spdlog::level::info);
+
+  // 重新载入只需映射文件
+  const Image big = random_image(4000, 3000, 3, DataType::UINT8, 7);
+  ImageLoader::save_as_dipm(big, "dipm_big.dipm");
+  const auto t0 = std::chrono::steady_clock::now();
+  auto mapped = ImageLoader::load_dipm("dipm_big.dipm");
+  const auto t1 = std::chrono::steady_clock::now();
+  spdlog::info("载入 {} MB 的 .dipm 用时 {} us", big.matrix().total() >> 20,
+               std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0)
+                   .count());
+  record("big_reload", mapped && same_pixels(*mapped, big));
+  mapped.reset();
+
+  for (const char *p :
+       {"dipm_gray.dipm", "dipm_rgb.dipm", "dipm_u16.dipm", "dipm_f32.dipm",
+        "dipm_f64.dipm", "dipm_roi.dipm", "dipm_ext.dipm", "dipm_bad.dipm",
+        "dipm_big.dipm"})
+    std::remove(p);
+
+  const bool ok = report_checks();
+  spdlog::info(ok ? ".dipm 容器格式测试完成！" : ".dipm 容器格式测试失败！");
+  return ok ? 0 : 1;
+}
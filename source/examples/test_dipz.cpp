@@ -0,0 +1,149 @@
+#include <chrono>
+#include <cmath>
+#include <core/core.hpp>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <spdlog/spdlog.h>
+
+#include "test_helpers.hpp"
+
+using namespace dip;
+using namespace dip::test;
+
+namespace {
+
+// 平滑渐变叠加少量噪声，近似自然图像的统计特性
+Image smooth_image(int width, int height, int channels, DataType type,
+                   uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<float> noise(0.0f, 2.0f);
+  Image img(width, height, channels, type);
+  const float scale = type == DataType::UINT16 ? 257.0f : 1.0f;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      for (int c = 0; c < channels; ++c) {
+        const float v = 128.0f + 60.0f * std::sin(x * 0.02f + c) *
+                                     std::cos(y * 0.015f) +
+                        noise(rng);
+        const float clamped = std::min(255.0f, std::max(0.0f, v)) * scale;
+        if (type == DataType::UINT16)
+          img.ptr<uint16_t>(y)[x * channels + c] =
+              static_cast<uint16_t>(clamped);
+        else if (type == DataType::FLOAT32)
+          img.ptr<float>(y)[x * channels + c] = v / 255.0f;
+        else
+          img.ptr<uint8_t>(y)[x * channels + c] =
+              static_cast<uint8_t>(clamped);
+      }
+    }
+  }
+  return img;
+}
+
+// 编码再解码，返回压缩后大小（失败返回0）
+size_t round_trip(const Image &img, const DipzOptions &options = {}) {
+  std::vector<uint8_t> encoded;
+  encode_dipz(img, encoded, options);
+  Image decoded;
+  if (!decode_dipz(encoded.data(), encoded.size(), decoded) ||
+      !same_pixels(decoded, img))
+    return 0;
+  return encoded.size();
+}
+
+} // namespace
+
+int main() {
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("=== .dipz 无损压缩测试 ===");
+
+  // 典型的8位和16位图像小于原始大小
+  const Image gray = smooth_image(1024, 768, 1, DataType::UINT8, 1);
+  const Image rgb = smooth_image(640, 480, 3, DataType::UINT8, 2);
+  const Image deep = smooth_image(512, 384, 3, DataType::UINT16, 3);
+  const size_t gray_size = round_trip(gray);
+  const size_t rgb_size = round_trip(rgb);
+  const size_t deep_size = round_trip(deep);
+  spdlog::info("压缩率: gray {:.1f}%  rgb {:.1f}%  uint16 {:.1f}%",
+               100.0 * gray_size / raw_size(gray),
+               100.0 * rgb_size / raw_size(rgb),
+               100.0 * deep_size / raw_size(deep));
+  record("uint8_gray", gray_size > 0 && gray_size < raw_size(gray) * 3 / 4);
+  record("uint8_rgb", rgb_size > 0 && rgb_size < raw_size(rgb) * 3 / 4);
+  record("uint16_rgb", deep_size > 0 && deep_size < raw_size(deep) * 3 / 4);
+
+  // 常数图像几乎不占空间
+  Image flat(800, 600, 1, DataType::UINT16);
+  flat.matrix().setTo(Scalar(1234));
+  const size_t flat_size = round_trip(flat);
+  record("flat", flat_size > 0 && flat_size < raw_size(flat) / 100);
+
+  // 其余类型（按位模式预测）、不可压缩数据、ROI 和小块
+  record("float32", round_trip(smooth_image(200, 150, 2, DataType::FLOAT32,
+                                            4)) > 0);
+  record("float64", round_trip(random_image(97, 31, 1, DataType::FLOAT64,
+                                            5)) > 0);
+  const Image noise = random_image(300, 200, 3, DataType::UINT8, 6);
+  const size_t noise_size = round_trip(noise);
+  record("incompressible", noise_size > 0 &&
+                               noise_size < raw_size(noise) + 1024);
+  record("roi_image", round_trip(rgb.pixel_roi(Rect(13, 7, 301, 222))) > 0);
+  DipzOptions small_blocks;
+  small_blocks.block_rows = 1;
+  record("block_rows", round_trip(deep, small_blocks) > 0 &&
+                           round_trip(Image(3, 5, 4)) > 0);
+
+  // 损坏或截断的数据被拒绝
+  std::vector<uint8_t> encoded;
+  encode_dipz(gray, encoded);
+  Image decoded;
+  std::string error;
+  const bool truncated = !decode_dipz(encoded.data(), encoded.size() / 2,
+                                      decoded, &error) &&
+                         !error.empty();
+  for (size_t i = 200; i < encoded.size(); i += 97)
+    encoded[i] = static_cast<uint8_t>(encoded[i] ^ 0x5A);
+  const bool corrupted = !decode_dipz(encoded.data(), encoded.size(), decoded);
+  record("reject_invalid", truncated && corrupted);
+
+  // 头部的块数在 32 位下回绕（height + block_rows 溢出为 0 块）
+  std::vector<uint8_t> header;
+  encode_dipz(Image(4, 5, 1), header);
+  header.resize(64);
+  const uint32_t block_rows = 0xFFFFFFFCu, block_count = 0;
+  std::memcpy(header.data() + 24, &block_rows, sizeof(block_rows));
+  std::memcpy(header.data() + 28, &block_count, sizeof(block_count));
+  record("reject_overflow",
+         !decode_dipz(header.data(), header.size(), decoded, &error));
+
+  // 通过 image_saver / load_from_file 按扩展名选择
+  spdlog::set_level(spdlog::level::warn);
+  auto by_ext = image_saver::save_binary(deep, "dipz_ext.dipz")
+                    ? ImageLoader::load_from_file("dipz_ext.dipz")
+                    : nullptr;
+  spdlog::set_level(spdlog::level::info);
+  record("extension", by_ext && same_pixels(*by_ext, deep));
+
+  // 吞吐量
+  const Image big = smooth_image(4096, 3072, 1, DataType::UINT8, 7);
+  const auto t0 = std::chrono::steady_clock::now();
+  encode_dipz(big, encoded);
+  const auto t1 = std::chrono::steady_clock::now();
+  decode_dipz(encoded.data(), encoded.size(), decoded);
+  const auto t2 = std::chrono::steady_clock::now();
+  const double mb = raw_size(big) / 1048576.0;
+  spdlog::info("{} MB，{} 线程: 编码 {:.0f} MB/s，解码 {:.0f} MB/s，"
+               "压缩率 {:.1f}%",
+               static_cast<int>(mb), get_num_threads(),
+               mb / std::chrono::duration<double>(t1 - t0).count(),
+               mb / std::chrono::duration<double>(t2 - t1).count(),
+               100.0 * encoded.size() / raw_size(big));
+  record("big_round_trip", same_pixels(decoded, big));
+
+  std::remove("dipz_ext.dipz");
+
+  const bool ok = report_checks();
+  spdlog::info(ok ? ".dipz 无损压缩测试完成！" : ".dipz 无损压缩测试失败！");
+  return ok ? 0 : 1;
+}
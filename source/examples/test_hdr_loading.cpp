@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <cmath>
+#include <core/core.hpp>
+#include <cstdio>
+#include <random>
+#include <spdlog/spdlog.h>
+
+#include "test_helpers.hpp"
+
+using namespace dip;
+using namespace dip::test;
+
+int main() {
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("=== 16位与HDR加载测试 ===");
+
+  std::mt19937 rng(3);
+  const int width = 71, height = 45;
+
+  // 16位PNG：完整保留16位精度，且直接使用 stb 的缓冲区
+  Image wide(width, height, 3, DataType::UINT16);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width * 3; ++x)
+      wide.ptr<uint16_t>(y)[x] = static_cast<uint16_t>(rng());
+  }
+  ImageLoader::save_as_png(wide, "hdr_loading_16.png");
+  auto loaded16 = ImageLoader::load_16("hdr_loading_16.png");
+  record("load_16", loaded16 && loaded16->type() == DataType::UINT16 &&
+                        same_pixels(*loaded16, wide));
+  record("load_16_zero_copy", loaded16 && loaded16->matrix().isExternal());
+  auto auto16 = ImageLoader::load_auto("hdr_loading_16.png");
+  record("auto_16bit", auto16 && same_pixels(*auto16, wide));
+
+  // 8位文件：load_auto 为 UINT8，load_16 扩展为 v * 257
+  Image narrow(width, height, 1);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x)
+      narrow.ptr<uint8_t>(y)[x] = static_cast<uint8_t>(rng());
+  }
+  ImageLoader::save_as_png(narrow, "hdr_loading_8.png");
+  auto auto8 = ImageLoader::load_auto("hdr_loading_8.png");
+  record("auto_8bit", auto8 && same_pixels(*auto8, narrow));
+  auto widened = ImageLoader::load_16("hdr_loading_8.png");
+  bool widened_ok = widened && widened->type() == DataType::UINT16;
+  for (int y = 0; y < height && widened_ok; ++y) {
+    for (int x = 0; x < width && widened_ok; ++x)
+      widened_ok = widened->at<uint16_t>(y, x) ==
+                   narrow.at<uint8_t>(y, x) * 257;
+  }
+  record("load_16_from_8bit", widened_ok);
+
+  // 16位PNM 使用原生读取器
+  ImageLoader::save_as_ppm_binary(wide, "hdr_loading_16.ppm");
+  auto pnm16 = ImageLoader::load_auto("hdr_loading_16.ppm");
+  record("auto_pnm_16bit", pnm16 && same_pixels(*pnm16, wide));
+
+  // Radiance HDR：FLOAT32，超出 [0, 1] 的值保留
+  // RGBE 编码三个通道共用指数，误差约为像素最大分量的1%
+  std::vector<float> radiance(width * height * 3);
+  for (auto &v : radiance)
+    v = std::ldexp(0.5f + (rng() % 1000) / 2000.0f,
+                   static_cast<int>(rng() % 12) - 4);
+  stbi_write_hdr("hdr_loading.hdr", width, height, 3, radiance.data());
+  auto hdr = ImageLoader::load_float("hdr_loading.hdr");
+  bool hdr_ok = hdr && hdr->type() == DataType::FLOAT32 &&
+                hdr->channels() == 3 && hdr->matrix().isExternal();
+  float max_value = 0;
+  for (size_t i = 0; hdr_ok && i < radiance.size(); ++i) {
+    const float v = hdr->ptr<float>()[i];
+    const size_t p = i - i % 3;
+    const float scale =
+        std::max({radiance[p], radiance[p + 1], radiance[p + 2]});
+    hdr_ok = std::abs(v - radiance[i]) <= scale * 0.01f;
+    max_value = std::max(max_value, v);
+  }
+  record("load_float_hdr", hdr_ok && max_value > 1.0f);
+  auto auto_hdr = ImageLoader::load_auto("hdr_loading.hdr");
+  record("auto_hdr", auto_hdr && hdr && same_pixels(*auto_hdr, *hdr));
+
+  // 拷贝为深拷贝，原缓冲区由 stb 释放
+  if (hdr) {
+    Image copy = *hdr;
+    copy.ptr<float>()[0] = -1.0f;
+    record("copy_is_deep", hdr->ptr<float>()[0] != -1.0f &&
+                               !copy.matrix().isExternal());
+  }
+
+  record("missing_file",
+         !ImageLoader::load_16("no_such_file.png") &&
+             !ImageLoader::load_float("no_such_file.hdr"));
+
+  for (const char *p : {"hdr_loading_16.png", "hdr_loading_8.png",
+                        "hdr_loading_16.ppm", "hdr_loading.hdr"})
+    std::remove(p);
+
+  const bool ok = report_checks();
+  spdlog::info(ok ? "16位与HDR加载测试完成！" : "16位与HDR加载测试失败！");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+#ifndef EXAMPLES_TEST_HELPERS_HPP
+#define EXAMPLES_TEST_HELPERS_HPP
+
+// 测试程序共用的测试图像生成、比较函数和检查项记录
+
+#include <algorithm>
+#include <core/image.hpp>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dip {
+namespace test {
+
+// 逐字节随机的图像（不可压缩），任意 DataType
+inline Image random_image(int width, int height, int channels, DataType type,
+                          uint32_t seed) {
+  std::mt19937 rng(seed);
+  Image img(width, height, channels, type);
+  const size_t row_bytes =
+      static_cast<size_t>(width) * channels * dataTypeSize(type);
+  for (int y = 0; y < height; ++y) {
+    for (size_t i = 0; i < row_bytes; ++i)
+      img.ptr<uint8_t>(y)[i] = static_cast<uint8_t>(rng());
+  }
+  return img;
+}
+
+// 平滑渐变加少量噪声，接近自然图像的可压缩性（UINT8 或 UINT16）
+inline Image gradient_image(int width, int height, int channels,
+                            DataType type, uint32_t seed) {
+  std::mt19937 rng(seed);
+  Image img(width, height, channels, type);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      for (int c = 0; c < channels; ++c) {
+        const int v = (x * (c + 1) + y * 2) + static_cast<int>(rng() % 8);
+        if (type == DataType::UINT16)
+          img.ptr<uint16_t>(y)[x * channels + c] =
+              static_cast<uint16_t>(v * 97);
+        else
+          img.ptr<uint8_t>(y)[x * channels + c] = static_cast<uint8_t>(v);
+      }
+    }
+  }
+  return img;
+}
+
+// 尺寸、通道数、类型和像素都相同（逐行比较，ROI 图像的行跨度可以不同）
+inline bool same_pixels(const Image &a, const Image &b) {
+  return a.channels() == b.channels() && a.matrix() == b.matrix();
+}
+
+template <typename T>
+bool same_pixels(const std::shared_ptr<T> &a, const Image &b) {
+  return a && same_pixels(*a, b);
+}
+
+// 像素数据的字节数（不含行尾填充）
+inline size_t raw_size(const Image &img) {
+  return static_cast<size_t>(img.width()) * img.height() * img.channels() *
+         dataTypeSize(img.type());
+}
+
+// 本测试程序记录的检查项（名称，是否通过）
+inline std::vector<std::pair<std::string, bool>> &check_results() {
+  static std::vector<std::pair<std::string, bool>> results;
+  return results;
+}
+
+// 记录一个检查项的结果（在主线程调用）
+inline void record(const std::string &name, bool passed) {
+  check_results().emplace_back(name, passed);
+}
+
+// 逐项输出已记录的结果，名称按最长的一项（至少 24 列）左对齐
+// @return 是否全部通过
+inline bool report_checks() {
+  size_t width = 24;
+  for (const auto &r : check_results())
+    width = std::max(width, r.first.size());
+  bool ok = true;
+  for (const auto &r : check_results()) {
+    if (r.second)
+      spdlog::info("{:<{}} 通过", r.first, width);
+    else
+      spdlog::error("{:<{}} 失败", r.first, width);
+    ok = ok && r.second;
+  }
+  return ok;
+}
+
+} // namespace test
+} // namespace dip
+
+#endif // EXAMPLES_TEST_HELPERS_HPP
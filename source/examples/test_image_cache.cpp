@@ -0,0 +1,158 @@
+#include <atomic>
+#include <chrono>
+#include <core/core.hpp>
+#include <cstdio>
+#include <fstream>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <thread>
+
+#include "test_helpers.hpp"
+
+using namespace dip;
+using namespace dip::test;
+
+int main() {
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("=== 图像缓存测试 ===");
+
+  const Image rgb = random_image(320, 240, 3, DataType::UINT8, 1);
+  image_saver::save_binary(rgb, "cache_a.png");
+  image_saver::save_binary(random_image(200, 100, 3, DataType::UINT8, 2),
+                           "cache_b.png");
+  image_saver::save_binary(random_image(100, 50, 3, DataType::UINT8, 3),
+                           "cache_c.png");
+  const size_t rgb_bytes = rgb.matrix().total();
+
+  // 第二次载入命中，返回同一份图像；不同通道数是不同的条目
+  ImageCache cache;
+  std::atomic<int> loads{0};
+  auto load = [&](const std::string &path, int channels = 0) {
+    return cache.get(path, channels, [&, path, channels]() {
+      ++loads;
+      return ImageLoader::load_from_file(path, channels);
+    });
+  };
+  auto first = load("cache_a.png");
+  auto second = load("cache_a.png");
+  auto gray = load("cache_a.png", 1);
+  ImageCacheStats stats = cache.stats();
+  record("hit", first && first == second && first->width() == 320 &&
+                    stats.hits == 1 && stats.misses == 2 &&
+                    stats.bytes == rgb_bytes + rgb_bytes / 3);
+  record("channels_key", gray && gray != first && gray->channels() == 1);
+
+  // 文件改变后重新解码
+  image_saver::save_binary(random_image(160, 120, 3, DataType::UINT8, 4),
+                           "cache_a.png");
+  auto changed = load("cache_a.png");
+  record("invalidate_on_change",
+         changed && changed->width() == 160 &&
+             cache.stats().invalidations == 1 && first->width() == 320);
+
+  // 超过字节上限时淘汰最久未使用的图像；超大图像不进入缓存
+  cache.clear();
+  cache.set_budget(200 * 100 * 3 + 160 * 120 * 3 + 1000);
+  load("cache_b.png");
+  load("cache_c.png");
+  load("cache_b.png");
+  load("cache_a.png"); // 160x120：淘汰 c
+  const int before = loads.load();
+  load("cache_b.png");
+  const bool b_kept = loads.load() == before;
+  load("cache_c.png");
+  stats = cache.stats();
+  record("lru_budget", b_kept && loads.load() == before + 1 &&
+                           stats.evictions >= 1 &&
+                           stats.bytes <= cache.budget());
+  cache.set_budget(1000);
+  auto big = load("cache_b.png");
+  record("too_big_not_cached", big && cache.stats().entries == 0 &&
+                                   cache.stats().bytes == 0);
+
+  // 不存在的文件返回 nullptr 且不缓存
+  spdlog::set_level(spdlog::level::warn);
+  cache.set_budget(size_t(64) << 20);
+  record("missing_file", !load("cache_missing.png") &&
+                             cache.stats().entries == 0);
+  spdlog::set_level(spdlog::level::info);
+
+  // 多个线程同时请求同一文件只解码一次
+  {
+    ImageCache shared;
+    std::atomic<int> calls{0};
+    std::vector<std::shared_ptr<const Image>> got(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < got.size(); ++i) {
+      threads.emplace_back([&, i]() {
+        got[i] = shared.get("cache_b.png", 0, [&]() {
+          ++calls;
+          std::this_thread::sleep_for(std::chrono::milliseconds(100));
+          return ImageLoader::load_from_file("cache_b.png");
+        });
+      });
+    }
+    for (auto &t : threads)
+      t.join();
+    bool same = true;
+    for (const auto &img : got)
+      same = same && img && img == got[0];
+    const ImageCacheStats s = shared.stats();
+    spdlog::info("并发载入: 解码 {} 次，命中 {}，等待 {}，命中率 {:.1f}%",
+                 calls.load(), s.hits, s.coalesced, 100.0 * s.hit_rate());
+    record("single_flight", same && calls == 1 && s.misses == 1 &&
+                                s.hits + s.coalesced == got.size() - 1);
+  }
+
+  // 加载函数的异常传给调用者，失败的结果不缓存
+  {
+    ImageCache failing;
+    bool thrown = false;
+    try {
+      failing.get("cache_c.png", 0, []() -> std::shared_ptr<Image> {
+        throw std::runtime_error("decode failed");
+      });
+    } catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    auto retry = failing.get("cache_c.png", 0, []() {
+      return ImageLoader::load_from_file("cache_c.png");
+    });
+    record("loader_exception", thrown && retry && retry->width() == 100 &&
+                                   failing.stats().misses == 2);
+  }
+
+  // ImageLoader::load_cached 使用进程级缓存
+  const auto t0 = std::chrono::steady_clock::now();
+  auto cold = ImageLoader::load_cached("cache_a.png");
+  const auto t1 = std::chrono::steady_clock::now();
+  auto warm = ImageLoader::load_cached("cache_a.png");
+  const auto t2 = std::chrono::steady_clock::now();
+  spdlog::info("load_cached: 首次 {} us，命中 {} us",
+               std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0)
+                   .count(),
+               std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1)
+                   .count());
+  record("load_cached", cold && cold == warm &&
+                            ImageCache::global().stats().hits >= 1);
+
+  // 缓存的PNM图像是自有存储：原地改写文件不影响已返回的图像
+  const Image ppm = random_image(64, 32, 3, DataType::UINT8, 5);
+  ImageLoader::save_as_ppm_binary(ppm, "cache_d.ppm");
+  auto cached_ppm = ImageLoader::load_cached("cache_d.ppm");
+  {
+    std::ofstream rewrite("cache_d.ppm", std::ios::binary | std::ios::trunc);
+    rewrite << "P6\n64 32\n255\n" << std::string(64 * 32 * 3, '\xC8');
+  }
+  record("owned_storage", cached_ppm && !cached_ppm->matrix().isExternal() &&
+                              cached_ppm->matrix() == ppm.matrix());
+  ImageCache::global().clear();
+
+  for (const char *p :
+       {"cache_a.png", "cache_b.png", "cache_c.png", "cache_d.ppm"})
+    std::remove(p);
+
+  const bool ok = report_checks();
+  spdlog::info(ok ? "图像缓存测试完成！" : "图像缓存测试失败！");
+  return ok ? 0 : 1;
+}
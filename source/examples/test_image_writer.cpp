@@ -0,0 +1,160 @@
+#include <chrono>
+#include <cmath>
+#include <core/core.hpp>
+#include <cstdio>
+#include <fstream>
+#include <spdlog/spdlog.h>
+
+#include "test_helpers.hpp"
+
+using namespace dip;
+using namespace dip::test;
+
+namespace {
+
+size_t file_size(const std::string &path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  return file ? static_cast<size_t>(file.tellg()) : 0;
+}
+
+// 用 stb 解码并与原图逐字节比较
+bool decodes_to(const std::string &path, const Image &expected) {
+  int width = 0, height = 0, channels = 0;
+  bool same = false;
+  if (expected.type() == DataType::UINT16) {
+    stbi_us *data = stbi_load_16(path.c_str(), &width, &height, &channels,
+                                 expected.channels());
+    same = data && width == expected.width() &&
+           height == expected.height() &&
+           std::equal(data, data + expected.matrix().total(),
+                      expected.ptr<uint16_t>());
+    stbi_image_free(data);
+  } else {
+    stbi_uc *data = stbi_load(path.c_str(), &width, &height, &channels,
+                              expected.channels());
+    same = data && width == expected.width() &&
+           height == expected.height() &&
+           std::equal(data, data + expected.matrix().total(),
+                      expected.ptr<uint8_t>());
+    stbi_image_free(data);
+  }
+  return same;
+}
+
+// JPEG 有损，检查平均绝对误差
+double mean_abs_error(const std::string &path, const Image &expected) {
+  auto loaded = ImageLoader::load_from_file(path, expected.channels());
+  if (!loaded)
+    return 1e9;
+  double sum = 0;
+  const size_t total = expected.matrix().total();
+  for (size_t i = 0; i < total; ++i)
+    sum += std::abs(loaded->ptr<uint8_t>()[i] - expected.ptr<uint8_t>()[i]);
+  return sum / total;
+}
+
+} // namespace
+
+int main() {
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("=== 图像编码测试（{} 线程）===", get_num_threads());
+
+  // PNG 无损：各通道数、16位、各压缩级别
+  for (int channels = 1; channels <= 4; ++channels) {
+    const Image img =
+        gradient_image(123, 77, channels, DataType::UINT8, channels);
+    image_saver::save(img, "image_writer.png");
+    record("png_" + std::to_string(channels) + "ch",
+           decodes_to("image_writer.png", img));
+  }
+  const Image wide = gradient_image(90, 60, 3, DataType::UINT16, 5);
+  ImageLoader::save_as_png(wide, "image_writer.png");
+  record("png_16bit", decodes_to("image_writer.png", wide));
+
+  const Image rgb = gradient_image(640, 480, 3, DataType::UINT8, 9);
+  const size_t raw_bytes = rgb.matrix().total();
+  bool levels_ok = true;
+  std::string sizes;
+  for (int level : {0, 1, 6, 9}) {
+    ImageLoader::save_as_png(rgb, "image_writer.png", level);
+    levels_ok = levels_ok && decodes_to("image_writer.png", rgb);
+    sizes += fmt::format(" L{}={}", level, file_size("image_writer.png"));
+  }
+  record("png_levels", levels_ok);
+
+  // 多条带：按条带拼接的zlib流可以正常解码，且与线程数无关
+  const Image large = gradient_image(1500, 1100, 3, DataType::UINT8, 13);
+  std::vector<uint8_t> multi, single;
+  PngOptions options;
+  options.strip_rows = 97;
+  encode_png(large, multi, options);
+  const int threads = get_num_threads();
+  set_num_threads(1);
+  encode_png(large, single, options);
+  set_num_threads(threads);
+  {
+    std::ofstream file("image_writer_strips.png", std::ios::binary);
+    file.write(reinterpret_cast<const char *>(multi.data()), multi.size());
+  }
+  record("png_strips", decodes_to("image_writer_strips.png", large));
+  record("png_deterministic", multi == single);
+
+  // stb 编码的格式
+  ImageLoader::save_as_bmp(rgb, "image_writer.bmp");
+  record("bmp", decodes_to("image_writer.bmp", rgb));
+  const Image roi = rgb.roi(Rect(13, 7, 101, 55));
+  ImageLoader::save_as_bmp(roi, "image_writer.bmp");
+  Image compact(roi.width(), roi.height(), roi.channels());
+  for (int y = 0; y < roi.height(); ++y)
+    std::copy(roi.ptr<uint8_t>(y),
+              roi.ptr<uint8_t>(y) + roi.width() * roi.channels(),
+              compact.ptr<uint8_t>(y));
+  record("bmp_roi", decodes_to("image_writer.bmp", compact));
+  ImageLoader::save_as_tga(rgb, "image_writer.tga");
+  record("tga", decodes_to("image_writer.tga", rgb));
+  SaveOptions jpeg_options;
+  jpeg_options.jpeg_quality = 95;
+  image_saver::save_binary(rgb, "image_writer.jpg", jpeg_options);
+  const double jpeg_error = mean_abs_error("image_writer.jpg", rgb);
+  record("jpeg", jpeg_error < 4.0);
+  record("unsupported_rejected",
+         !ImageLoader::save_as_jpeg(wide, "image_writer_wide.jpg"));
+
+  // 批量保存
+  std::vector<Image> images;
+  std::vector<std::string> paths;
+  for (int i = 0; i < 16; ++i) {
+    images.push_back(gradient_image(200, 150, 3, DataType::UINT8, 100 + i));
+    paths.push_back("image_writer_batch_" + std::to_string(i) +
+                    (i % 2 ? ".png" : ".bmp"));
+  }
+  paths.back() = "no_such_dir/image_writer.png";
+  bool batch_ok = image_saver::save_batch(images, paths) == images.size() - 1;
+  for (size_t i = 0; i + 1 < images.size() && batch_ok; ++i)
+    batch_ok = decodes_to(paths[i], images[i]);
+  record("save_batch", batch_ok);
+
+  // 大图像PNG编码吞吐量
+  auto start = std::chrono::steady_clock::now();
+  ImageLoader::save_as_png(large, "image_writer_strips.png");
+  auto end = std::chrono::steady_clock::now();
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  const size_t large_png = file_size("image_writer_strips.png");
+
+  for (const char *p : {"image_writer.png", "image_writer_strips.png",
+                        "image_writer.bmp", "image_writer.tga",
+                        "image_writer.jpg"})
+    std::remove(p);
+  for (const auto &p : paths)
+    std::remove(p.c_str());
+
+  const bool ok = report_checks();
+  spdlog::info("640x480 RGB 原始 {} 字节，PNG{}", raw_bytes, sizes);
+  spdlog::info("JPEG(q=95) 平均误差 {:.2f}", jpeg_error);
+  spdlog::info("{}x{} PNG：{:.3f} s，{:.0f} MB/s（输入），压缩为 {:.1f}%",
+               large.width(), large.height(), seconds,
+               large.matrix().total() / seconds / (1 << 20),
+               100.0 * large_png / large.matrix().total());
+  spdlog::info(ok ? "图像编码测试完成！" : "图像编码测试失败！");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+#include <algorithms/bilinear_zoom.hpp>
+#include <algorithms/rotate.hpp>
+#include <cmath>
+#include <core/core.hpp>
+#include <spdlog/spdlog.h>
+
+using namespace dip;
+
+namespace {
+
+void log_stats(const std::string &tag, const memory::MemoryStats &s) {
+  spdlog::info("{:<24} current {:>8.2f} MB, peak {:>8.2f} MB, {} allocs, "
+               "largest {:.2f} MB",
+               tag, s.current_bytes / 1e6, s.peak_bytes / 1e6, s.allocations,
+               s.largest_allocation / 1e6);
+}
+
+} // namespace
+
+int main() {
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("=== Matrix 内存统计测试 ===");
+  spdlog::info("内存统计: {}", memory::compiled_in() ? "已编译" : "未编译");
+
+  bool ok = true;
+  const memory::MemoryStats before = memory::stats();
+
+  {
+    Matrix m(1000, 1000, DataType::FLOAT32); // 4MB
+    const memory::MemoryStats during = memory::stats();
+    if (memory::compiled_in()) {
+      ok = ok && during.current_bytes == before.current_bytes + 4000000 &&
+           during.allocations == before.allocations + 1 &&
+           during.largest_allocation >= 4000000;
+    } else {
+      ok = ok && during.allocations == 0;
+    }
+
+    m.release();
+    ok = ok && memory::stats().current_bytes == before.current_bytes;
+  }
+
+  Image input(640, 480, 3);
+  input.setTo(Scalar(10, 20, 30));
+  memory::reset_peak();
+  const size_t base = memory::stats().current_bytes;
+
+  spdlog::set_level(spdlog::level::warn);
+  Image zoomed = algorithms::bilinear_zoom(input, 2.0f);
+  Image rotated = algorithms::rotate(input, M_PI / 4);
+  {
+    DIP_MEMORY_SCOPE("test.scratch");
+    Matrix scratch(256, 256, DataType::UINT8);
+  }
+  spdlog::set_level(spdlog::level::info);
+
+  const memory::MemoryStats after = memory::stats();
+  if (memory::compiled_in()) {
+    const size_t zoomed_bytes = zoomed.matrix().total();
+    ok = ok && after.current_bytes >= base + zoomed_bytes &&
+         after.peak_bytes >= after.current_bytes;
+
+    bool found_zoom = false, found_scratch = false;
+    for (const auto &t : memory::tag_stats()) {
+      log_stats(t.tag, t.stats);
+      if (t.tag == "bilinear_zoom")
+        found_zoom = t.stats.largest_allocation >= zoomed_bytes;
+      if (t.tag == "test.scratch")
+        found_scratch = t.stats.current_bytes == 0 &&
+                        t.stats.largest_allocation == 256 * 256;
+    }
+    log_stats("total", after);
+    ok = ok && found_zoom && found_scratch;
+  } else {
+    ok = ok && after.allocations == 0 && memory::tag_stats().empty();
+    spdlog::info("使用 -DDIP_ENABLE_MEMORY_TRACKING=ON 重新配置以启用统计");
+  }
+
+  spdlog::info(ok ? "内存统计测试完成！" : "内存统计测试失败！");
+  return ok ? 0 : 1;
+}
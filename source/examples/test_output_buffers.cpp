@@ -0,0 +1,203 @@
+#include <algorithms/bilinear_zoom.hpp>
+#include <algorithms/connected_components.hpp>
+#include <algorithms/downsample.hpp>
+#include <algorithms/nearest_neighbor_zoom.hpp>
+#include <algorithms/quantize.hpp>
+#include <algorithms/rotate.hpp>
+#include <algorithms/set_logical_ops.hpp>
+#include <algorithms/spatial_ops.hpp>
+#include <cmath>
+#include <core/core.hpp>
+#include <functional>
+#include <spdlog/spdlog.h>
+
+#include "test_helpers.hpp"
+
+using namespace dip;
+using namespace dip::test;
+using namespace dip::algorithms;
+
+namespace {
+
+// 检查 dst 重载与返回值版本结果一致，且第二次调用复用 dst 的缓冲区
+bool check(const std::function<Image()> &by_value,
+           const std::function<void(Image &)> &into) {
+  const Image expected = by_value();
+  Image dst;
+  into(dst);
+  const void *buffer = dst.data();
+  into(dst);
+
+  return same_pixels(expected, dst) && dst.data() == buffer;
+}
+
+// 检查原地运算与返回值版本结果一致
+bool check_inplace(const Image &input,
+                   const std::function<Image(const Image &)> &by_value,
+                   const std::function<void(Image &)> &inplace) {
+  const Image expected = by_value(input);
+  Image work = input.clone();
+  const void *buffer = work.data();
+  inplace(work);
+
+  return same_pixels(expected, work) && work.data() == buffer;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  spdlog::set_level(spdlog::level::info);
+
+  std::string filename = argc > 1 ? argv[1] : "test.png";
+  auto loaded = ImageLoader::load_from_file(filename);
+  if (!loaded || loaded->empty()) {
+    spdlog::error("Failed to load image: {}", filename);
+    return 1;
+  }
+  const Image &img = *loaded;
+
+  Image binary1(img.width(), img.height(), img.channels());
+  Image binary2(img.width(), img.height(), img.channels());
+  const int row_elems = img.width() * img.channels();
+  for (int y = 0; y < img.height(); ++y) {
+    const uint8_t *src = img.ptr<uint8_t>(y);
+    uint8_t *b1 = binary1.ptr<uint8_t>(y);
+    uint8_t *b2 = binary2.ptr<uint8_t>(y);
+    for (int i = 0; i < row_elems; ++i) {
+      b1[i] = src[i] > 128 ? 1 : 0;
+      b2[i] = (src[i] & 1) ? 1 : 0;
+    }
+  }
+  Image gray(img.width(), img.height(), 1);
+  for (int y = 0; y < img.height(); ++y) {
+    for (int x = 0; x < img.width(); ++x) {
+      gray.at<uint8_t>(y, x) = img.at<uint8_t>(y, x, 0) > 100 ? 1 : 0;
+    }
+  }
+
+  spdlog::info("=== 输出缓冲区复用测试 ===");
+  spdlog::set_level(spdlog::level::warn);
+  record("bilinear_zoom",
+         check([&] { return bilinear_zoom(img, 1.5f); },
+               [&](Image &dst) { bilinear_zoom(img, 1.5f, dst); }));
+  record("nearest_neighbor_zoom",
+         check([&] { return nearest_neighbor_zoom(img, 0.5f); },
+               [&](Image &dst) { nearest_neighbor_zoom(img, 0.5f, dst); }));
+  record("rotate", check([&] { return rotate(img, M_PI / 6); },
+                         [&](Image &dst) { rotate(img, M_PI / 6, dst); }));
+  record("downsample",
+         check([&] { return downsample(img, 3); },
+               [&](Image &dst) { downsample(img, 3, dst); }));
+  record("quantize", check([&] { return quantize(img, 8); },
+                           [&](Image &dst) { quantize(img, 8, dst); }));
+  record("invert_image",
+         check([&] { return invert_image(img, 255); },
+               [&](Image &dst) { invert_image(img, 255, dst); }));
+  record("set_complement",
+         check([&] { return set_complement(img, 200); },
+               [&](Image &dst) { set_complement(img, 200, dst); }));
+  record("logical_and",
+         check([&] { return logical_and(binary1, binary2); },
+               [&](Image &dst) { logical_and(binary1, binary2, dst); }));
+  record("logical_xor",
+         check([&] { return logical_xor(binary1, binary2); },
+               [&](Image &dst) { logical_xor(binary1, binary2, dst); }));
+
+  record("quantize_inplace",
+         check_inplace(img, [](const Image &in) { return quantize(in, 4); },
+                       [](Image &io) { quantize(io, 4, io); }));
+  record("invert_inplace",
+         check_inplace(img,
+                       [](const Image &in) { return invert_image(in, 255); },
+                       [](Image &io) { invert_image(io, 255, io); }));
+  record("complement_inplace",
+         check_inplace(img,
+                       [](const Image &in) { return set_complement(in, 255); },
+                       [](Image &io) { set_complement(io, 255, io); }));
+  record("and_inplace",
+         check_inplace(
+             binary1,
+             [&](const Image &in) { return logical_and(in, binary2); },
+             [&](Image &io) { logical_and(io, binary2, io); }));
+  record("xor_inplace",
+         check_inplace(
+             binary1,
+             [&](const Image &in) { return logical_xor(in, binary2); },
+             [&](Image &io) { logical_xor(io, binary2, io); }));
+
+  // ROI 图像保留原图的行跨度，原地运算按该跨度访问各行
+  const Rect roi_rect(img.width() / 4, img.height() / 4, img.width() / 4,
+                      img.height() / 4);
+  const Image roi = img.pixel_roi(roi_rect);
+  const Image binary_roi = binary1.pixel_roi(roi_rect);
+  const Image binary2_roi = binary2.pixel_roi(roi_rect);
+  record("roi_padded_step",
+         roi.matrix().step() >
+             static_cast<size_t>(roi.width()) * roi.channels());
+  record("roi_quantize_inplace",
+         check_inplace(roi, [](const Image &in) { return quantize(in, 4); },
+                       [](Image &io) { quantize(io, 4, io); }));
+  record("roi_invert_inplace",
+         check_inplace(roi,
+                       [](const Image &in) { return invert_image(in, 255); },
+                       [](Image &io) { invert_image(io, 255, io); }));
+  record("roi_complement_inplace",
+         check_inplace(roi,
+                       [](const Image &in) { return set_complement(in, 255); },
+                       [](Image &io) { set_complement(io, 255, io); }));
+  record("roi_and_inplace",
+         check_inplace(
+             binary_roi,
+             [&](const Image &in) { return logical_and(in, binary2_roi); },
+             [&](Image &io) { logical_and(io, binary2_roi, io); }));
+
+  // 连通分量：LabelResult 复用标记图像
+  {
+    const LabelResult expected =
+        label_components(gray, NeighborhoodType::N8, 1);
+    LabelResult reused{Image(), 0};
+    label_components_parallel(gray, NeighborhoodType::N8, 1, reused, 4);
+    const void *buffer = reused.labels.data();
+    label_components(gray, NeighborhoodType::N8, 1, reused);
+    bool passed = reused.num_components == expected.num_components &&
+                  same_pixels(expected.labels, reused.labels) &&
+                  reused.labels.data() == buffer;
+    label_components_parallel(gray, NeighborhoodType::N8, 1, reused, 4);
+    passed = passed && reused.num_components == expected.num_components &&
+             same_pixels(expected.labels, reused.labels) &&
+             reused.labels.data() == buffer;
+    record("label_components", passed);
+  }
+
+  // 改变尺寸的算法不能原地运行
+  bool rejected = false;
+  try {
+    Image io = img.clone();
+    bilinear_zoom(io, 2.0f, io);
+  } catch (const std::invalid_argument &) {
+    rejected = true;
+  }
+  record("alias_rejected", rejected);
+
+  // 稳态：尺寸不变时每帧不再分配
+  {
+    Image rotated, zoomed, quantized;
+    rotate(img, 0.3, rotated);
+    bilinear_zoom(rotated, 0.5f, zoomed);
+    quantize(zoomed, 16, quantized);
+    const memory::MemoryStats before = memory::stats();
+    for (int frame = 0; frame < 3; ++frame) {
+      rotate(img, 0.3 + frame * 0.1, rotated);
+      bilinear_zoom(rotated, 0.5f, zoomed);
+      quantize(zoomed, 16, quantized);
+      quantize(quantized, 4, quantized);
+    }
+    record("steady_state_no_alloc",
+           memory::stats().allocations == before.allocations);
+  }
+  spdlog::set_level(spdlog::level::info);
+
+  const bool ok = report_checks();
+  spdlog::info(ok ? "输出缓冲区复用测试完成！" : "输出缓冲区复用测试失败！");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+#include <algorithms/bilinear_zoom.hpp>
+#include <algorithms/downsample.hpp>
+#include <algorithms/nearest_neighbor_zoom.hpp>
+#include <algorithms/quantize.hpp>
+#include <algorithms/rotate.hpp>
+#include <algorithms/set_logical_ops.hpp>
+#include <algorithms/spatial_ops.hpp>
+#include <chrono>
+#include <core/core.hpp>
+#include <functional>
+#include <spdlog/spdlog.h>
+
+using namespace dip;
+
+namespace {
+
+// 分别以单线程和多线程运行同一算法，比较输出并统计耗时
+bool check_algorithm(const std::string &name,
+                     const std::function<Image()> &run, int threads) {
+  set_num_threads(1);
+  auto start = std::chrono::high_resolution_clock::now();
+  Image serial = run();
+  auto mid = std::chrono::high_resolution_clock::now();
+
+  set_num_threads(threads);
+  Image parallel = run();
+  auto end = std::chrono::high_resolution_clock::now();
+
+  auto serial_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(mid - start);
+  auto parallel_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(end - mid);
+  bool same = serial == parallel;
+  spdlog::info("{:<24} 串行 {:>5} ms, {} 线程 {:>5} ms, 结果{}", name,
+               serial_ms.count(), threads, parallel_ms.count(),
+               same ? "一致" : "不一致");
+  return same;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  spdlog::set_level(spdlog::level::info);
+
+  std::string filename = argc > 1 ? argv[1] : "test.png";
+  int threads = argc > 2 ? std::atoi(argv[2]) : 8;
+
+  auto loaded = ImageLoader::load_from_file(filename);
+  if (!loaded || loaded->empty()) {
+    spdlog::error("Failed to load image: {}", filename);
+    return 1;
+  }
+  const Image &img = *loaded;
+
+  // 用于逻辑运算的二值图
+  Image bin1(img.width(), img.height(), img.channels());
+  Image bin2(img.width(), img.height(), img.channels());
+  for (int y = 0; y < img.height(); ++y) {
+    for (int x = 0; x < img.width() * img.channels(); ++x) {
+      bin1.ptr<uint8_t>(y)[x] = img.ptr<uint8_t>(y)[x] > 128;
+      bin2.ptr<uint8_t>(y)[x] = (x + y) % 3 == 0;
+    }
+  }
+
+  spdlog::info("=== parallel_for 一致性测试: {}x{}x{}, {} 线程 ===",
+               img.width(), img.height(), img.channels(), threads);
+
+  bool passed = true;
+  passed &= check_algorithm(
+      "quantize", [&] { return algorithms::quantize(img, 8); }, threads);
+  passed &= check_algorithm(
+      "downsample", [&] { return algorithms::downsample(img, 3); }, threads);
+  passed &= check_algorithm(
+      "rotate", [&] { return algorithms::rotate(img, 0.5); }, threads);
+  passed &= check_algorithm(
+      "bilinear_zoom", [&] { return algorithms::bilinear_zoom(img, 2.5f); },
+      threads);
+  passed &= check_algorithm(
+      "nearest_neighbor_zoom",
+      [&] { return algorithms::nearest_neighbor_zoom(img, 2.5f); }, threads);
+  passed &= check_algorithm(
+      "invert_image", [&] { return invert_image(img, 255); }, threads);
+  passed &= check_algorithm(
+      "set_complement", [&] { return set_complement(img, 200); }, threads);
+  passed &= check_algorithm(
+      "logical_and", [&] { return logical_and(bin1, bin2); }, threads);
+  passed &= check_algorithm(
+      "logical_xor", [&] { return logical_xor(bin1, bin2); }, threads);
+
+  // 异常从工作线程传播到调用线程
+  set_num_threads(threads);
+  bool caught = false;
+  try {
+    parallel_for(
+        0, 100,
+        [](int r0, int) {
+          if (r0 >= 50)
+            throw std::runtime_error("row failure");
+        },
+        10);
+  } catch (const std::runtime_error &) {
+    caught = true;
+  }
+  spdlog::info("异常传播: {}", caught ? "正常" : "失败");
+  passed &= caught;
+
+  if (passed) {
+    spdlog::info("parallel_for 一致性测试通过！");
+  } else {
+    spdlog::error("parallel_for 一致性测试失败！");
+  }
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+#include <core/core.hpp>
+#include <cstdio>
+#include <fstream>
+#include <spdlog/spdlog.h>
+
+#include "test_helpers.hpp"
+
+using namespace dip;
+using namespace dip::test;
+
+namespace {
+
+void write_file(const std::string &path, const std::string &content) {
+  std::ofstream file(path, std::ios::binary);
+  file << content;
+}
+
+} // namespace
+
+int main() {
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("=== PNM读取器测试 ===");
+
+  // 8位彩色：load_pnm 零拷贝加载，拷贝为深拷贝
+  const Image rgb = random_image(97, 61, 3, DataType::UINT8, 1);
+  ImageLoader::save_as_ppm_binary(rgb, "pnm_reader_rgb.ppm");
+  auto loaded = ImageLoader::load_pnm("pnm_reader_rgb.ppm");
+  record("uint8_roundtrip", loaded && same_pixels(*loaded, rgb));
+  record("uint8_zero_copy", loaded && loaded->matrix().isExternal());
+  if (loaded) {
+    Image copy = *loaded;
+    copy.ptr<uint8_t>(0)[0] ^= 0xFF;
+    record("copy_is_deep", !copy.matrix().isExternal() &&
+                               copy.data() != loaded->data() &&
+                               same_pixels(*loaded, rgb));
+  }
+
+  // 与 stb 解码结果一致（请求灰度时回退到 stb 转换通道数）
+  int width = 0, height = 0, channels = 0;
+  unsigned char *stb = stbi_load("pnm_reader_rgb.ppm", &width, &height,
+                                 &channels, 0);
+  record("matches_stb",
+         stb && loaded && width == loaded->width() &&
+             height == loaded->height() &&
+             std::equal(stb, stb + width * height * channels,
+                        loaded->ptr<uint8_t>()));
+  stbi_image_free(stb);
+  auto gray = ImageLoader::load_from_file("pnm_reader_rgb.ppm", 1);
+  record("channel_conversion_fallback", gray && gray->channels() == 1 &&
+                                            !gray->matrix().isExternal());
+
+  // load_from_file 读入自有缓冲区：保存回同一路径、截断文件都不影响图像
+  auto owned = ImageLoader::load_from_file("pnm_reader_rgb.ppm");
+  const bool saved_over =
+      owned && !owned->matrix().isExternal() &&
+      ImageLoader::save_as_ppm_binary(*owned, "pnm_reader_rgb.ppm");
+  auto reloaded = ImageLoader::load_from_file("pnm_reader_rgb.ppm");
+  write_file("pnm_reader_rgb.ppm", "P6\n");
+  record("load_from_file_owned", saved_over &&
+                                     same_pixels(reloaded, rgb) &&
+                                     same_pixels(owned, rgb));
+  ImageLoader::save_as_ppm_binary(rgb, "pnm_reader_rgb.ppm");
+
+#if defined(__linux__)
+  // 写入失败（设备已满）时返回 false
+  record("write_failure_reported",
+         !ImageLoader::save_as_ppm_binary(rgb, "/dev/full"));
+#endif
+
+  // 16位灰度：大端样本转换为本机字节序
+  const Image wide = random_image(53, 40, 1, DataType::UINT16, 2);
+  ImageLoader::save_as_ppm_binary(wide, "pnm_reader_wide.pgm");
+  auto wide_loaded = ImageLoader::load_pnm("pnm_reader_wide.pgm");
+  Image wide_read;
+  record("uint16_roundtrip", wide_loaded &&
+                                 wide_loaded->type() == DataType::UINT16 &&
+                                 same_pixels(*wide_loaded, wide) &&
+                                 read_pnm("pnm_reader_wide.pgm", wide_read) &&
+                                 same_pixels(wide_read, wide));
+
+  // 按行流式读取
+  PnmReader reader;
+  bool rows_ok = reader.open("pnm_reader_wide.pgm");
+  reader.advise_sequential();
+  Image strip;
+  for (int y = 0; rows_ok && y < reader.height(); y += 16) {
+    const int count = std::min(16, reader.height() - y);
+    reader.read_rows(y, count, strip);
+    for (int i = 0; i < count && rows_ok; ++i) {
+      rows_ok = std::equal(strip.ptr<uint16_t>(i),
+                           strip.ptr<uint16_t>(i) + wide.width(),
+                           wide.ptr<uint16_t>(y + i));
+    }
+  }
+  record("read_rows", rows_ok);
+
+  // 文件头中的注释；图像在读取器关闭后仍然有效
+  write_file("pnm_reader_comment.pgm",
+             std::string("P5\n# comment\n3 # width\n2\n255\n") +
+                 std::string("\x01\x02\x03\x04\x05\x06", 6));
+  Image commented;
+  {
+    PnmReader r;
+    if (r.open("pnm_reader_comment.pgm"))
+      commented = r.image();
+  }
+  record("header_comments", !commented.empty() && commented.width() == 3 &&
+                                commented.height() == 2 &&
+                                commented.at<uint8_t>(1, 2) == 6);
+
+  // 截断的文件和非PNM文件
+  write_file("pnm_reader_truncated.pgm", "P5\n4 4\n255\nabc");
+  write_file("pnm_reader_ascii.pgm", "P2\n1 1\n255\n7\n");
+  PnmReader bad;
+  bool truncated = !bad.open("pnm_reader_truncated.pgm") &&
+                   !bad.error().empty() && !bad.is_open();
+  bool ascii = !bad.open("pnm_reader_ascii.pgm");
+  bool missing = ImageLoader::load_pnm("no_such_file.pgm") == nullptr;
+  record("malformed_rejected", truncated && ascii && missing);
+
+  for (const char *p :
+       {"pnm_reader_rgb.ppm", "pnm_reader_wide.pgm", "pnm_reader_comment.pgm",
+        "pnm_reader_truncated.pgm", "pnm_reader_ascii.pgm"})
+    std::remove(p);
+
+  const bool ok = report_checks();
+  spdlog::info(ok ? "PNM读取器测试完成！" : "PNM读取器测试失败！");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+#include <algorithms/region_props.hpp>
+#include <chrono>
+#include <cmath>
+#include <core/core.hpp>
+#include <spdlog/spdlog.h>
+#include <sstream>
+#include <stdexcept>
+
+using namespace dip;
+
+int main(int argc, char *argv[]) {
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("=== 连通区域统计测试 ===");
+
+  // 构造若干矩形块作为前景，强度图为坐标相关的渐变
+  const int width = 64, height = 48;
+  Image mask(width, height, 1);
+  Image intensity(width, height, 1);
+  mask.setTo(Scalar(0));
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      intensity.set_pixel(x, y, 0, static_cast<uint8_t>((x * 3 + y * 5) % 256));
+    }
+  }
+
+  const Rect blocks[] = {Rect(2, 3, 10, 5), Rect(20, 10, 7, 12),
+                         Rect(40, 30, 15, 9), Rect(5, 30, 1, 1)};
+  for (const auto &r : blocks) {
+    for (int y = r.y; y < r.y + r.height; ++y) {
+      for (int x = r.x; x < r.x + r.width; ++x) {
+        mask.set_pixel(x, y, 0, 1);
+      }
+    }
+  }
+
+  auto labelled = label_components(mask, NeighborhoodType::N8, 1);
+  auto props = region_props(labelled, intensity);
+  spdlog::info("区域数量: {}", props.count);
+
+  // 与逐区域遍历的参考结果对比
+  bool passed = props.count == 4;
+  for (int l = 1; l <= props.count; ++l) {
+    int64_t area = 0;
+    double sum_x = 0, sum_y = 0, sum_i = 0;
+    double min_i = 255, max_i = 0;
+    Rect bbox;
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        if (labelled.labels.at<int32_t>(y, x) != l)
+          continue;
+        double v = intensity.get_pixel(x, y);
+        ++area;
+        sum_x += x;
+        sum_y += y;
+        sum_i += v;
+        min_i = std::min(min_i, v);
+        max_i = std::max(max_i, v);
+        bbox = bbox | Rect(x, y, 1, 1);
+      }
+    }
+
+    Point2d c = props.centroid(l);
+    bool ok = props.area[l - 1] == area && props.bbox(l) == bbox &&
+              std::abs(c.x - sum_x / area) < 1e-9 &&
+              std::abs(c.y - sum_y / area) < 1e-9 &&
+              std::abs(props.mean_intensity(l) - sum_i / area) < 1e-9 &&
+              props.min_intensity[l - 1] == min_i &&
+              props.max_intensity[l - 1] == max_i;
+
+    std::ostringstream bbox_str;
+    bbox_str << props.bbox(l);
+    spdlog::info("区域{}: 面积={} {} 质心=({:.2f}, {:.2f}) 强度均值={:.2f} "
+                 "最小={} 最大={} {}",
+                 l, props.area[l - 1], bbox_str.str(), c.x, c.y,
+                 props.mean_intensity(l), props.min_intensity[l - 1],
+                 props.max_intensity[l - 1], ok ? "OK" : "MISMATCH");
+    passed = passed && ok;
+  }
+
+  // 大于 2^24 的整数强度不经 float 转换，统计值保持精确
+  Image wide(width, height, 1, DataType::INT32);
+  wide.matrix().setTo(Scalar(16777217));
+  auto wide_props = region_props(labelled, wide);
+  const bool exact = wide_props.max_intensity[0] == 16777217.0 &&
+                     wide_props.mean_intensity(1) == 16777217.0;
+  spdlog::info("整数强度精度: {}", exact ? "OK" : "MISMATCH");
+  passed = passed && exact;
+
+  // 标号超出 num_components 时抛出异常，而不是越界写入
+  bool rejected = false;
+  try {
+    region_props(labelled.labels, labelled.num_components - 1);
+  } catch (const std::invalid_argument &) {
+    rejected = true;
+  }
+  spdlog::info("标号越界检查: {}", rejected ? "OK" : "MISMATCH");
+  passed = passed && rejected;
+
+  // 大图像性能：统计耗时只与像素数相关
+  int large_w = argc > 1 ? std::atoi(argv[1]) : 4000;
+  int large_h = argc > 2 ? std::atoi(argv[2]) : 4000;
+  Image large(large_w, large_h, 1);
+  for (int y = 0; y < large_h; ++y) {
+    uint8_t *row = large.ptr<uint8_t>(y);
+    for (int x = 0; x < large_w; ++x) {
+      row[x] = ((x / 7) % 2 == 0 && (y / 5) % 2 == 0) ? 1 : 0;
+    }
+  }
+  auto large_labels = label_components(large, NeighborhoodType::N4, 1);
+  auto start = std::chrono::high_resolution_clock::now();
+  auto large_props = region_props(large_labels, large);
+  auto end = std::chrono::high_resolution_clock::now();
+  spdlog::info("{}x{} 图像 {} 个区域, 统计耗时 {} ms", large_w, large_h,
+               large_props.count,
+               std::chrono::duration_cast<std::chrono::milliseconds>(end -
+                                                                     start)
+                   .count());
+
+  if (passed) {
+    spdlog::info("连通区域统计测试通过！");
+  } else {
+    spdlog::error("连通区域统计测试失败！");
+  }
+  return passed ? 0 : 1;
+}
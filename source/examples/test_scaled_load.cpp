@@ -0,0 +1,97 @@
+#include <algorithms/downsample.hpp>
+#include <algorithms/scaled_load.hpp>
+#include <chrono>
+#include <core/core.hpp>
+#include <cstdio>
+#include <spdlog/spdlog.h>
+
+#include "test_helpers.hpp"
+
+using namespace dip;
+using namespace dip::test;
+using namespace dip::algorithms;
+
+namespace {
+
+template <typename F> double time_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace
+
+int main() {
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("=== 缩小加载测试 ===");
+
+  record("factor_plan", scale_factor_for(4000, 3000, 256) == 16 &&
+                            scale_factor_for(100, 80, 256) == 1 &&
+                            scale_factor_for(513, 10, 256) == 3);
+
+  // 结果与整幅加载后 downsample 一致（PNM 条带路径与 PNG 整幅路径）
+  const Image rgb = gradient_image(2411, 1733, 3, DataType::UINT8, 1);
+  const Image gray = gradient_image(1000, 3001, 1, DataType::UINT8, 2);
+  ImageLoader::save_as_ppm_binary(rgb, "scaled_load.ppm");
+  ImageLoader::save_as_ppm_binary(gray, "scaled_load.pgm");
+  ImageLoader::save_as_png(rgb, "scaled_load.png", 1);
+
+  bool pnm_ok = true, png_ok = true;
+  for (int max_size : {1000, 256, 100, 7}) {
+    const int f = scale_factor_for(rgb.width(), rgb.height(), max_size);
+    const Image expected = downsample(rgb, f);
+    auto scaled = load_scaled("scaled_load.ppm", max_size);
+    pnm_ok = pnm_ok && same_pixels(scaled, expected) &&
+             std::max(scaled->width(), scaled->height()) <= max_size;
+    png_ok = png_ok &&
+             same_pixels(load_scaled("scaled_load.png", max_size), expected);
+
+    const int fg = scale_factor_for(gray.width(), gray.height(), max_size);
+    pnm_ok = pnm_ok && same_pixels(load_scaled("scaled_load.pgm", max_size),
+                                   downsample(gray, fg));
+  }
+  record("pnm_strips_match", pnm_ok);
+  record("png_matches", png_ok);
+  record("no_reduction",
+         same_pixels(load_scaled("scaled_load.ppm", 5000), rgb));
+
+  // 不缩小的结果不引用文件映射：截断源文件后像素不变
+  ImageLoader::save_as_ppm_binary(gray, "scaled_load_owned.pgm");
+  auto owned = load_scaled("scaled_load_owned.pgm", 5000);
+  if (std::FILE *f = std::fopen("scaled_load_owned.pgm", "wb"))
+    std::fclose(f);
+  record("owned_storage", same_pixels(owned, gray));
+
+  // 通道数转换回退到 stb
+  auto gray_thumb = load_scaled("scaled_load.ppm", 256, 1);
+  record("desired_channels", gray_thumb && gray_thumb->channels() == 1);
+  record("missing_file", load_scaled("no_such_file.png", 64) == nullptr);
+
+  // 峰值内存：条带路径不载入整幅图像（需要 DIP_ENABLE_MEMORY_TRACKING）
+  if (memory::compiled_in()) {
+    memory::reset_peak();
+    const size_t before = memory::stats().current_bytes;
+    load_scaled("scaled_load.ppm", 256);
+    const size_t peak = memory::stats().peak_bytes - before;
+    spdlog::info("条带缩小峰值内存 {} KB（整幅 {} KB）", peak >> 10,
+                 rgb.matrix().total() >> 10);
+    record("bounded_peak", peak < rgb.matrix().total());
+  }
+
+  const double full_ms = time_ms([] {
+    auto full = ImageLoader::load_from_file("scaled_load.ppm");
+    downsample(*full, 10);
+  });
+  const double scaled_ms = time_ms([] { load_scaled("scaled_load.ppm", 256); });
+
+  for (const char *p : {"scaled_load.ppm", "scaled_load.pgm", "scaled_load.png",
+                        "scaled_load_owned.pgm"})
+    std::remove(p);
+
+  const bool ok = report_checks();
+  spdlog::info("PPM 缩略图：整幅加载+downsample {:.2f} ms，load_scaled {:.2f} ms",
+               full_ms, scaled_ms);
+  spdlog::info(ok ? "缩小加载测试完成！" : "缩小加载测试失败！");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+#include <algorithms/downsample.hpp>
+#include <algorithms/quantize.hpp>
+#include <algorithms/set_logical_ops.hpp>
+#include <algorithms/spatial_ops.hpp>
+#include <chrono>
+#include <core/core.hpp>
+#include <functional>
+#include <random>
+#include <spdlog/spdlog.h>
+
+using namespace dip;
+
+namespace {
+
+// 下采样的逐像素参考实现
+Image downsample_reference(const Image &img, int factor) {
+  int new_width = img.width() / factor;
+  int new_height = img.height() / factor;
+  Image result(new_width, new_height, img.channels());
+  for (int y = 0; y < new_height; y++) {
+    for (int x = 0; x < new_width; x++) {
+      for (int c = 0; c < img.channels(); c++) {
+        int sum = 0;
+        for (int dy = 0; dy < factor; dy++) {
+          for (int dx = 0; dx < factor; dx++) {
+            sum += img.at<uint8_t>(y * factor + dy, x * factor + dx, c);
+          }
+        }
+        result.at<uint8_t>(y, x, c) =
+            static_cast<uint8_t>(sum / (factor * factor));
+      }
+    }
+  }
+  return result;
+}
+
+bool same_bytes(const Matrix &a, const Matrix &b) {
+  return a.type() == b.type() && a.rows() == b.rows() && a.cols() == b.cols() &&
+         std::memcmp(a.ptr<uint8_t>(), b.ptr<uint8_t>(),
+                     a.total() * a.elemSize()) == 0;
+}
+
+// 在指定级别下运行并与标量级别的结果比较
+bool check(const std::string &name, CpuLevel level,
+           const std::function<Matrix()> &run) {
+  // 算法内部的日志会打断对比输出，运行期间只保留警告
+  spdlog::set_level(spdlog::level::warn);
+  set_cpu_level(CpuLevel::SCALAR);
+  auto start = std::chrono::high_resolution_clock::now();
+  Matrix expected = run();
+  auto mid = std::chrono::high_resolution_clock::now();
+
+  set_cpu_level(level);
+  Matrix actual = run();
+  auto end = std::chrono::high_resolution_clock::now();
+  spdlog::set_level(spdlog::level::info);
+
+  auto scalar_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(mid - start);
+  auto simd_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - mid);
+  bool same = same_bytes(expected, actual);
+  spdlog::info("  {:<16} scalar {:>7} us, {:<6} {:>7} us, 结果{}", name,
+               scalar_us.count(), cpu_level_name(level), simd_us.count(),
+               same ? "一致" : "不一致");
+  return same;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  spdlog::set_level(spdlog::level::info);
+
+  int width = argc > 1 ? std::atoi(argv[1]) : 1931;
+  int height = argc > 2 ? std::atoi(argv[2]) : 1087;
+
+  const CpuLevel detected = detect_cpu_level();
+  spdlog::info("=== SIMD 运行时分发测试 ===");
+  spdlog::info("CPU 支持级别: {}, 当前级别: {}", cpu_level_name(detected),
+               cpu_level_name(cpu_level()));
+
+  // 宽度取奇数，覆盖各级别内核的尾部处理
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::uniform_int_distribution<int> bit(0, 1);
+  std::uniform_real_distribution<float> value(-300.0f, 600.0f);
+
+  Image img(width, height, 3);
+  Image bin1(width, height, 1);
+  Image bin2(width, height, 1);
+  Matrix floats(height, width * 3, DataType::FLOAT32);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width * 3; ++x) {
+      img.ptr<uint8_t>(y)[x] = static_cast<uint8_t>(byte(rng));
+      floats.ptr<float>(y)[x] = value(rng);
+    }
+    for (int x = 0; x < width; ++x) {
+      bin1.ptr<uint8_t>(y)[x] = static_cast<uint8_t>(bit(rng));
+      bin2.ptr<uint8_t>(y)[x] = static_cast<uint8_t>(bit(rng));
+    }
+  }
+  Matrix halves = floats.convertTo(DataType::FLOAT16);
+
+  spdlog::set_level(spdlog::level::warn);
+  bool ok = same_bytes(algorithms::downsample(img, 3).matrix(),
+                       downsample_reference(img, 3).matrix());
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("下采样与逐像素参考实现: {}", ok ? "一致" : "不一致");
+
+  for (CpuLevel level : {CpuLevel::SSE2, CpuLevel::AVX2, CpuLevel::AVX512}) {
+    if (level > detected) {
+      spdlog::info("{}: CPU 不支持，跳过", cpu_level_name(level));
+      continue;
+    }
+    spdlog::info("{}:", cpu_level_name(level));
+    bool level_ok = true;
+    level_ok &= check("invert_image", level, [&] {
+      return invert_image(img, 255).matrix();
+    });
+    for (int levels : {2, 3, 7, 64, 256}) {
+      level_ok &= check("quantize/" + std::to_string(levels), level, [&] {
+        return algorithms::quantize(img, levels).matrix();
+      });
+    }
+    level_ok &= check("set_complement", level, [&] {
+      return set_complement(img, 300).matrix();
+    });
+    level_ok &= check("logical_and", level, [&] {
+      return logical_and(bin1, bin2).matrix();
+    });
+    level_ok &= check("logical_xor", level, [&] {
+      return logical_xor(bin1, bin2).matrix();
+    });
+    level_ok &= check("downsample", level, [&] {
+      return algorithms::downsample(img, 4).matrix();
+    });
+    level_ok &= check("u8 -> f32", level, [&] {
+      return img.matrix().convertTo(DataType::FLOAT32);
+    });
+    level_ok &= check("f32 -> u8", level,
+                      [&] { return floats.convertTo(DataType::UINT8); });
+    level_ok &= check("f32 -> f16", level,
+                      [&] { return floats.convertTo(DataType::FLOAT16); });
+    level_ok &= check("f16 -> f32", level,
+                      [&] { return halves.convertTo(DataType::FLOAT32); });
+    ok = ok && level_ok;
+  }
+
+  set_cpu_level(detected);
+  spdlog::info(ok ? "SIMD 分发测试通过！" : "SIMD 分发测试失败！");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,185 @@
+#include <algorithms/bilinear_zoom.hpp>
+#include <algorithms/downsample.hpp>
+#include <algorithms/nearest_neighbor_zoom.hpp>
+#include <algorithms/quantize.hpp>
+#include <algorithms/set_logical_ops.hpp>
+#include <algorithms/spatial_ops.hpp>
+#include <algorithms/streaming.hpp>
+#include <core/core.hpp>
+#include <cstdio>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+#include "test_helpers.hpp"
+
+using namespace dip;
+using namespace dip::test;
+using namespace dip::algorithms;
+
+namespace {
+
+// 流式输出文件与整幅计算结果一致
+bool output_matches(const std::string &path, const Image &expected) {
+  auto loaded = ImageLoader::load_pnm(path);
+  return loaded && loaded->channels() == expected.channels() &&
+         loaded->matrix() == expected.matrix();
+}
+
+} // namespace
+
+int main() {
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("=== 流式行带处理测试 ===");
+
+  const Image rgb = gradient_image(301, 467, 3, DataType::UINT8, 1);
+  const Image gray = gradient_image(517, 389, 1, DataType::UINT8, 2);
+  ImageLoader::save_as_ppm_binary(rgb, "streaming_in.ppm");
+  ImageLoader::save_as_ppm_binary(gray, "streaming_in.pgm");
+  spdlog::set_level(spdlog::level::warn);
+
+  // 行带与 halo：核心行覆盖整幅图像，halo 在边界处被裁剪
+  StripReader reader;
+  bool bands_ok = reader.open("streaming_in.pgm", 50, 2);
+  Band band;
+  int covered = 0;
+  while (bands_ok && reader.next(band)) {
+    bands_ok = band.y == covered &&
+               band.halo_top == std::min(2, band.y) &&
+               band.halo_bottom ==
+                   std::min(2, gray.height() - band.y - band.rows) &&
+               band.image.height() ==
+                   band.halo_top + band.rows + band.halo_bottom;
+    for (int r = 0; r < band.image.height() && bands_ok; ++r) {
+      bands_ok = std::equal(band.image.ptr<uint8_t>(r),
+                            band.image.ptr<uint8_t>(r) + gray.width(),
+                            gray.ptr<uint8_t>(band.image_y() + r));
+    }
+    covered += band.rows;
+  }
+  record("bands_with_halo", bands_ok && covered == gray.height());
+
+  // 行带逐个写回得到原图
+  StripWriter writer;
+  reader.rewind();
+  bool copy_ok = writer.open("streaming_out.pgm", gray.width(), gray.height(),
+                             1);
+  while (copy_ok && reader.next(band))
+    writer.write(band);
+  copy_ok = copy_ok && writer.close() &&
+            output_matches("streaming_out.pgm", gray);
+  record("writer_roundtrip", copy_ok);
+
+  // 行数不足时 close() 报错
+  StripWriter partial;
+  partial.open("streaming_out.pgm", gray.width(), gray.height(), 1);
+  partial.write(gray, 0, 10);
+  record("writer_incomplete", !partial.close());
+
+  // 起始行超出 rows 时抛出异常，不写出任何数据
+  StripWriter beyond;
+  beyond.open("streaming_out.pgm", gray.width(), gray.height(), 1);
+  bool beyond_rejected = false;
+  try {
+    beyond.write(gray, gray.height() + 5);
+  } catch (const std::invalid_argument &) {
+    beyond_rejected = beyond.rows_written() == 0;
+  }
+  beyond.close();
+  record("writer_rejects_y0", beyond_rejected);
+
+  // ROI 图像（行跨度大于行宽）
+  const Image roi = gray.roi(Rect(5, 3, 200, 100));
+  StripWriter roi_writer;
+  roi_writer.open("streaming_out.pgm", roi.width(), roi.height(), 1);
+  roi_writer.write(roi);
+  bool roi_ok = roi_writer.close();
+  auto roi_loaded = ImageLoader::load_pnm("streaming_out.pgm");
+  roi_ok = roi_ok && roi_loaded;
+  for (int y = 0; y < roi.height() && roi_ok; ++y)
+    roi_ok = std::equal(roi.ptr<uint8_t>(y), roi.ptr<uint8_t>(y) + roi.width(),
+                        roi_loaded->ptr<uint8_t>(y));
+  record("writer_roi", roi_ok);
+
+  // 16位输出
+  Image wide(40, 30, 3, DataType::UINT16);
+  for (int y = 0; y < 30; ++y) {
+    for (int x = 0; x < 120; ++x)
+      wide.ptr<uint16_t>(y)[x] = static_cast<uint16_t>(x * 517 + y * 31);
+  }
+  StripWriter wide_writer;
+  wide_writer.open("streaming_out.ppm", 40, 30, 3, DataType::UINT16);
+  wide_writer.write(wide, 0, 17);
+  wide_writer.write(wide, 17);
+  record("writer_16bit", wide_writer.close() &&
+                             output_matches("streaming_out.ppm", wide));
+
+  // 算法适配器：不同行带大小下都与整幅计算一致
+  bool quantize_ok = true, invert_ok = true, complement_ok = true;
+  bool downsample_ok = true, bilinear_ok = true, nearest_ok = true;
+  for (int band_rows : {1, 7, 64, 1000}) {
+    for (const auto &input : {std::make_pair("streaming_in.ppm", &rgb),
+                              std::make_pair("streaming_in.pgm", &gray)}) {
+      const Image &img = *input.second;
+      stream_quantize(input.first, "streaming_out.pnm", 6, band_rows);
+      quantize_ok &= output_matches("streaming_out.pnm", quantize(img, 6));
+      stream_invert_image(input.first, "streaming_out.pnm", 200, band_rows);
+      invert_ok &= output_matches("streaming_out.pnm", invert_image(img, 200));
+      stream_set_complement(input.first, "streaming_out.pnm", 255, band_rows);
+      complement_ok &=
+          output_matches("streaming_out.pnm", set_complement(img, 255));
+      for (int factor : {2, 3, 8}) {
+        stream_downsample(input.first, "streaming_out.pnm", factor,
+                          band_rows);
+        downsample_ok &=
+            output_matches("streaming_out.pnm", downsample(img, factor));
+      }
+      for (float scale : {0.37f, 1.0f, 1.5f, 2.3f}) {
+        stream_bilinear_zoom(input.first, "streaming_out.pnm", scale,
+                             band_rows);
+        bilinear_ok &=
+            output_matches("streaming_out.pnm", bilinear_zoom(img, scale));
+        stream_nearest_neighbor_zoom(input.first, "streaming_out.pnm", scale,
+                                     band_rows);
+        nearest_ok &= output_matches("streaming_out.pnm",
+                                     nearest_neighbor_zoom(img, scale));
+      }
+    }
+  }
+  record("stream_quantize", quantize_ok);
+  record("stream_invert_image", invert_ok);
+  record("stream_set_complement", complement_ok);
+  record("stream_downsample", downsample_ok);
+  record("stream_bilinear_zoom", bilinear_ok);
+  record("stream_nearest_zoom", nearest_ok);
+
+  // 输入不是PNM时抛出异常
+  bool rejected = false;
+  try {
+    stream_quantize("no_such_file.pgm", "streaming_out.pnm", 4);
+  } catch (const std::runtime_error &) {
+    rejected = true;
+  }
+  record("missing_input", rejected);
+
+  // 峰值内存只与行带大小有关（需要 DIP_ENABLE_MEMORY_TRACKING）
+  if (memory::compiled_in()) {
+    memory::reset_peak();
+    const size_t before = memory::stats().current_bytes;
+    stream_bilinear_zoom("streaming_in.ppm", "streaming_out.pnm", 1.5f, 16);
+    const size_t peak = memory::stats().peak_bytes - before;
+    spdlog::set_level(spdlog::level::info);
+    spdlog::info("行带16行的峰值内存 {} KB（整幅输出 {} KB）", peak >> 10,
+                 bilinear_zoom(rgb, 1.5f).matrix().total() >> 10);
+    record("bounded_peak", peak < rgb.matrix().total() / 4);
+  }
+  spdlog::set_level(spdlog::level::info);
+
+  for (const char *p : {"streaming_in.ppm", "streaming_in.pgm",
+                        "streaming_out.pgm", "streaming_out.ppm",
+                        "streaming_out.pnm"})
+    std::remove(p);
+
+  const bool ok = report_checks();
+  spdlog::info(ok ? "流式行带处理测试完成！" : "流式行带处理测试失败！");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+#include <algorithms/bilinear_zoom.hpp>
+#include <algorithms/quantize.hpp>
+#include <atomic>
+#include <chrono>
+#include <core/core.hpp>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+using namespace dip;
+
+namespace {
+
+// 单张图像的流水线：读取 -> 旋转90度 -> 放大 -> 量化 -> 保存
+struct PipelineJob {
+  std::string input;
+  std::string output;
+  std::shared_ptr<Image> image;
+  Image result;
+};
+
+Image process(const Image &img) {
+  Image rotated = image_ops::rotate90(img);
+  Image zoomed = algorithms::bilinear_zoom(rotated, 1.5f);
+  return algorithms::quantize(zoomed, 8);
+}
+
+// 每个阶段作为独立任务提交，不同图像的各阶段可并发执行
+TaskHandle submit_pipeline(TaskScheduler &scheduler, PipelineJob &job) {
+  auto load = scheduler.spawn([&job] {
+    job.image = ImageLoader::load_from_file(job.input);
+    if (!job.image)
+      throw std::runtime_error("failed to load " + job.input);
+  });
+  auto rotate = scheduler.then(
+      load, [&job] { *job.image = image_ops::rotate90(*job.image); });
+  auto zoom = scheduler.then(rotate, [&job] {
+    *job.image = algorithms::bilinear_zoom(*job.image, 1.5f);
+  });
+  auto quantize = scheduler.then(zoom, [&job] {
+    job.result = algorithms::quantize(*job.image, 8);
+    job.image.reset();
+  });
+  auto save = scheduler.then(quantize, [&job] {
+    if (!job.output.empty())
+      image_saver::save_binary(job.result, job.output);
+  });
+  return save;
+}
+
+bool test_dependencies(TaskScheduler &scheduler) {
+  // 菱形依赖：a -> (b, c) -> d
+  std::atomic<int> step{0};
+  int a_seen = -1, b_seen = -1, c_seen = -1, d_seen = -1;
+  auto a = scheduler.spawn([&] { a_seen = step++; });
+  auto b = scheduler.then(a, [&] { b_seen = step++; });
+  auto c = scheduler.then(a, [&] { c_seen = step++; });
+  auto d = scheduler.spawn([&] { d_seen = step++; }, {b, c});
+  scheduler.wait(d);
+
+  bool ok = a_seen == 0 && b_seen > a_seen && c_seen > a_seen &&
+            d_seen > b_seen && d_seen > c_seen;
+  spdlog::info("菱形依赖顺序: a={} b={} c={} d={} {}", a_seen, b_seen, c_seen,
+               d_seen, ok ? "正确" : "错误");
+  return ok;
+}
+
+bool test_exception(TaskScheduler &scheduler) {
+  // 前驱抛出异常后，后继不执行，wait 重新抛出原异常
+  std::atomic<bool> ran{false};
+  auto fail = scheduler.spawn([] { throw std::runtime_error("stage failed"); });
+  auto next = scheduler.then(fail, [&] { ran = true; });
+  try {
+    scheduler.wait(next);
+  } catch (const std::runtime_error &e) {
+    bool ok = !ran && std::string(e.what()) == "stage failed";
+    spdlog::info("异常传递: {} ({})", ok ? "正确" : "错误", e.what());
+    return ok;
+  }
+  spdlog::info("异常传递: 错误（未抛出异常）");
+  return false;
+}
+
+bool test_nested(TaskScheduler &scheduler) {
+  // 任务内部再提交子任务并等待（等待期间工作线程执行其他任务）
+  const int parents = 64, children = 64;
+  std::atomic<int> count{0};
+  std::vector<TaskHandle> handles;
+  for (int i = 0; i < parents; ++i) {
+    handles.push_back(scheduler.spawn([&] {
+      std::vector<TaskHandle> subtasks;
+      for (int j = 0; j < children; ++j) {
+        subtasks.push_back(scheduler.spawn([&] { ++count; }));
+      }
+      for (auto &t : subtasks) {
+        scheduler.wait(t);
+      }
+    }));
+  }
+  scheduler.wait_all();
+
+  bool ok = count.load() == parents * children;
+  spdlog::info("嵌套任务: 完成 {} / {} {}", count.load(), parents * children,
+               ok ? "正确" : "错误");
+  return ok;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  spdlog::set_level(spdlog::level::info);
+
+  std::string filename = argc > 1 ? argv[1] : "test.png";
+  int num_images = argc > 2 ? std::atoi(argv[2]) : 8;
+  int threads = argc > 3 ? std::atoi(argv[3]) : 8;
+
+  TaskScheduler scheduler(threads);
+  spdlog::info("=== 工作窃取任务调度器测试（{} 个工作线程）===",
+               scheduler.size());
+
+  bool ok = test_dependencies(scheduler);
+  ok = test_exception(scheduler) && ok;
+  ok = test_nested(scheduler) && ok;
+
+  auto reference_img = ImageLoader::load_from_file(filename);
+  if (!reference_img || reference_img->empty()) {
+    spdlog::error("Failed to load image: {}", filename);
+    return 1;
+  }
+
+  // 算法内部的逐次日志会淹没流水线输出，计时期间只保留警告
+  spdlog::set_level(spdlog::level::warn);
+
+  // 参考：逐张依次执行所有阶段（各算法内部仍按行并行）
+  auto start = std::chrono::high_resolution_clock::now();
+  std::vector<Image> expected;
+  for (int i = 0; i < num_images; ++i) {
+    auto img = ImageLoader::load_from_file(filename);
+    expected.push_back(process(*img));
+  }
+  auto mid = std::chrono::high_resolution_clock::now();
+
+  // 任务图：所有图像的阶段同时提交，由调度器并发执行
+  std::vector<PipelineJob> jobs(num_images);
+  std::vector<TaskHandle> done;
+  for (int i = 0; i < num_images; ++i) {
+    jobs[i].input = filename;
+    // 只保存前两张结果，避免示例产生大量文件
+    if (i < 2)
+      jobs[i].output = "pipeline_" + std::to_string(i) + ".ppm";
+    done.push_back(submit_pipeline(scheduler, jobs[i]));
+  }
+  for (auto &h : done) {
+    scheduler.wait(h);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  spdlog::set_level(spdlog::level::info);
+
+  bool same = true;
+  for (int i = 0; i < num_images; ++i) {
+    same = same && jobs[i].result == expected[i];
+  }
+  ok = ok && same;
+
+  auto serial_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(mid - start);
+  auto scheduled_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(end - mid);
+  spdlog::info("{} 张图像流水线: 逐张 {} ms, 任务图 {} ms, 结果{}", num_images,
+               serial_ms.count(), scheduled_ms.count(),
+               same ? "一致" : "不一致");
+
+  spdlog::info(ok ? "任务调度器测试通过！" : "任务调度器测试失败！");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <core/core.hpp>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <spdlog/spdlog.h>
+
+#include "test_helpers.hpp"
+
+using namespace dip;
+using namespace dip::test;
+
+namespace {
+
+// 随机ROI与整幅图像的 pixel_roi 一致
+bool random_rois_match(const TiledImage &tiled, const Image &full,
+                       uint32_t seed) {
+  std::mt19937 rng(seed);
+  for (int i = 0; i < 50; ++i) {
+    const int x = rng() % full.width();
+    const int y = rng() % full.height();
+    const int w = 1 + rng() % (full.width() - x);
+    const int h = 1 + rng() % (full.height() - y);
+    const Rect region(x, y, w, h);
+    if (!same_pixels(tiled.roi(region), full.pixel_roi(region)))
+      return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int main() {
+  spdlog::set_level(spdlog::level::info);
+  spdlog::info("=== 分块大图像测试 ===");
+
+  const Image gray = gradient_image(1000, 700, 1, DataType::UINT8, 1);
+  const Image rgb = gradient_image(613, 457, 3, DataType::UINT8, 2);
+  const Image deep = gradient_image(389, 271, 3, DataType::UINT16, 3);
+
+  // 由图像生成分块文件，边缘分块不完整
+  TiledImage tiled;
+  bool built = TiledImage::build(gray, "tiled_gray.tiles", 128) &&
+               tiled.open("tiled_gray.tiles");
+  record("build_open", built && tiled.width() == 1000 &&
+                           tiled.height() == 700 && tiled.tiles_x() == 8 &&
+                           tiled.tiles_y() == 6);
+  record("gray_roi", built && random_rois_match(tiled, gray, 10));
+  record("full_roi", built && same_pixels(tiled.roi(Rect(0, 0, 1000, 700)),
+                                          gray));
+
+  bool pixels_ok = built;
+  for (int y = 0; pixels_ok && y < gray.height(); y += 37) {
+    for (int x = 0; pixels_ok && x < gray.width(); x += 41)
+      pixels_ok = tiled.at<uint8_t>(y, x) == gray.at<uint8_t>(y, x);
+  }
+  record("pixel_access", pixels_ok);
+
+  // 越界ROI与 Image::pixel_roi 一样抛出 std::invalid_argument
+  bool rejected = false;
+  try {
+    tiled.roi(Rect(900, 600, 101, 10));
+  } catch (const std::invalid_argument &) {
+    rejected = true;
+  }
+  record("roi_bounds", rejected);
+
+  // 多通道、16位，以及由PNM流式生成
+  TiledImage tiled_rgb, tiled_pnm, tiled_deep;
+  ImageLoader::save_as_ppm_binary(rgb, "tiled_in.ppm");
+  record("rgb_roi", TiledImage::build(rgb, "tiled_rgb.tiles", 100) &&
+                        tiled_rgb.open("tiled_rgb.tiles") &&
+                        random_rois_match(tiled_rgb, rgb, 11));
+  record("from_pnm",
+         TiledImage::build_from_pnm("tiled_in.ppm", "tiled_pnm.tiles", 64) &&
+             tiled_pnm.open("tiled_pnm.tiles") &&
+             random_rois_match(tiled_pnm, rgb, 12));
+  record("uint16_roi", TiledImage::build(deep, "tiled_deep.tiles", 50) &&
+                           tiled_deep.open("tiled_deep.tiles") &&
+                           tiled_deep.type() == DataType::UINT16 &&
+                           random_rois_match(tiled_deep, deep, 13));
+
+  // 只读取与ROI相交的分块，重复访问命中缓存
+  const size_t tile_bytes = 128 * 128;
+  tiled.open("tiled_gray.tiles", 4 * tile_bytes);
+  tiled.roi(Rect(10, 10, 100, 100));
+  const TileCacheStats one = tiled.cache_stats();
+  tiled.roi(Rect(120, 10, 20, 20)); // 跨两个分块
+  tiled.roi(Rect(120, 10, 20, 20));
+  const TileCacheStats two = tiled.cache_stats();
+  record("touch_needed", one.misses == 1 && one.hits == 0 &&
+                             two.misses == 2 && two.hits == 3);
+
+  // 缓存不超过字节上限，超出时淘汰最久未使用的分块
+  tiled.roi(Rect(0, 0, 1000, 700));
+  const TileCacheStats full = tiled.cache_stats();
+  tiled.roi(Rect(900, 600, 100, 100)); // 最近使用的分块仍在缓存中
+  const TileCacheStats after = tiled.cache_stats();
+  record("cache_budget", full.peak_bytes <= 4 * tile_bytes + tile_bytes &&
+                             full.bytes <= 4 * tile_bytes &&
+                             full.evictions > 0 &&
+                             after.hits == full.hits + 1);
+  tiled.set_cache_budget(tile_bytes);
+  record("shrink_budget", tiled.cache_stats().bytes <= tile_bytes);
+
+  // 多线程并发读取
+  tiled.set_cache_budget(8 * tile_bytes);
+  std::vector<char> matches(64, 0);
+  parallel_for(
+      0, static_cast<int>(matches.size()),
+      [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+          const Rect region((i * 97) % 800, (i * 53) % 500, 200, 200);
+          matches[i] = same_pixels(tiled.roi(region), gray.pixel_roi(region));
+        }
+      },
+      1);
+  record("concurrent", std::all_of(matches.begin(), matches.end(),
+                                   [](char m) { return m != 0; }));
+
+  // 不是分块文件或文件被截断时打开失败
+  TiledImage bad;
+  record("reject_invalid", !bad.open("tiled_in.ppm") && !bad.error().empty());
+
+  // 头部字段的乘积溢出（分块大小 2^63 字节，共 2 块）时不能通过截断检查
+  {
+    char header[64] = {'D', 'I', 'P', 'T', 'I', 'L', 'E', '1'};
+    const uint32_t fields[6] = {1u << 17, 1u << 30, 1u << 14,
+                                static_cast<uint32_t>(DataType::FLOAT64),
+                                1u << 16, 1u << 30};
+    std::memcpy(header + 8, fields, sizeof(fields));
+    std::FILE *f = std::fopen("tiled_overflow.tiles", "wb");
+    const bool written = f && std::fwrite(header, 1, sizeof(header), f) ==
+                                  sizeof(header);
+    if (f)
+      std::fclose(f);
+    record("reject_overflow", written &&
+                                  !bad.open("tiled_overflow.tiles") &&
+                                  !bad.error().empty());
+  }
+
+  tiled.close();
+  tiled_rgb.close();
+  tiled_pnm.close();
+  tiled_deep.close();
+  for (const char *p : {"tiled_gray.tiles", "tiled_rgb.tiles",
+                        "tiled_pnm.tiles", "tiled_deep.tiles", "tiled_in.ppm",
+                        "tiled_overflow.tiles"})
+    std::remove(p);
+
+  const bool ok = report_checks();
+  spdlog::info(ok ? "分块大图像测试完成！" : "分块大图像测试失败！");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,67 @@
+#include <algorithms/bilinear_zoom.hpp>
+#include <algorithms/quantize.hpp>
+#include <algorithms/rotate.hpp>
+#include <cmath>
+#include <core/core.hpp>
+#include <spdlog/spdlog.h>
+
+using namespace dip;
+
+int main(int argc, char *argv[]) {
+  spdlog::set_level(spdlog::level::info);
+
+  std::string filename = argc > 1 ? argv[1] : "test.png";
+  std::string output = argc > 2 ? argv[2] : "trace.json";
+
+  spdlog::info("=== 作用域追踪测试 ===");
+  spdlog::info("追踪: {}", trace::compiled_in() ? "已编译" : "未编译");
+
+  trace::set_thread_name("main");
+  trace::clear();
+
+  auto img = ImageLoader::load_from_file(filename);
+  if (!img || img->empty()) {
+    spdlog::error("Failed to load image: {}", filename);
+    return 1;
+  }
+
+  spdlog::set_level(spdlog::level::warn);
+  Image rotated = algorithms::rotate(*img, M_PI / 6);
+  Image zoomed = algorithms::bilinear_zoom(rotated, 1.5f);
+  Image quantized = algorithms::quantize(zoomed, 8);
+
+  // 暂停期间不记录事件
+  trace::set_enabled(false);
+  const size_t paused_before = trace::event_count();
+  algorithms::quantize(zoomed, 4);
+  const size_t paused_after = trace::event_count();
+  trace::set_enabled(true);
+  spdlog::set_level(spdlog::level::info);
+
+  const size_t events = trace::event_count();
+  spdlog::info("记录事件数: {}", events);
+
+  bool ok = !quantized.empty() && paused_before == paused_after;
+  if (trace::compiled_in()) {
+    // 至少包含加载和三个算法调用
+    ok = ok && events >= 4;
+    const std::string json = trace::chrome_trace_json();
+    ok = ok && json.find("\"name\":\"rotate\"") != std::string::npos &&
+         json.find("\"name\":\"ImageLoader::load_from_file\"") !=
+             std::string::npos;
+    if (trace::write_chrome_trace(output)) {
+      spdlog::info("已导出 {}（可在 chrome://tracing 或 Perfetto 中打开）",
+                   output);
+    } else {
+      spdlog::error("无法写入 {}", output);
+      ok = false;
+    }
+  } else {
+    // 未开启时所有接口为空实现
+    ok = ok && events == 0 && trace::chrome_trace_json().empty();
+    spdlog::info("使用 -DDIP_ENABLE_TRACING=ON 重新配置以启用追踪");
+  }
+
+  spdlog::info(ok ? "作用域追踪测试完成！" : "作用域追踪测试失败！");
+  return ok ? 0 : 1;
+}